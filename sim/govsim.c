@@ -0,0 +1,786 @@
+/*
+ * govsim.c  –  replay recorded governor inputs against the governor sources
+ *
+ * Built on a host (CMakeLists.txt in this directory) from the firmware's
+ * own governors*.c, gov_tunable.c, freq_policy.c, pll_table.c, energy.c
+ * and freq_stats.c, with sim_hal.c standing in for the hardware.  The loop
+ * in run() mirrors core1_entry(): records due by the tick are folded into
+ * the tick's metrics aggregate, the thermal cap is applied, target_khz is
+ * clamped to the policy range and the governor ticks.  The next tick is
+ * one sampling period later, sooner on governor_request_tick() or on a
+ * record that would ring the wake doorbell, later in tickless mode.  Time
+ * is simulated, so a minute of trace replays in milliseconds.
+ *
+ * Input is a `trace dump` capture (trace.h) or a --synth burst pattern,
+ * optionally with periodic --rt tasks run under EDF on the simulated
+ * Core 0 through the rt_task.h API (so any governor can be checked for
+ * deadline misses).
+ * Output is a summary (time-to-target, burst response, modeled energy,
+ * time in state), optionally a per-tick timeline CSV, and with --sweep one
+ * CSV row per value of a tunable.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "pico/stdlib.h"
+#include "sim.h"
+#include "system.h"
+#include "governors.h"
+#include "gov_tunable.h"
+#include "freq_policy.h"
+#include "freq_stats.h"
+#include "energy.h"
+#include "pio_idle.h"
+#include "metrics.h"
+#include "trace.h"
+#include "rt_task.h"
+
+/* core1_entry() thermal handling (system.c) */
+#define THERMAL_BACKOFF_C   70.0f
+#define THERMAL_RESTORE_C   65.0f
+#define THERMAL_CAP_KHZ     200000u
+
+#define MAX_PARAMS          16
+
+typedef struct {
+    trace_rec_t *rec;
+    size_t       n;
+} trace_t;
+
+typedef struct {
+    uint32_t period_ms;
+    uint32_t wcet_cycles;
+    uint32_t used_pct;           /* of wcet_cycles, every job */
+} rt_spec_t;
+
+typedef struct {
+    const char *gov;
+    const char *param_name[MAX_PARAMS];
+    double      param_val[MAX_PARAMS];
+    int         nparams;
+    const char *sweep_name;
+    double      sweep_lo, sweep_hi, sweep_step;
+    const char *timeline;
+    bool        tickless;
+    uint32_t    wake_pct;
+    uint32_t    burst_pct;
+    uint32_t    burst_khz;       /* 0 = scaling_max at the onset */
+    uint32_t    start_khz;
+    float       temp_c;          /* < -100: from the trace */
+    bool        scale_intensity; /* intensity is a busy share at rec khz */
+    rt_spec_t   rt[RT_SCHED_MAX_TASKS];
+    int         nrt;
+} opts_t;
+
+typedef struct {
+    uint64_t   span_us;
+    uint32_t   ticks;
+    uint32_t   retargets;        /* ticks that moved target_khz */
+    uint32_t   wakeups;          /* ticks started by a doorbell record */
+    uint32_t   tickless_sleeps;
+    uint32_t   throttles;
+    uint32_t   bursts;
+    uint32_t   burst_ready;      /* clock already at burst_khz at the onset */
+    uint32_t   burst_reached;
+    uint32_t   burst_missed;     /* burst over before the clock got there */
+    uint64_t   burst_total_us;
+    uint32_t   burst_max_us;
+    uint64_t   energy_uj;
+    uint32_t   rt_jobs;
+    uint32_t   rt_late;          /* finished after, or abandoned at, the deadline */
+    uint32_t   rt_flagged;       /* misses rt_task counted */
+    uint32_t   rt_reclaims;
+    uint32_t   khz_start;        /* clk_sys before the first tick */
+    uint32_t   khz_min;          /* extremes after each tick, for overshoot */
+    uint32_t   khz_max;
+    uint32_t   khz_end;
+    uint64_t   settle_us;        /* last tick that moved clk_sys */
+    sim_ramp_t ramp;
+    freq_stats_t fs;
+} result_t;
+
+/* --------------------------------------------------------------------------
+ * Traces
+ * -------------------------------------------------------------------------- */
+
+static int trace_push(trace_t *t, const trace_rec_t *r, size_t *cap)
+{
+    if (t->n == *cap) {
+        size_t nc = *cap ? *cap * 2u : 1024u;
+        trace_rec_t *p = realloc(t->rec, nc * sizeof(*p));
+        if (!p) return -1;
+        t->rec = p;
+        *cap = nc;
+    }
+    t->rec[t->n++] = *r;
+    return 0;
+}
+
+/* A `trace dump` capture; lines that are not records (the magic, the
+ * header, shell prompts around the dump) are skipped. */
+static int trace_load_csv(const char *path, trace_t *t)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) { perror(path); return -1; }
+
+    char line[256];
+    size_t cap = 0, lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        unsigned long ts, count, workload, intensity, duration, idle, khz, iowait = 0;
+        int temp;
+        int nf = sscanf(line, "%lu,%lu,%lu,%lu,%lu,%lu,%d,%lu,%lu", &ts, &count, &workload,
+                        &intensity, &duration, &idle, &temp, &khz, &iowait);
+        if (nf != TRACE_CSV_FIELDS && nf != TRACE_CSV_FIELDS_V1)
+            continue;
+        if (t->n && ts < t->rec[t->n - 1].ts_ms) {
+            fprintf(stderr, "%s:%zu: timestamps go backwards (two dumps in one file?)\n",
+                    path, lineno);
+            fclose(f);
+            return -1;
+        }
+        trace_rec_t r = {
+            .ts_ms       = (uint32_t)ts,
+            .workload    = (uint32_t)workload,
+            .khz         = (uint32_t)khz,
+            .count       = (uint16_t)(count > UINT16_MAX ? UINT16_MAX : count),
+            .duration_ms = (uint16_t)(duration > UINT16_MAX ? UINT16_MAX : duration),
+            .intensity   = (uint8_t)(intensity > 100 ? 100 : intensity),
+            .idle_pct    = (uint8_t)(idle > 100 ? 100 : idle),
+            .temp_c      = (int8_t)temp,
+            .iowait      = (uint8_t)(iowait > UINT8_MAX ? UINT8_MAX : iowait),
+        };
+        if (trace_push(t, &r, &cap) != 0) { fclose(f); return -1; }
+    }
+    fclose(f);
+    if (t->n == 0) {
+        fprintf(stderr, "%s: no trace records (expected " TRACE_CSV_HEADER ")\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+/* Bursts of `intensity` for burst_ms every period_ms, sampled every 10 ms
+ * while busy and every TRACE_ENV_PERIOD_MS while idle, as the recorder
+ * would see them.  Busy time is taken at MIN_KHZ.  With iowait set, each
+ * burst starts with an I/O-wait flag (work released by a blocking read). */
+static int trace_synth(const char *spec, trace_t *t)
+{
+    unsigned period, burst, intensity, total, iowait = 0;
+    int nf = sscanf(spec, "%u,%u,%u,%u,%u", &period, &burst, &intensity, &total, &iowait);
+    if (nf < 4 || period == 0 || burst > period || intensity > 100 || total == 0) {
+        fprintf(stderr, "--synth wants <period_ms>,<burst_ms>,<intensity>,<total_ms>[,<iowait>]\n");
+        return -1;
+    }
+    size_t cap = 0;
+    uint32_t last = 0;
+    for (uint32_t ms = 0; ms < total; ms += 10u) {
+        bool busy  = (ms % period) < burst;
+        bool onset = busy && (ms % period) < 10u;
+        if (!busy && ms && ms - last < TRACE_ENV_PERIOD_MS) continue;
+        trace_rec_t r = {
+            .ts_ms       = ms,
+            .workload    = busy ? 1000u : 0u,
+            .khz         = MIN_KHZ,
+            .count       = busy ? 1u : 0u,
+            .duration_ms = busy ? 10u : 0u,
+            .intensity   = (uint8_t)(busy ? intensity : 0u),
+            .idle_pct    = (uint8_t)(busy ? 100u - intensity : 95u),
+            .temp_c      = 40,
+            .iowait      = (uint8_t)(iowait && onset ? 1u : 0u),
+        };
+        if (trace_push(t, &r, &cap) != 0) return -1;
+        last = ms;
+    }
+    return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Replay
+ * -------------------------------------------------------------------------- */
+
+/* Intensity the governor sees for r.  With --scale-intensity it is a busy
+ * share measured at the recorded clock, so the same work occupies
+ * rec_khz / current_khz of it now (as the PIO idle fraction does). */
+static uint32_t rec_intensity(const opts_t *o, const trace_rec_t *r)
+{
+    if (!o->scale_intensity || !r->khz || !current_khz) return r->intensity;
+    uint32_t v = (uint32_t)((uint64_t)r->intensity * r->khz / current_khz);
+    return v > 100u ? 100u : v;
+}
+
+/* --------------------------------------------------------------------------
+ * Periodic tasks (--rt)
+ * -------------------------------------------------------------------------- */
+
+typedef struct {
+    int      handle;
+    uint32_t used;               /* cycles each job takes */
+    uint64_t period_us;
+    uint64_t next_release_us;
+    uint64_t deadline_us;
+    uint32_t left;               /* cycles left in the open job, 0 = none */
+} rt_job_t;
+
+typedef struct {
+    rt_job_t job[RT_SCHED_MAX_TASKS];
+    int      n;
+    uint64_t t;                  /* model time, <= sim_now_us */
+} rt_sim_t;
+
+static void rt_sim_start(rt_sim_t *rs, const opts_t *o, uint64_t t0)
+{
+    memset(rs, 0, sizeof(*rs));
+    rs->t = t0;
+    for (int k = 0; k < o->nrt; ++k) {
+        rt_job_t *j = &rs->job[rs->n];
+        j->handle = rt_task_register(o->rt[k].period_ms, o->rt[k].wcet_cycles);
+        if (j->handle < 0) continue;
+        j->used = (uint32_t)((uint64_t)o->rt[k].wcet_cycles * o->rt[k].used_pct / 100u);
+        if (!j->used) j->used = 1;
+        j->period_us = (uint64_t)o->rt[k].period_ms * 1000u;
+        j->next_release_us = t0;
+        rs->n++;
+    }
+}
+
+static void rt_sim_stop(rt_sim_t *rs)
+{
+    for (int k = 0; k < rs->n; ++k)
+        rt_task_unregister(rs->job[k].handle);
+    rs->n = 0;
+}
+
+/* Run the jobs under EDF from rs->t to until with the clock at khz,
+ * releasing and completing through rt_task.  With stop_at_release, return
+ * right after a release (it rings Core 1).  Returns the cycles executed. */
+static uint64_t rt_sim_advance(rt_sim_t *rs, uint64_t until, uint32_t khz,
+                               bool stop_at_release, result_t *res)
+{
+    uint64_t cycles = 0;
+    while (rs->t < until) {
+        bool released = false;
+        uint64_t next_rel = UINT64_MAX;
+        for (int k = 0; k < rs->n; ++k) {
+            rt_job_t *j = &rs->job[k];
+            if (j->next_release_us <= rs->t) {
+                if (j->left) res->rt_late++;    /* abandoned at its deadline */
+                sim_now_us = rs->t;
+                rt_task_release(j->handle);
+                j->left = j->used;
+                j->deadline_us = j->next_release_us + j->period_us;
+                j->next_release_us += j->period_us;
+                res->rt_jobs++;
+                released = true;
+            }
+            if (j->next_release_us < next_rel) next_rel = j->next_release_us;
+        }
+        if (released && stop_at_release) break;
+
+        rt_job_t *run = NULL;
+        for (int k = 0; k < rs->n; ++k) {
+            rt_job_t *j = &rs->job[k];
+            if (j->left && (!run || j->deadline_us < run->deadline_us)) run = j;
+        }
+        uint64_t end = next_rel < until ? next_rel : until;
+        if (!run || !khz) {
+            rs->t = end;
+            continue;
+        }
+
+        uint64_t fin = rs->t + ((uint64_t)run->left * 1000u + khz - 1u) / khz;
+        if (fin <= end) {
+            cycles += run->left;
+            run->left = 0;
+            rs->t = sim_now_us = fin;
+            rt_task_complete(run->handle, run->used);
+            if (fin > run->deadline_us) res->rt_late++;
+        } else {
+            uint64_t c = (end - rs->t) * khz / 1000u;
+            if (c >= run->left) c = run->left - 1u;
+            run->left -= (uint32_t)c;
+            cycles += c;
+            rs->t = end;
+        }
+    }
+    return cycles;
+}
+
+static void run(const Governor *g, const trace_t *t, const opts_t *o,
+                FILE *timeline, result_t *res)
+{
+    memset(res, 0, sizeof(*res));
+    sim_hal_reset(o->start_khz);
+    freq_policy_clear(FREQ_POLICY_THERMAL);
+    governors_set_tickless(o->tickless);
+    governors_set_current(g);
+    governor_take_tick_request();       /* drop one left by a previous run */
+
+    const uint64_t t0  = sim_now_us;
+    const uint64_t end = t0 + ((uint64_t)t->rec[t->n - 1].ts_ms + 1u) * 1000u;
+    size_t i = 0;
+    bool thermal = false;
+    bool in_burst = false, pending = false;
+    uint64_t onset_us = 0;
+    uint32_t ready_khz = 0;
+    rt_sim_t rs;
+    rt_task_stats_t rt0;
+    rt_task_get_stats(&rt0);
+    rt_sim_start(&rs, o, t0);
+    res->khz_start = res->khz_min = res->khz_max = current_khz;
+
+    while (sim_now_us < end) {
+        /* Fold records due by now into this tick's aggregate. */
+        metrics_agg_t agg;
+        memset(&agg, 0, sizeof(agg));
+        double wl = 0.0, in = 0.0, du = 0.0;
+        for (; i < t->n && t0 + (uint64_t)t->rec[i].ts_ms * 1000u <= sim_now_us; ++i) {
+            const trace_rec_t *r = &t->rec[i];
+            uint64_t ts = t0 + (uint64_t)r->ts_ms * 1000u;
+            uint32_t rec_khz = r->khz ? r->khz : current_khz;
+            sim_env.busy_khz = (100.0f - r->idle_pct) / 100.0f * (float)rec_khz;
+            sim_env.temp_c   = o->temp_c > -100.0f ? o->temp_c : (float)r->temp_c;
+
+            /* The clock has not moved since the record was due (no tick in
+               between), so readiness at the onset can be judged now. */
+            bool hi = r->count && r->intensity >= o->burst_pct;
+            if (hi && !in_burst) {
+                res->bursts++;
+                ready_khz = o->burst_khz ? o->burst_khz : freq_policy_max_khz();
+                if (current_khz >= ready_khz) {
+                    res->burst_ready++;
+                    pending = false;
+                } else {
+                    pending  = true;
+                    onset_us = ts;
+                }
+            } else if (!hi && in_burst && pending) {
+                res->burst_missed++;
+                pending = false;
+            }
+            in_burst = hi;
+
+            agg.iowait += r->iowait;
+            if (!r->count) continue;
+            trace_rec_t seen = *r;
+            seen.intensity = (uint8_t)rec_intensity(o, r);
+            agg.count += r->count;
+            wl += (double)r->workload * r->count;
+            in += (double)seen.intensity * r->count;
+            du += (double)r->duration_ms * r->count;
+            agg.last_ts_ms = to_ms_since_boot(ts);
+            sim_metrics_push(ts, &seen);
+        }
+        if (agg.count) {
+            agg.avg_workload    = wl / agg.count;
+            agg.avg_intensity   = in / agg.count;
+            agg.avg_duration_ms = du / agg.count;
+        }
+
+        if (!thermal && sim_env.temp_c > THERMAL_BACKOFF_C) {
+            freq_policy_set(FREQ_POLICY_THERMAL, 0, THERMAL_CAP_KHZ);
+            thermal = throttle_active = true;
+            res->throttles++;
+        } else if (thermal && sim_env.temp_c < THERMAL_RESTORE_C) {
+            freq_policy_clear(FREQ_POLICY_THERMAL);
+            thermal = throttle_active = false;
+        }
+
+        target_khz = freq_policy_clamp(target_khz);
+        uint32_t before = target_khz;
+        uint32_t khz_before = current_khz;
+        uint64_t tick_us = sim_now_us;
+        g->tick(&agg);
+        res->ticks++;
+        if (target_khz != before) res->retargets++;
+
+        /* Jobs kept running through the tick's ramp steps, at the lower
+           of the two clocks. */
+        if (rs.n && sim_now_us > tick_us) {
+            uint64_t now = sim_now_us;
+            rt_sim_advance(&rs, now, khz_before < current_khz ? khz_before : current_khz,
+                           false, res);
+            sim_now_us = now;
+        }
+
+        if (current_khz != khz_before) res->settle_us = sim_now_us - t0;
+        if (current_khz < res->khz_min) res->khz_min = current_khz;
+        if (current_khz > res->khz_max) res->khz_max = current_khz;
+
+        if (pending && current_khz >= ready_khz) {
+            uint64_t lat = sim_now_us - onset_us;
+            res->burst_reached++;
+            res->burst_total_us += lat;
+            if (lat > res->burst_max_us) res->burst_max_us = (uint32_t)lat;
+            pending = false;
+        }
+
+        if (timeline) {
+            pio_idle_stats_t ps;
+            pio_idle_get_stats(&ps);
+            fprintf(timeline, "%.3f,%lu,%lu,%lu,%lu,%.1f,%.1f,%.1f\n",
+                    (sim_now_us - t0) / 1000.0, (unsigned long)target_khz,
+                    (unsigned long)current_khz, (unsigned long)current_voltage_mv,
+                    (unsigned long)agg.count, agg.avg_intensity,
+                    ps.idle_fraction * 100.0f, sim_env.temp_c);
+        }
+
+        uint32_t req  = governor_take_tick_request();
+        uint32_t wait = governor_sampling_rate_ms(g);
+        if (req < wait) wait = req;
+        if (o->tickless && req == GOV_TICK_NONE && agg.count == 0 &&
+            target_khz == current_khz && wait < GOV_TICKLESS_MAX_MS) {
+            wait = GOV_TICKLESS_MAX_MS;
+            res->tickless_sleeps++;
+        }
+
+        uint64_t next = sim_now_us + (uint64_t)wait * 1000u;
+        if (o->wake_pct) {
+            for (size_t j = i; j < t->n; ++j) {
+                uint64_t ts = t0 + (uint64_t)t->rec[j].ts_ms * 1000u;
+                if (ts >= next) break;
+                if (t->rec[j].count && rec_intensity(o, &t->rec[j]) >= o->wake_pct) {
+                    next = ts > sim_now_us ? ts : sim_now_us + 1u;
+                    res->wakeups++;
+                    break;
+                }
+            }
+        }
+        if (rs.n) {
+            /* A release rings Core 1 like a doorbell record. */
+            uint64_t from = sim_now_us;
+            if (rt_task_take()) {
+                next = sim_now_us;
+            } else {
+                uint64_t cyc = rt_sim_advance(&rs, next, current_khz, true, res);
+                if (rs.t < next) {
+                    next = rs.t;
+                    res->wakeups++;
+                }
+                rt_task_take();
+                if (next > from)
+                    sim_env.rt_busy_khz = (float)((double)cyc * 1000.0 / (double)(next - from));
+            }
+        }
+        sim_now_us = next;
+    }
+    if (pending) res->burst_missed++;
+
+    rt_task_stats_t rt1;
+    rt_task_get_stats(&rt1);
+    res->rt_flagged  = rt1.misses - rt0.misses;
+    res->rt_reclaims = rt1.reclaims - rt0.reclaims;
+    rt_sim_stop(&rs);
+
+    res->khz_end   = current_khz;
+    res->span_us   = sim_now_us - t0;
+    res->energy_uj = energy_total_uj();
+    res->ramp      = sim_ramp;
+    freq_stats_snapshot(&res->fs);
+    freq_policy_clear(FREQ_POLICY_THERMAL);
+}
+
+/* --------------------------------------------------------------------------
+ * Reports
+ * -------------------------------------------------------------------------- */
+
+static double ms(uint64_t us) { return us / 1000.0; }
+
+static double burst_avg_ms(const result_t *r)
+{
+    uint32_t n = r->burst_ready + r->burst_reached;
+    return n ? ms(r->burst_total_us) / n : 0.0;
+}
+
+static double avg_mw(const result_t *r)
+{
+    return r->span_us ? (double)r->energy_uj * 1000.0 / (double)r->span_us : 0.0;
+}
+
+/* Overshoot past the final clock, as a share of the move from the start
+ * (an undershoot when the clock came down). */
+static double overshoot_pct(const result_t *r)
+{
+    uint32_t final_khz = r->khz_end;
+    if (final_khz > r->khz_start)
+        return 100.0 * (r->khz_max - final_khz) / (final_khz - r->khz_start);
+    if (final_khz < r->khz_start)
+        return 100.0 * (final_khz - r->khz_min) / (r->khz_start - final_khz);
+    return 0.0;
+}
+
+static void print_summary(const Governor *g, const char *src, const trace_t *t,
+                          const opts_t *o, const result_t *r)
+{
+    printf("governor     %s (sampling %lu ms, tickless %s, %s ramps, %lu us/step)\n",
+           g->name, (unsigned long)governor_sampling_rate_ms(g),
+           o->tickless ? "on" : "off", sim_cfg.direct ? "direct" : "5 MHz step",
+           (unsigned long)sim_cfg.step_us);
+    printf("trace        %s: %zu records over %.1f s\n",
+           src, t->n, t->rec[t->n - 1].ts_ms / 1000.0);
+    printf("ticks        %lu (%lu doorbell wakeups, %lu tickless sleeps), target changed on %lu\n",
+           (unsigned long)r->ticks, (unsigned long)r->wakeups,
+           (unsigned long)r->tickless_sleeps, (unsigned long)r->retargets);
+    printf("transitions  %lu completed in %lu PLL steps; time-to-target avg %.1f ms, max %.1f ms\n",
+           (unsigned long)r->ramp.transitions, (unsigned long)r->ramp.steps,
+           r->ramp.transitions ? ms(r->ramp.total_us) / r->ramp.transitions : 0.0,
+           ms(r->ramp.max_us));
+    printf("settling     %.1f -> %.1f MHz, last move at %.1f ms, overshoot %.1f%%\n",
+           r->khz_start / 1000.0, r->khz_end / 1000.0, ms(r->settle_us),
+           overshoot_pct(r));
+    printf("bursts       %lu (>= %lu%%): %lu ready at onset, %lu reached avg %.1f ms / max %.1f ms, %lu never\n",
+           (unsigned long)r->bursts, (unsigned long)o->burst_pct,
+           (unsigned long)r->burst_ready, (unsigned long)r->burst_reached,
+           burst_avg_ms(r), ms(r->burst_max_us), (unsigned long)r->burst_missed);
+    if (o->nrt)
+        printf("rt tasks     %d: %lu jobs, %lu late, %lu misses flagged, %lu early completions\n",
+               o->nrt, (unsigned long)r->rt_jobs, (unsigned long)r->rt_late,
+               (unsigned long)r->rt_flagged, (unsigned long)r->rt_reclaims);
+    printf("thermal      %lu throttle events\n", (unsigned long)r->throttles);
+    if (g->export_stats) {
+        char stats[256];
+        g->export_stats(stats, sizeof(stats));
+        printf("gov stats    %s\n", stats);
+    }
+    printf("energy       %.3f mJ, avg %.2f mW\n", r->energy_uj / 1000.0, avg_mw(r));
+    printf("residency    MHz        ms         %%\n");
+    for (uint32_t b = 0; b < FREQ_STATS_BUCKETS; ++b) {
+        if (!r->fs.residency_us[b]) continue;
+        uint32_t lo = freq_stats_bucket_lo_khz(b) / 1000u;
+        printf("             %3lu-%-3lu  %10.1f  %5.1f\n",
+               (unsigned long)lo, (unsigned long)(lo + FREQ_STATS_BUCKET_KHZ / 1000u - 1u),
+               ms(r->fs.residency_us[b]),
+               r->span_us ? 100.0 * r->fs.residency_us[b] / r->span_us : 0.0);
+    }
+}
+
+static void print_sweep_row(const char *name, double v, const result_t *r)
+{
+    printf("%s=%g,%lu,%lu,%lu,%.1f,%.1f,%.1f,%.1f,%lu,%.3f,%.2f,%lu\n",
+           name, v, (unsigned long)r->ticks, (unsigned long)r->retargets,
+           (unsigned long)r->ramp.transitions,
+           r->ramp.transitions ? ms(r->ramp.total_us) / r->ramp.transitions : 0.0,
+           ms(r->ramp.max_us), burst_avg_ms(r), ms(r->burst_max_us),
+           (unsigned long)r->burst_missed, r->energy_uj / 1000.0, avg_mw(r),
+           (unsigned long)r->rt_late);
+}
+
+/* --------------------------------------------------------------------------
+ * Command line
+ * -------------------------------------------------------------------------- */
+
+static void usage(void)
+{
+    fprintf(stderr,
+        "usage: govsim [options] <trace.csv>\n"
+        "       govsim [options] --synth <period_ms>,<burst_ms>,<intensity>,<total_ms>[,<iowait>]\n"
+        "  -g, --gov <name>            governor to replay (default rp2040_perf)\n"
+        "  -p, --param <name>=<value>  set a tunable first (repeatable)\n"
+        "  -s, --sweep <name>=<lo>:<hi>:<step>\n"
+        "                              one run per value, one CSV row each\n"
+        "  -o, --timeline <file>       per-tick CSV: t_ms,target_khz,current_khz,mv,\n"
+        "                              count,intensity,idle_pct,temp_c\n"
+        "  -t, --tickless              tickless pacing (gov tickless on)\n"
+        "  -d, --direct                single-hop ramps (ramp mode direct)\n"
+        "      --step-us <us>          simulated cost of one PLL step (default 200)\n"
+        "      --wake <pct>            doorbell threshold, 0 = off (default 80)\n"
+        "      --burst <pct>           intensity that starts a burst (default 50)\n"
+        "      --burst-khz <khz>       clock that counts as ready (default scaling_max)\n"
+        "      --start-khz <khz>       clock at the start (default 125000)\n"
+        "      --temp <C>              fixed temperature instead of the recorded one\n"
+        "      --scale-intensity       intensity is a busy share at the recorded clock:\n"
+        "                              rescale it to the simulated clock\n"
+        "      --coeff <k_dyn>,<k_static>  energy model (see `energy fit`)\n"
+        "      --rt <period_ms>,<wcet_cycles>[,<used_pct>]\n"
+        "                              periodic task run under EDF on the simulated\n"
+        "                              core, each job taking used_pct of its WCET\n"
+        "                              (default 100); repeatable\n"
+        "  -l, --list                  governors and their tunables\n"
+        "  -v, --verbose               governor dmesg output on stderr\n");
+}
+
+static int parse_assign(const char *arg, const char **name, const char **val)
+{
+    static char buf[MAX_PARAMS + 1][64];
+    static int used = 0;
+    if (used > MAX_PARAMS) return -1;
+    char *b = buf[used++];
+    strncpy(b, arg, sizeof(buf[0]) - 1);
+    b[sizeof(buf[0]) - 1] = '\0';
+    char *eq = strchr(b, '=');
+    if (!eq || eq == b) return -1;
+    *eq = '\0';
+    *name = b;
+    *val  = eq + 1;
+    return 0;
+}
+
+static int set_param(const Governor *g, const char *name, double v)
+{
+    int rc = gov_tunable_set(g, name, v);
+    if (rc == -1)
+        fprintf(stderr, "%s has no tunable '%s' (try --list)\n", g->name, name);
+    else if (rc == -2)
+        fprintf(stderr, "%s: %g out of range for %s\n", g->name, v, name);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    enum { O_STEP = 256, O_WAKE, O_BURST, O_BURST_KHZ, O_START, O_TEMP, O_COEFF, O_SYNTH,
+           O_SCALE, O_RT };
+    static const struct option longopts[] = {
+        { "gov",       required_argument, NULL, 'g' },
+        { "param",     required_argument, NULL, 'p' },
+        { "sweep",     required_argument, NULL, 's' },
+        { "timeline",  required_argument, NULL, 'o' },
+        { "tickless",  no_argument,       NULL, 't' },
+        { "direct",    no_argument,       NULL, 'd' },
+        { "list",      no_argument,       NULL, 'l' },
+        { "verbose",   no_argument,       NULL, 'v' },
+        { "step-us",   required_argument, NULL, O_STEP },
+        { "wake",      required_argument, NULL, O_WAKE },
+        { "burst",     required_argument, NULL, O_BURST },
+        { "burst-khz", required_argument, NULL, O_BURST_KHZ },
+        { "start-khz", required_argument, NULL, O_START },
+        { "temp",      required_argument, NULL, O_TEMP },
+        { "coeff",     required_argument, NULL, O_COEFF },
+        { "synth",     required_argument, NULL, O_SYNTH },
+        { "scale-intensity", no_argument, NULL, O_SCALE },
+        { "rt",        required_argument, NULL, O_RT },
+        { "help",      no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+
+    opts_t o = {
+        .gov       = "rp2040_perf",
+        .wake_pct  = METRICS_WAKE_DEFAULT_INTENSITY,
+        .burst_pct = 50,
+        .start_khz = MIN_KHZ,
+        .temp_c    = -1000.0f,
+    };
+    const char *synth = NULL;
+    const char *coeff = NULL;
+    bool list = false;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "g:p:s:o:tdlvh", longopts, NULL)) != -1) {
+        const char *name, *val;
+        switch (c) {
+        case 'g': o.gov = optarg; break;
+        case 'p':
+            if (o.nparams == MAX_PARAMS || parse_assign(optarg, &name, &val) != 0) {
+                usage();
+                return 2;
+            }
+            o.param_name[o.nparams] = name;
+            o.param_val[o.nparams++] = strtod(val, NULL);
+            break;
+        case 's':
+            if (parse_assign(optarg, &name, &val) != 0 ||
+                sscanf(val, "%lf:%lf:%lf", &o.sweep_lo, &o.sweep_hi, &o.sweep_step) != 3 ||
+                o.sweep_step <= 0.0 || o.sweep_hi < o.sweep_lo) {
+                fprintf(stderr, "--sweep wants <name>=<lo>:<hi>:<step>\n");
+                return 2;
+            }
+            o.sweep_name = name;
+            break;
+        case 'o': o.timeline = optarg; break;
+        case 't': o.tickless = true; break;
+        case 'd': sim_cfg.direct = true; break;
+        case 'l': list = true; break;
+        case 'v': sim_cfg.verbose = true; break;
+        case O_STEP:      sim_cfg.step_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case O_WAKE:      o.wake_pct  = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case O_BURST:     o.burst_pct = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case O_BURST_KHZ: o.burst_khz = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case O_START:     o.start_khz = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case O_TEMP:      o.temp_c    = strtof(optarg, NULL); break;
+        case O_COEFF:     coeff = optarg; break;
+        case O_SYNTH:     synth = optarg; break;
+        case O_SCALE:     o.scale_intensity = true; break;
+        case O_RT: {
+            rt_spec_t *rt = &o.rt[o.nrt < (int)RT_SCHED_MAX_TASKS ? o.nrt : 0];
+            rt->used_pct = 100;
+            if (o.nrt == (int)RT_SCHED_MAX_TASKS ||
+                sscanf(optarg, "%u,%u,%u", &rt->period_ms, &rt->wcet_cycles, &rt->used_pct) < 2 ||
+                !rt->period_ms || !rt->wcet_cycles || rt->used_pct > 100) {
+                fprintf(stderr, "--rt wants <period_ms>,<wcet_cycles>[,<used_pct>] (up to %u)\n",
+                        RT_SCHED_MAX_TASKS);
+                return 2;
+            }
+            o.nrt++;
+            break;
+        }
+        default:
+            usage();
+            return c == 'h' ? 0 : 2;
+        }
+    }
+
+    sim_hal_init();
+    rt_task_init();
+    governors_init();
+
+    if (list) {
+        for (size_t k = 0; k < governors_count(); ++k) {
+            const Governor *lg = governors_get(k);
+            printf("%s (sampling %lu ms)\n", lg->name,
+                   (unsigned long)governor_sampling_rate_ms(lg));
+            gov_tunables_list(lg);
+        }
+        return 0;
+    }
+
+    const Governor *g = governors_find_by_name(o.gov);
+    if (!g) {
+        fprintf(stderr, "unknown governor '%s' (try --list)\n", o.gov);
+        return 2;
+    }
+    if (coeff) {
+        energy_coeffs_t ec;
+        if (sscanf(coeff, "%f,%f", &ec.k_dyn, &ec.k_static) != 2 ||
+            energy_set_coeffs(&ec) != 0) {
+            fprintf(stderr, "--coeff wants <k_dyn>,<k_static> (non-negative)\n");
+            return 2;
+        }
+    }
+    for (int k = 0; k < o.nparams; ++k)
+        if (set_param(g, o.param_name[k], o.param_val[k]) != 0) return 2;
+
+    trace_t t = { NULL, 0 };
+    const char *src = synth ? "synth" : (optind < argc ? argv[optind] : NULL);
+    if (!src) {
+        usage();
+        return 2;
+    }
+    if ((synth ? trace_synth(synth, &t) : trace_load_csv(src, &t)) != 0)
+        return 1;
+
+    FILE *tl = NULL;
+    if (o.timeline) {
+        tl = fopen(o.timeline, "w");
+        if (!tl) { perror(o.timeline); return 1; }
+        fprintf(tl, "t_ms,target_khz,current_khz,mv,count,intensity,idle_pct,temp_c\n");
+    }
+
+    result_t r;
+    if (o.sweep_name) {
+        printf("param,ticks,retargets,transitions,ttt_avg_ms,ttt_max_ms,burst_avg_ms,burst_max_ms,"
+               "bursts_missed,energy_mj,avg_mw,rt_late\n");
+        for (double v = o.sweep_lo; v <= o.sweep_hi + o.sweep_step * 1e-6; v += o.sweep_step) {
+            if (set_param(g, o.sweep_name, v) != 0) return 2;
+            run(g, &t, &o, tl, &r);
+            print_sweep_row(o.sweep_name, v, &r);
+        }
+    } else {
+        run(g, &t, &o, tl, &r);
+        print_summary(g, src, &t, &o, &r);
+    }
+
+    if (tl) fclose(tl);
+    free(t.rec);
+    return 0;
+}
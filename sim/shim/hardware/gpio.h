@@ -0,0 +1,8 @@
+#ifndef SIM_HARDWARE_GPIO_H
+#define SIM_HARDWARE_GPIO_H
+
+#include <stdbool.h>
+
+static inline void gpio_put(unsigned int gpio, bool value) { (void)gpio; (void)value; }
+
+#endif
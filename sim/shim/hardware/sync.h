@@ -0,0 +1,10 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+/* Barriers are real fences, so seqlock.h holds up across host threads
+ * (test_seqlock.c); govsim itself is single-threaded. */
+
+static inline void __dmb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __sev(void) {}
+
+#endif
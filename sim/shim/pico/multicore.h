@@ -0,0 +1,6 @@
+#ifndef SIM_PICO_MULTICORE_H
+#define SIM_PICO_MULTICORE_H
+
+/* Nothing from pico/multicore.h is used on the governor tick path. */
+
+#endif
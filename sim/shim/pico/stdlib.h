@@ -0,0 +1,16 @@
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+/* Host stand-in for the parts of pico/stdlib.h the governor sources use.
+ * Time is govsim's simulated clock (sim_hal.c). */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/time.h"
+
+typedef unsigned int uint;
+
+static inline void tight_loop_contents(void) {}
+
+#endif
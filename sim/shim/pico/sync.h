@@ -0,0 +1,15 @@
+#ifndef SIM_PICO_SYNC_H
+#define SIM_PICO_SYNC_H
+
+/* The simulator is single-threaded: critical sections are no-ops. */
+
+#include <stdint.h>
+#include "hardware/sync.h"
+
+typedef struct { uint32_t unused; } critical_section_t;
+
+static inline void critical_section_init(critical_section_t *cs)           { (void)cs; }
+static inline void critical_section_enter_blocking(critical_section_t *cs) { (void)cs; }
+static inline void critical_section_exit(critical_section_t *cs)           { (void)cs; }
+
+#endif
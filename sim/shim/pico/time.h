@@ -0,0 +1,16 @@
+#ifndef SIM_PICO_TIME_H
+#define SIM_PICO_TIME_H
+
+#include <stdint.h>
+
+typedef uint64_t absolute_time_t;
+
+/* Simulated µs since boot (sim_hal.c). */
+uint64_t time_us_64(void);
+
+static inline uint32_t        time_us_32(void)                   { return (uint32_t)time_us_64(); }
+static inline absolute_time_t get_absolute_time(void)            { return time_us_64(); }
+static inline uint64_t        to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t        to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000u); }
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef SIM_H
+#define SIM_H
+
+/*
+ * sim.h  –  govsim's handle on the hardware stand-ins in sim_hal.c
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "trace.h"
+
+typedef struct {
+    uint32_t step_us;        /* simulated cost of one ramp_step() PLL step */
+    bool     direct;         /* RAMP_MODE_DIRECT: one hop per change       */
+    bool     verbose;        /* dmesg_log() to stderr                      */
+} sim_cfg_t;
+
+/* Environment in force, from the latest replayed record. */
+typedef struct {
+    float temp_c;
+    float busy_khz;          /* CPU demand: busy share x recorded clock    */
+    float rt_busy_khz;       /* --rt jobs: cycles run over the last wait   */
+} sim_env_t;
+
+/* Transitions as ramp_get_latency() counts them on the device. */
+typedef struct {
+    uint32_t steps;          /* PLL steps taken                            */
+    uint32_t transitions;    /* completed (current_khz reached the goal)   */
+    uint64_t total_us;
+    uint32_t max_us;
+} sim_ramp_t;
+
+extern uint64_t   sim_now_us;
+extern sim_cfg_t  sim_cfg;
+extern sim_env_t  sim_env;
+extern sim_ramp_t sim_ramp;
+
+/** Build the PLL table, start the policy, energy and freq_stats modules. */
+void sim_hal_init(void);
+
+/** Start a run at start_khz: zero energy, residency and ramp counters. */
+void sim_hal_reset(uint32_t start_khz);
+
+/** A replayed record with metrics, due at ts_us (feeds metrics_get_stats()). */
+void sim_metrics_push(uint64_t ts_us, const trace_rec_t *r);
+
+/** Stock VREG level for khz (vreg_default_mv()). */
+uint32_t sim_mv_for_khz(uint32_t khz);
+
+#endif /* SIM_H */
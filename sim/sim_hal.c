@@ -0,0 +1,314 @@
+/*
+ * sim_hal.c  –  host stand-ins for the hardware side of the governor API
+ *
+ * Replaces system.c, vreg_cal.c, pio_idle.c, temp_service.c, metrics.c,
+ * freq_boost.c, persist.c and dmesg.c for the governor sources built into
+ * govsim:
+ *
+ *   ramp_step()   system.c's stepping (RAMP_STEP_KHZ through the PLL table,
+ *                 or one hop in direct mode) with stock VREG breakpoints;
+ *                 each PLL step costs sim_cfg.step_us of simulated time
+ *   idle          the recorded busy share, scaled by recorded/current clock,
+ *                 plus the cycles --rt jobs ran over the last wait
+ *   PIO gate      stable once the settle window plus one heartbeat per ms
+ *                 have passed since the last clock change
+ *   temperature   the recorded value; predicted = filtered (no slope)
+ *   metrics       the tick aggregate comes from the replay loop; window
+ *                 p95/max are the largest recorded tick mean in the horizon
+ *   persist       nothing is stored; boosts are never requested
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "sim.h"
+#include "system.h"
+#include "pll_table.h"
+#include "freq_policy.h"
+#include "freq_stats.h"
+#include "freq_boost.h"
+#include "energy.h"
+#include "pio_idle.h"
+#include "temp_service.h"
+#include "metrics.h"
+#include "persist.h"
+#include "dmesg.h"
+
+#define RAMP_STEP_KHZ      5000u     /* as system.c */
+#define PIO_SETTLE_MS      8u        /* pio_idle.c settle window, 1 ms polls */
+#define SIM_METRICS_RING   2048u     /* 10 s of 5 ms ticks */
+
+/* system.h shared state */
+volatile uint32_t target_khz         = MIN_KHZ;
+volatile uint32_t current_khz        = MIN_KHZ;
+volatile bool     live_stats         = false;
+volatile uint32_t core1_wdt_ping     = 0;
+volatile bool     throttle_active    = false;
+volatile uint32_t current_voltage_mv = 1100;
+volatile uint32_t stat_period_ms     = 500;
+
+uint64_t   sim_now_us = 1000000;      /* start one second after "boot" */
+sim_cfg_t  sim_cfg    = { .step_us = 200 };
+sim_env_t  sim_env;
+sim_ramp_t sim_ramp;
+
+static uint32_t ramp_goal_khz  = 0;
+static uint64_t ramp_start_us  = 0;
+static uint64_t last_change_us = 0;
+
+typedef struct {
+    uint64_t ts_us;
+    uint32_t count;
+    float    workload;
+    float    intensity;
+    float    duration_ms;
+} sim_sample_t;
+
+static sim_sample_t s_ring[SIM_METRICS_RING];
+static uint32_t     s_ring_n = 0;     /* total pushed; head = n % size */
+
+uint64_t time_us_64(void)
+{
+    return sim_now_us;
+}
+
+/* --------------------------------------------------------------------------
+ * Clock and voltage
+ * -------------------------------------------------------------------------- */
+
+uint32_t sim_mv_for_khz(uint32_t khz)
+{
+    /* vreg_default_mv() for an SDK without the 1.35 V level. */
+    if (khz > 250000) return 1300;
+    if (khz > 200000) return 1200;
+    return 1100;
+}
+
+static void set_mv(uint32_t mv)
+{
+    if (mv == current_voltage_mv) return;
+    current_voltage_mv = mv;
+    energy_update();
+}
+
+void vreg_prewarm(uint32_t khz)
+{
+    if (khz < current_khz) khz = current_khz;
+    uint32_t mv = sim_mv_for_khz(khz);
+    if (mv > current_voltage_mv)
+        set_mv(mv);
+}
+
+bool ramp_step(uint32_t new_khz)
+{
+    const pll_entry_t *goal = pll_table_nearest(freq_policy_clamp(new_khz));
+    if (!goal) return true;
+    new_khz = goal->khz;
+
+    if (current_khz == new_khz)
+        return true;
+
+    if (new_khz != ramp_goal_khz) {
+        ramp_goal_khz = new_khz;
+        ramp_start_us = sim_now_us;
+    }
+
+    bool up = current_khz < new_khz;
+    const pll_entry_t *next = goal;
+    if (!sim_cfg.direct) {
+        uint32_t candidate;
+        if (up) {
+            candidate = current_khz + RAMP_STEP_KHZ;
+            if (candidate > new_khz) candidate = new_khz;
+            next = pll_table_ceil(candidate);
+        } else {
+            candidate = current_khz - RAMP_STEP_KHZ;
+            if (candidate < new_khz) candidate = new_khz;
+            next = pll_table_floor(candidate);
+        }
+    }
+
+    if (up) set_mv(sim_mv_for_khz(next->khz));
+    sim_now_us += sim_cfg.step_us;
+    freq_stats_record(current_khz, next->khz);
+    current_khz = next->khz;
+    energy_update();
+    if (!up) set_mv(sim_mv_for_khz(next->khz));
+    last_change_us = sim_now_us;
+    sim_ramp.steps++;
+
+    if (current_khz != new_khz)
+        return false;
+
+    uint64_t lat = sim_now_us - ramp_start_us;
+    sim_ramp.transitions++;
+    sim_ramp.total_us += lat;
+    if (lat > sim_ramp.max_us) sim_ramp.max_us = (uint32_t)lat;
+    ramp_goal_khz = 0;
+    return true;
+}
+
+/* --------------------------------------------------------------------------
+ * Setup
+ * -------------------------------------------------------------------------- */
+
+void sim_hal_init(void)
+{
+    pll_table_init();
+    freq_policy_init();
+    current_voltage_mv = sim_mv_for_khz(current_khz);
+    energy_init();
+    freq_stats_init(current_khz);
+}
+
+void sim_hal_reset(uint32_t start_khz)
+{
+    const pll_entry_t *e = pll_table_nearest(start_khz);
+    uint32_t khz = e ? e->khz : MIN_KHZ;
+
+    freq_stats_record(current_khz, khz);
+    current_khz        = khz;
+    target_khz         = khz;
+    current_voltage_mv = sim_mv_for_khz(khz);
+    throttle_active    = false;
+    energy_update();
+    energy_reset();
+    freq_stats_reset();
+
+    memset(&sim_ramp, 0, sizeof(sim_ramp));
+    ramp_goal_khz  = 0;
+    last_change_us = 0;
+    s_ring_n       = 0;
+    sim_env.temp_c   = 40.0f;
+    sim_env.busy_khz = 0.0f;
+    sim_env.rt_busy_khz = 0.0f;
+}
+
+/* --------------------------------------------------------------------------
+ * Temperature and PIO idle
+ * -------------------------------------------------------------------------- */
+
+float read_onboard_temperature(void) { return sim_env.temp_c; }
+float temp_service_celsius(void)     { return sim_env.temp_c; }
+float temp_service_predicted_c(void) { return sim_env.temp_c; }
+
+void pio_idle_get_stats(pio_idle_stats_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    float busy = current_khz ? (sim_env.busy_khz + sim_env.rt_busy_khz) / (float)current_khz : 0.0f;
+    if (busy < 0.0f) busy = 0.0f;
+    if (busy > 1.0f) busy = 1.0f;
+    out->idle_fraction = 1.0f - busy;
+
+    uint64_t since_ms = (sim_now_us - last_change_us) / 1000u;
+    out->stable_count  = since_ms > PIO_SETTLE_MS ? (uint32_t)(since_ms - PIO_SETTLE_MS) : 0u;
+    out->safe_to_scale = out->stable_count >= 4u;
+}
+
+bool pio_idle_safe_to_scale(float idle_thresh, float jitter_thresh,
+                            uint32_t min_stable)
+{
+    (void)idle_thresh;
+    (void)jitter_thresh;
+    pio_idle_stats_t s;
+    pio_idle_get_stats(&s);
+    return s.stable_count >= min_stable;
+}
+
+/* --------------------------------------------------------------------------
+ * Metrics
+ * -------------------------------------------------------------------------- */
+
+void metrics_init(void) {}
+
+uint32_t metrics_get_aggregate(metrics_agg_t *out, int clear)
+{
+    /* govsim always hands the tick its aggregate; nothing is left over. */
+    (void)clear;
+    if (out) memset(out, 0, sizeof(*out));
+    return 0;
+}
+
+void sim_metrics_push(uint64_t ts_us, const trace_rec_t *r)
+{
+    sim_sample_t *s = &s_ring[s_ring_n % SIM_METRICS_RING];
+    s->ts_us       = ts_us;
+    s->count       = r->count;
+    s->workload    = (float)r->workload;
+    s->intensity   = (float)r->intensity;
+    s->duration_ms = (float)r->duration_ms;
+    s_ring_n++;
+}
+
+int metrics_get_stats(metrics_stats_t *out)
+{
+    static const uint32_t horizon_ms[METRICS_WINDOWS] = { 100u, 1000u, 10000u };
+    if (!out) return 0;
+    memset(out, 0, sizeof(*out));
+    out->ts_ms = to_ms_since_boot(sim_now_us);
+
+    uint32_t n = s_ring_n < SIM_METRICS_RING ? s_ring_n : SIM_METRICS_RING;
+    for (uint32_t w = 0; w < METRICS_WINDOWS; ++w) {
+        metrics_window_stats_t *ws = &out->win[w];
+        uint64_t from = sim_now_us - (uint64_t)horizon_ms[w] * 1000u;
+        double wsum = 0.0, wl = 0.0, in = 0.0, du = 0.0;
+        float  max_in = 0.0f, max_du = 0.0f;
+        for (uint32_t k = 0; k < n; ++k) {
+            const sim_sample_t *s = &s_ring[(s_ring_n - 1u - k) % SIM_METRICS_RING];
+            if (s->ts_us < from) break;
+            wsum += s->count;
+            wl   += (double)s->workload * s->count;
+            in   += (double)s->intensity * s->count;
+            du   += (double)s->duration_ms * s->count;
+            if (s->intensity > max_in)   max_in = s->intensity;
+            if (s->duration_ms > max_du) max_du = s->duration_ms;
+        }
+        ws->horizon_ms = horizon_ms[w];
+        ws->weight     = (float)wsum;
+        ws->rate_hz    = (float)(wsum * 1000.0 / horizon_ms[w]);
+        if (wsum > 0.0) {
+            ws->avg_workload    = (float)(wl / wsum);
+            ws->avg_intensity   = (float)(in / wsum);
+            ws->avg_duration_ms = (float)(du / wsum);
+        }
+        ws->p50_intensity   = (uint32_t)(ws->avg_intensity + 0.5f);
+        ws->p95_intensity   = (uint32_t)max_in;
+        ws->max_intensity   = (uint32_t)max_in;
+        ws->p50_duration_ms = (uint32_t)(ws->avg_duration_ms + 0.5f);
+        ws->p95_duration_ms = (uint32_t)max_du;
+        ws->max_duration_ms = (uint32_t)max_du;
+    }
+    out->updates = s_ring_n;
+    return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Boosts, persistence, log
+ * -------------------------------------------------------------------------- */
+
+uint32_t freq_boost_floor_khz(void) { return 0; }
+
+int persist_save(const char *name)                       { (void)name; return 0; }
+int persist_load(char *out, size_t out_len)              { (void)out; (void)out_len; return -1; }
+int persist_save_rp_params(const void *buf, size_t len)  { (void)buf; (void)len; return 0; }
+int persist_load_rp_params(void *out, size_t maxlen)     { (void)out; (void)maxlen; return -1; }
+int persist_save_energy_coeffs(const void *buf, size_t len) { (void)buf; (void)len; return 0; }
+int persist_load_energy_coeffs(void *out, size_t maxlen)    { (void)out; (void)maxlen; return -1; }
+
+int persist_save_gov_params(uint32_t key, const void *buf, size_t len)
+{
+    (void)key; (void)buf; (void)len;
+    return 0;
+}
+
+int persist_load_gov_params(uint32_t key, void *out, size_t maxlen)
+{
+    (void)key; (void)out; (void)maxlen;
+    return -1;
+}
+
+void dmesg_log(const char *msg)
+{
+    if (sim_cfg.verbose)
+        fprintf(stderr, "[%10.3f] %s\n", sim_now_us / 1e6, msg);
+}
@@ -0,0 +1,155 @@
+/*
+ * test_pll_table.c  –  host test of the PLL table generator in pll_table.c
+ *
+ * Every entry is checked against sys_clk = 12 MHz × fbdiv / (pd1 × pd2)
+ * and the VCO limits, and the table as a whole against a brute-force
+ * search of the divisor space for every kHz in [MIN_KHZ, MAX_KHZ].  The
+ * floor/ceil/nearest lookups are checked at the table's edges and
+ * between neighbouring entries.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "pll_table.h"
+#include "system.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        failures++;                                             \
+    }                                                           \
+} while (0)
+
+#define SPAN_KHZ (MAX_KHZ - MIN_KHZ + 1u)
+
+/* Best solution per kHz by brute force: highest VCO, then largest
+ * postdiv1 (postdiv2 <= postdiv1, as check_sys_clock_khz() searches). */
+static bool     bf_found[SPAN_KHZ];
+static uint32_t bf_vco[SPAN_KHZ];
+static uint8_t  bf_pd1[SPAN_KHZ];
+
+static void brute_force(void)
+{
+    for (uint32_t fbdiv = PLL_TABLE_FBDIV_MIN; fbdiv <= PLL_TABLE_FBDIV_MAX; ++fbdiv) {
+        uint32_t vco = PLL_TABLE_XOSC_KHZ * fbdiv;
+        if (vco < PLL_TABLE_VCO_MIN_KHZ || vco > PLL_TABLE_VCO_MAX_KHZ) continue;
+        for (uint32_t pd1 = 1; pd1 <= PLL_TABLE_POSTDIV_MAX; ++pd1) {
+            for (uint32_t pd2 = 1; pd2 <= pd1; ++pd2) {
+                if (vco % (pd1 * pd2)) continue;
+                uint32_t khz = vco / (pd1 * pd2);
+                if (khz < MIN_KHZ || khz > MAX_KHZ) continue;
+                uint32_t i = khz - MIN_KHZ;
+                if (!bf_found[i] || vco > bf_vco[i] ||
+                    (vco == bf_vco[i] && pd1 > bf_pd1[i])) {
+                    bf_found[i] = true;
+                    bf_vco[i]   = vco;
+                    bf_pd1[i]   = (uint8_t)pd1;
+                }
+            }
+        }
+    }
+}
+
+static void test_entries(void)
+{
+    size_t n = pll_table_count();
+    CHECK(n == 180, "%zu entries, want 180 (pll_table.h)", n);
+    for (size_t i = 0; i < n; ++i) {
+        const pll_entry_t *e = pll_table_get(i);
+        uint32_t div = (uint32_t)e->postdiv1 * e->postdiv2;
+        CHECK(e->fbdiv >= PLL_TABLE_FBDIV_MIN && e->fbdiv <= PLL_TABLE_FBDIV_MAX,
+              "entry %zu: fbdiv %u", i, e->fbdiv);
+        CHECK(e->postdiv1 >= 1 && e->postdiv1 <= PLL_TABLE_POSTDIV_MAX &&
+              e->postdiv2 >= 1 && e->postdiv2 <= e->postdiv1,
+              "entry %zu: postdiv %u/%u", i, e->postdiv1, e->postdiv2);
+        CHECK(e->vco_khz == PLL_TABLE_XOSC_KHZ * e->fbdiv, "entry %zu: vco %u",
+              i, (unsigned)e->vco_khz);
+        CHECK(e->vco_khz >= PLL_TABLE_VCO_MIN_KHZ && e->vco_khz <= PLL_TABLE_VCO_MAX_KHZ,
+              "entry %zu: vco %u out of range", i, (unsigned)e->vco_khz);
+        CHECK(e->vco_khz % div == 0 && e->khz == e->vco_khz / div,
+              "entry %zu: %u kHz != 12000 * %u / (%u * %u)", i, (unsigned)e->khz,
+              e->fbdiv, e->postdiv1, e->postdiv2);
+        CHECK(e->khz >= MIN_KHZ && e->khz <= MAX_KHZ, "entry %zu: %u kHz outside range",
+              i, (unsigned)e->khz);
+        if (i > 0)
+            CHECK(pll_table_get(i - 1)->khz < e->khz, "entries %zu/%zu unsorted or duplicate",
+                  i - 1, i);
+    }
+}
+
+static void test_brute_force(void)
+{
+    brute_force();
+    size_t n = pll_table_count(), j = 0;
+    for (uint32_t i = 0; i < SPAN_KHZ; ++i) {
+        if (!bf_found[i]) continue;
+        const pll_entry_t *e = pll_table_get(j++);
+        if (!e) {
+            CHECK(false, "%u kHz missing from the table", (unsigned)(MIN_KHZ + i));
+            break;
+        }
+        CHECK(e->khz == MIN_KHZ + i, "table has %u kHz where %u kHz is next",
+              (unsigned)e->khz, (unsigned)(MIN_KHZ + i));
+        CHECK(e->vco_khz == bf_vco[i] && e->postdiv1 == bf_pd1[i],
+              "%u kHz: vco %u pd1 %u, SDK order picks vco %u pd1 %u", (unsigned)e->khz,
+              (unsigned)e->vco_khz, e->postdiv1, (unsigned)bf_vco[i], bf_pd1[i]);
+    }
+    CHECK(j == n, "brute force finds %zu frequencies, table has %zu", j, n);
+
+    /* A table too small keeps the lowest entries, still sorted. */
+    pll_entry_t small[8];
+    size_t m = pll_table_build(small, 8, MIN_KHZ, MAX_KHZ);
+    CHECK(m == 8, "capped build wrote %zu", m);
+    CHECK(pll_table_build(small, 8, MAX_KHZ, MIN_KHZ) == 0, "inverted range built");
+}
+
+static void test_lookups(void)
+{
+    size_t n = pll_table_count();
+    const pll_entry_t *first = pll_table_get(0);
+    const pll_entry_t *last  = pll_table_get(n - 1);
+
+    CHECK(pll_table_floor(first->khz - 1u) == NULL, "floor below the table");
+    CHECK(pll_table_floor(first->khz) == first, "floor at the first entry");
+    CHECK(pll_table_ceil(0) == first, "ceil of 0");
+    CHECK(pll_table_ceil(last->khz) == last, "ceil at the last entry");
+    CHECK(pll_table_ceil(last->khz + 1u) == NULL, "ceil above the table");
+    CHECK(pll_table_floor(UINT32_MAX) == last, "floor of UINT32_MAX");
+    CHECK(pll_table_nearest(0) == first, "nearest below the table");
+    CHECK(pll_table_nearest(UINT32_MAX) == last, "nearest above the table");
+
+    for (size_t i = 0; i + 1 < n; ++i) {
+        const pll_entry_t *a = pll_table_get(i), *b = pll_table_get(i + 1);
+        uint32_t gap = b->khz - a->khz;
+        CHECK(pll_table_floor(a->khz) == a && pll_table_ceil(a->khz) == a &&
+              pll_table_nearest(a->khz) == a, "exact lookups of %u kHz", (unsigned)a->khz);
+        if (gap < 2) continue;
+        CHECK(pll_table_floor(b->khz - 1u) == a && pll_table_ceil(a->khz + 1u) == b,
+              "floor/ceil between %u and %u kHz", (unsigned)a->khz, (unsigned)b->khz);
+        /* The midpoint is a tie (even gap, resolves downward) or closer
+           to a; one kHz above it is always closer to b. */
+        uint32_t mid = a->khz + gap / 2u;
+        CHECK(pll_table_nearest(mid) == a, "nearest(%u) between %u and %u",
+              (unsigned)mid, (unsigned)a->khz, (unsigned)b->khz);
+        CHECK(pll_table_nearest(mid + 1u) == b, "nearest(%u) between %u and %u",
+              (unsigned)(mid + 1u), (unsigned)a->khz, (unsigned)b->khz);
+    }
+}
+
+int main(void)
+{
+    pll_table_init();
+    test_entries();
+    test_brute_force();
+    test_lookups();
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("pll_table: ok\n");
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * test_rt_sched.c  –  host test of the EDF accounting in rt_sched.c
+ *
+ * Demand (Σ C/P rounded up to kHz), cycle-conserving reclaim and its
+ * reset at the next release, and deadline misses counted once per job
+ * whether the job is still open at its deadline or completes after it.
+ */
+
+#include <stdio.h>
+#include "rt_sched.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        failures++;                                             \
+    }                                                           \
+} while (0)
+
+#define MS(x) ((uint64_t)(x) * 1000u)
+
+static void test_demand(void)
+{
+    rt_sched_t s;
+    rt_sched_init(&s);
+    CHECK(rt_sched_demand_khz(&s) == 0, "empty set demands %u kHz",
+          (unsigned)rt_sched_demand_khz(&s));
+    CHECK(rt_sched_add(&s, 0, 1000) < 0 && rt_sched_add(&s, 10, 0) < 0,
+          "zero period or WCET accepted");
+
+    /* 400k cycles per 10 ms = 40 MHz; 100k per 3 ms = 33.333.. MHz. */
+    int a = rt_sched_add(&s, 10, 400000);
+    CHECK(rt_sched_demand_khz(&s) == 40000, "one task: %u kHz, want 40000",
+          (unsigned)rt_sched_demand_khz(&s));
+    int b = rt_sched_add(&s, 3, 100000);
+    CHECK(a >= 0 && b >= 0, "add failed");
+    CHECK(rt_sched_demand_khz(&s) == 73334, "two tasks: %u kHz, want 73334 (rounded up)",
+          (unsigned)rt_sched_demand_khz(&s));
+    CHECK(rt_sched_wcet_khz(&s) == 73334, "wcet demand %u kHz",
+          (unsigned)rt_sched_wcet_khz(&s));
+    CHECK(rt_sched_count(&s) == 2, "count %u", (unsigned)rt_sched_count(&s));
+
+    /* Removing a task drops its share; its handle goes stale for good. */
+    CHECK(rt_sched_remove(&s, b) == 0, "remove failed");
+    CHECK(rt_sched_demand_khz(&s) == 40000, "after remove: %u kHz",
+          (unsigned)rt_sched_demand_khz(&s));
+    int c = rt_sched_add(&s, 5, 50000);
+    CHECK(c >= 0 && c != b, "slot reuse kept the old handle");
+    CHECK(rt_sched_release(&s, b, 0) < 0, "stale handle released");
+    CHECK(rt_sched_remove(&s, b) < 0, "stale handle removed");
+
+    for (uint32_t i = rt_sched_count(&s); i < RT_SCHED_MAX_TASKS; ++i)
+        rt_sched_add(&s, 100, 1000);
+    CHECK(rt_sched_add(&s, 100, 1000) < 0, "add past RT_SCHED_MAX_TASKS");
+}
+
+static void test_reclaim(void)
+{
+    rt_sched_t s;
+    rt_sched_init(&s);
+    int a = rt_sched_add(&s, 10, 400000);
+    int b = rt_sched_add(&s, 20, 200000);
+    /* 40000 + 10000 kHz */
+    rt_sched_release(&s, a, 0);
+    rt_sched_release(&s, b, 0);
+    CHECK(rt_sched_demand_khz(&s) == 50000, "at release: %u kHz",
+          (unsigned)rt_sched_demand_khz(&s));
+
+    /* a used a quarter of its budget: 10000 + 10000 kHz until it is
+       released again. */
+    CHECK(rt_sched_complete(&s, a, 100000, MS(2)) == 0, "early completion missed");
+    CHECK(rt_sched_demand_khz(&s) == 20000, "after reclaim: %u kHz",
+          (unsigned)rt_sched_demand_khz(&s));
+    CHECK(rt_sched_wcet_khz(&s) == 50000, "wcet demand moved: %u kHz",
+          (unsigned)rt_sched_wcet_khz(&s));
+    CHECK(s.reclaims == 1, "reclaims %u", (unsigned)s.reclaims);
+
+    /* Unknown (0) and over-budget completions keep the worst case. */
+    CHECK(rt_sched_complete(&s, b, 0, MS(3)) == 0, "completion of b");
+    CHECK(rt_sched_demand_khz(&s) == 20000, "0 cycles reclaimed: %u kHz",
+          (unsigned)rt_sched_demand_khz(&s));
+    CHECK(rt_sched_complete(&s, b, 1000, MS(4)) < 0, "completed a job twice");
+
+    /* Next release of a: the worst case is back. */
+    CHECK(rt_sched_release(&s, a, MS(10)) == 0, "on-time release flagged");
+    CHECK(rt_sched_demand_khz(&s) == 50000, "after re-release: %u kHz",
+          (unsigned)rt_sched_demand_khz(&s));
+    CHECK(rt_sched_complete(&s, a, 500000, MS(12)) == 0, "overrun flagged late");
+    CHECK(s.task[a & 0xFF].overruns == 1 && s.reclaims == 1 &&
+          rt_sched_demand_khz(&s) == 50000, "overrun counted as reclaim");
+}
+
+static void test_miss_open_at_deadline(void)
+{
+    rt_sched_t s;
+    rt_sched_init(&s);
+    int a = rt_sched_add(&s, 10, 1000);
+    rt_sched_release(&s, a, 0);
+    CHECK(rt_sched_next_deadline_us(&s) == MS(10), "deadline %llu",
+          (unsigned long long)rt_sched_next_deadline_us(&s));
+
+    /* Open at its deadline: the check still gives it until after it, the
+       next release (which can only come at or after it) does not. */
+    CHECK(rt_sched_check(&s, MS(10)) == 0, "flagged at the deadline by check");
+    CHECK(rt_sched_check(&s, MS(10) + 1u) == 1, "not flagged past the deadline");
+    CHECK(rt_sched_check(&s, MS(11)) == 0, "flagged twice by check");
+    CHECK(rt_sched_next_deadline_us(&s) == UINT64_MAX, "late job still pending");
+    CHECK(rt_sched_complete(&s, a, 1000, MS(12)) == 0, "late completion flagged again");
+    CHECK(rt_sched_release(&s, a, MS(20)) == 0, "completed job flagged at release");
+    CHECK(s.misses == 1 && s.task[a & 0xFF].misses == 1, "misses %u", (unsigned)s.misses);
+
+    /* Open exactly at the deadline when the next job is released. */
+    CHECK(rt_sched_release(&s, a, MS(30)) == 1, "open job not flagged at release");
+    CHECK(rt_sched_check(&s, MS(31)) == 0, "new job flagged");
+    CHECK(s.misses == 2 && s.abandoned == 0, "misses %u abandoned %u",
+          (unsigned)s.misses, (unsigned)s.abandoned);
+}
+
+static void test_miss_completed_late(void)
+{
+    rt_sched_t s;
+    rt_sched_init(&s);
+    int a = rt_sched_add(&s, 10, 1000);
+
+    rt_sched_release(&s, a, 0);
+    CHECK(rt_sched_complete(&s, a, 1000, MS(10)) == 0, "completion at the deadline flagged");
+
+    rt_sched_release(&s, a, MS(10));
+    CHECK(rt_sched_complete(&s, a, 1000, MS(20) + 1u) == 1, "late completion not flagged");
+    CHECK(rt_sched_check(&s, MS(25)) == 0, "completed job flagged by check");
+    CHECK(rt_sched_release(&s, a, MS(30)) == 0, "completed job flagged at release");
+    CHECK(s.misses == 1, "misses %u", (unsigned)s.misses);
+
+    /* Removing the task keeps the set-wide count. */
+    rt_sched_remove(&s, a);
+    CHECK(s.misses == 1 && rt_sched_check(&s, MS(100)) == 0, "removed task flagged");
+}
+
+static void test_abandoned(void)
+{
+    rt_sched_t s;
+    rt_sched_init(&s);
+    int a = rt_sched_add(&s, 10, 1000);
+
+    /* Released early while the previous job is open, not late. */
+    rt_sched_release(&s, a, 0);
+    CHECK(rt_sched_release(&s, a, MS(5)) == 0, "early release counted as a miss");
+    CHECK(s.abandoned == 1 && s.task[a & 0xFF].abandoned == 1 && s.misses == 0,
+          "abandoned %u misses %u", (unsigned)s.abandoned, (unsigned)s.misses);
+    CHECK(rt_sched_next_deadline_us(&s) == MS(15), "deadline of the new job %llu",
+          (unsigned long long)rt_sched_next_deadline_us(&s));
+    CHECK(s.task[a & 0xFF].jobs == 2, "jobs %u", (unsigned)s.task[a & 0xFF].jobs);
+
+    /* A late job replaced by the next release is a miss, not both. */
+    CHECK(rt_sched_check(&s, MS(16)) == 1, "late job not flagged");
+    CHECK(rt_sched_release(&s, a, MS(17)) == 0, "flagged twice");
+    CHECK(s.abandoned == 1 && s.misses == 1, "abandoned %u misses %u",
+          (unsigned)s.abandoned, (unsigned)s.misses);
+}
+
+int main(void)
+{
+    test_demand();
+    test_reclaim();
+    test_miss_open_at_deadline();
+    test_miss_completed_late();
+    test_abandoned();
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("rt_sched: ok\n");
+    return 0;
+}
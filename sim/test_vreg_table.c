@@ -0,0 +1,176 @@
+/*
+ * test_vreg_table.c  –  host test of the undervolt search in vreg_table.c
+ *
+ * The oracle models a part that is stable at `khz` iff mv >= need(khz),
+ * a threshold rising with frequency.  Every band's search result is
+ * checked against the answer worked out from that threshold directly:
+ * the lowest level reachable in VREG_TABLE_STEP_MV steps from the band's
+ * default that still passes, plus the margin, capped at the default.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "vreg_table.h"
+#include "system.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        failures++;                                             \
+    }                                                           \
+} while (0)
+
+typedef struct {
+    uint32_t base_mv;       /* need at MIN_KHZ                  */
+    uint32_t mv_per_mhz;    /* need rises this much per MHz, ×10 */
+    uint32_t probes;
+    uint32_t below_need;    /* probes under the threshold       */
+} part_t;
+
+static uint32_t need_mv(const part_t *p, uint32_t khz)
+{
+    return p->base_mv + (khz - MIN_KHZ) / 1000u * p->mv_per_mhz / 10u;
+}
+
+static bool oracle(uint32_t khz, uint32_t mv, void *ctx)
+{
+    part_t *p = (part_t *)ctx;
+    p->probes++;
+    bool ok = mv >= need_mv(p, khz);
+    if (!ok) p->below_need++;
+    return ok;
+}
+
+/* Stock level per band, as vreg_default_mv() gives for its top clock. */
+static uint16_t default_mv(uint32_t band)
+{
+    uint32_t khz = vreg_table_band_top_khz(band);
+    if (khz > 250000) return 1300;
+    if (khz > 200000) return 1200;
+    return 1100;
+}
+
+/* Lowest passing level from start_mv down to floor_mv, worked out from the
+ * threshold instead of by probing. */
+static uint32_t expect_lowest(const part_t *p, uint32_t khz, uint32_t start_mv,
+                              uint32_t floor_mv)
+{
+    uint32_t lim = need_mv(p, khz);
+    if (lim < floor_mv) lim = floor_mv;
+    if (start_mv < lim) return 0;
+    return start_mv - (start_mv - lim) / VREG_TABLE_STEP_MV * VREG_TABLE_STEP_MV;
+}
+
+static void test_search_per_band(void)
+{
+    part_t p = { .base_mv = 880, .mv_per_mhz = 25 };
+    const uint32_t margin = 50;
+    for (uint32_t b = 0; b < VREG_TABLE_BANDS; ++b) {
+        uint32_t khz   = vreg_table_band_top_khz(b);
+        uint32_t start = default_mv(b);
+        uint32_t lowest = 0;
+        uint32_t mv = vreg_table_search(khz, start, VREG_TABLE_MIN_MV, margin,
+                                        oracle, &p, &lowest);
+        uint32_t want = expect_lowest(&p, khz, start, VREG_TABLE_MIN_MV);
+        uint32_t want_mv = want + margin < start ? want + margin : start;
+        CHECK(lowest == want, "band %u (%u kHz): lowest %u mV, want %u",
+              (unsigned)b, (unsigned)khz, (unsigned)lowest, (unsigned)want);
+        CHECK(mv == want_mv, "band %u (%u kHz): result %u mV, want %u",
+              (unsigned)b, (unsigned)khz, (unsigned)mv, (unsigned)want_mv);
+        CHECK(mv >= need_mv(&p, khz), "band %u: result %u mV below need %u",
+              (unsigned)b, (unsigned)mv, (unsigned)need_mv(&p, khz));
+    }
+    /* The search stops at the first failure: at most one per band. */
+    CHECK(p.below_need <= VREG_TABLE_BANDS, "%u failing probes",
+          (unsigned)p.below_need);
+}
+
+static void test_search_edges(void)
+{
+    part_t p = { .base_mv = 1150, .mv_per_mhz = 0 };
+    uint32_t lowest = 123;
+    /* The default itself fails: no result, *lowest_out untouched. */
+    CHECK(vreg_table_search(MIN_KHZ, 1100, 850, 50, oracle, &p, &lowest) == 0,
+          "failing start accepted");
+    CHECK(lowest == 123, "lowest_out written on failure");
+
+    /* Never below the floor, even if the part would pass there. */
+    p.base_mv = 0;
+    CHECK(vreg_table_search(MIN_KHZ, 1100, 950, 0, oracle, &p, &lowest) == 950,
+          "search went below the floor");
+    /* The margin never lifts the result above the default. */
+    CHECK(vreg_table_search(MIN_KHZ, 1100, 1050, 200, oracle, &p, NULL) == 1100,
+          "margin lifted the result above start");
+    CHECK(vreg_table_search(MIN_KHZ, 1100, 850, 50, NULL, &p, NULL) == 0,
+          "no oracle accepted");
+}
+
+static void test_calibrate(void)
+{
+    part_t p = { .base_mv = 880, .mv_per_mhz = 25 };
+    const uint32_t margin = 50;
+    uint16_t start[VREG_TABLE_BANDS];
+    for (uint32_t b = 0; b < VREG_TABLE_BANDS; ++b) start[b] = default_mv(b);
+
+    vreg_table_t t;
+    uint32_t done = vreg_table_calibrate(&t, start, VREG_TABLE_MIN_MV, margin,
+                                         oracle, &p);
+    CHECK(t.valid && t.margin_mv == margin, "table not marked valid");
+
+    /* Replay the chain: each band's floor is the last raw result. */
+    uint32_t floor = VREG_TABLE_MIN_MV, want_done = 0;
+    uint16_t prev = 0;
+    for (uint32_t b = 0; b < VREG_TABLE_BANDS; ++b) {
+        uint32_t khz = vreg_table_band_top_khz(b);
+        if (b > 0 && khz == vreg_table_band_top_khz(b - 1u)) {
+            CHECK(t.mv[b] == t.mv[b - 1u], "band %u past MAX_KHZ differs", (unsigned)b);
+            continue;
+        }
+        uint32_t lowest = expect_lowest(&p, khz, start[b], floor);
+        uint32_t want = lowest + margin < start[b] ? lowest + margin : start[b];
+        if (want < prev) want = prev;               /* monotonic */
+        CHECK(t.mv[b] == want, "band %u: %u mV, want %u",
+              (unsigned)b, (unsigned)t.mv[b], (unsigned)want);
+        if (lowest > floor) floor = lowest;
+        prev = t.mv[b];
+        want_done++;
+    }
+    CHECK(done == want_done, "%u bands calibrated, want %u",
+          (unsigned)done, (unsigned)want_done);
+
+    /* Lookup picks the band of the clock, or the default when unset. */
+    CHECK(vreg_table_lookup(&t, MIN_KHZ, 1100) == t.mv[0], "lookup at MIN_KHZ");
+    CHECK(vreg_table_lookup(&t, MIN_KHZ + 10001u, 1100) == t.mv[1], "lookup in band 1");
+    CHECK(vreg_table_lookup(&t, MAX_KHZ, 1300) == t.mv[VREG_TABLE_BANDS - 1u],
+          "lookup at MAX_KHZ");
+    t.valid = 0;
+    CHECK(vreg_table_lookup(&t, MAX_KHZ, 1300) == 1300, "invalid table used");
+}
+
+static void test_monotonic(void)
+{
+    vreg_table_t t;
+    memset(&t, 0, sizeof(t));
+    t.mv[0] = 1000; t.mv[1] = 950; t.mv[2] = 0; t.mv[3] = 900; t.mv[4] = 1100;
+    vreg_table_make_monotonic(&t);
+    CHECK(t.mv[1] == 1000 && t.mv[2] == 0 && t.mv[3] == 1000 && t.mv[4] == 1100,
+          "not monotonic: %u %u %u %u", t.mv[1], t.mv[2], t.mv[3], t.mv[4]);
+}
+
+int main(void)
+{
+    test_search_per_band();
+    test_search_edges();
+    test_calibrate();
+    test_monotonic();
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("vreg_table: ok\n");
+    return 0;
+}
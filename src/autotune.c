@@ -0,0 +1,419 @@
+/*
+ * autotune.c  –  on-device search for governor tunables
+ *
+ * The search itself lives in tune_search.c; this file supplies the
+ * evaluation (cold-started benchmarks, time-to-max sampling, scoring),
+ * the per-governor search spaces and persistence of the run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "autotune.h"
+#include "tune_search.h"
+#include "benchmark.h"
+#include "governors.h"
+#include "gov_tunable.h"
+#include "freq_policy.h"
+#include "system.h"
+#include "energy.h"
+#include "persist.h"
+#include "safepoint.h"
+#include "dmesg.h"
+
+#define AUTOTUNE_VERSION            1u
+#define AUTOTUNE_SUSPEND_TIMEOUT_MS 1000u
+#define AUTOTUNE_PARK_TIMEOUT_MS    2000u
+#define AUTOTUNE_GAP_MS             100u    /* between benchmarks */
+#define AUTOTUNE_TTM_POLL_MS        2u
+#define AUTOTUNE_CHECKPOINT_EVALS   20u     /* max evaluations between saves */
+
+/* Fields searched per governor: initial probe distance and resolution.
+ * Bounds come from the governor's tunable descriptors. */
+typedef struct {
+    const char *param;
+    double      step;
+    double      min_step;
+} autotune_dim_t;
+
+static const autotune_dim_t rp_space[] = {
+    { "cooldown_ms",          500.0, 50.0 },
+    { "ramp_up_cooldown_ms",  200.0, 20.0 },
+    { "sampling_rate_ms",      10.0,  2.0 },
+    { "thr_high_intensity",    10.0,  1.0 },
+    { "thr_med_intensity",     10.0,  1.0 },
+    { "thr_low_intensity",      5.0,  1.0 },
+    { "dur_high_ms",          100.0, 10.0 },
+    { "dur_med_ms",            50.0,  5.0 },
+    { "dur_short_ms",          50.0,  5.0 },
+};
+
+static const struct {
+    const char           *gov;
+    const autotune_dim_t *dims;
+    uint32_t              n;
+} spaces[] = {
+    { "rp2040_perf", rp_space, sizeof(rp_space) / sizeof(rp_space[0]) },
+};
+
+static const char *const bench_targets[] = {
+    "cpu", "memcpy", "memset", "mem_stream", "rand_access", "mem_stream_dma",
+};
+#define BENCH_TARGETS (sizeof(bench_targets) / sizeof(bench_targets[0]))
+
+/* Persisted as one blob; version and size must both match to resume. */
+typedef struct {
+    uint32_t      version;
+    char          gov[16];
+    uint32_t      budget_ms;
+    uint32_t      elapsed_ms;         /* benchmarking time spent so far */
+    uint32_t      bench_ms;
+    uint8_t       nbench;
+    uint8_t       bench[AUTOTUNE_MAX_BENCH];  /* indices into bench_targets */
+    uint8_t       reserved;
+    double        ref_value[AUTOTUNE_MAX_BENCH];   /* starting set's results */
+    double        ref_uj[AUTOTUNE_MAX_BENCH];
+    double        start_score;
+    tune_search_t search;
+} autotune_state_t;
+
+_Static_assert(sizeof(autotune_state_t) <= PERSIST_AUTOTUNE_MAX,
+               "autotune state does not fit its persist record");
+
+typedef struct {
+    double   value[AUTOTUNE_MAX_BENCH];
+    double   uj[AUTOTUNE_MAX_BENCH];
+    uint32_t ttm_ms[AUTOTUNE_MAX_BENCH];
+} autotune_result_t;
+
+static autotune_state_t s_state;
+
+/* Time-to-max sampling, from a core 0 timer while a benchmark runs. */
+static volatile bool     s_ttm_hit;
+static volatile uint64_t s_ttm_us;
+static uint64_t          s_ttm_t0_us;
+static uint32_t          s_ttm_ceiling_khz;
+
+static bool ttm_poll(repeating_timer_t *t)
+{
+    (void)t;
+    if (!s_ttm_hit && current_khz >= s_ttm_ceiling_khz) {
+        s_ttm_us  = time_us_64() - s_ttm_t0_us;
+        s_ttm_hit = true;
+    }
+    return true;
+}
+
+/* --------------------------------------------------------------------------
+ * Search space
+ * -------------------------------------------------------------------------- */
+
+static int find_space(const char *gov)
+{
+    for (size_t i = 0; i < sizeof(spaces) / sizeof(spaces[0]); ++i)
+        if (strcmp(spaces[i].gov, gov) == 0) return (int)i;
+    return -1;
+}
+
+/* Bounds from the descriptors; false if a field is missing. */
+static bool build_dims(const Governor *g, int sp, tune_dim_t *dims)
+{
+    for (uint32_t i = 0; i < spaces[sp].n; ++i) {
+        const autotune_dim_t *a = &spaces[sp].dims[i];
+        const gov_tunable_t  *d = gov_tunable_find(g->tunables, a->param);
+        if (!d) return false;
+        dims[i].lo       = d->min;
+        dims[i].hi       = d->max;
+        dims[i].step     = a->step;
+        dims[i].min_step = a->min_step;
+    }
+    return true;
+}
+
+static void apply_point(const Governor *g, int sp, const double *v)
+{
+    for (uint32_t i = 0; i < spaces[sp].n; ++i)
+        gov_tunable_apply(g, spaces[sp].dims[i].param, v[i]);
+}
+
+/* --------------------------------------------------------------------------
+ * Evaluation
+ * -------------------------------------------------------------------------- */
+
+/* Park clk_sys at the policy minimum and restart the governor from its
+ * init state, so each benchmark measures a full ramp. */
+static bool cold_start(const Governor *g)
+{
+    if (!governor_suspend(AUTOTUNE_SUSPEND_TIMEOUT_MS)) return false;
+    uint32_t lo = freq_policy_min_khz();
+    target_khz = lo;
+    uint32_t t0 = to_ms_since_boot(get_absolute_time());
+    bool ok = true;
+    while (current_khz != lo) {
+        safepoint_poll();
+        if (to_ms_since_boot(get_absolute_time()) - t0 > AUTOTUNE_PARK_TIMEOUT_MS) {
+            ok = false;
+            break;
+        }
+        sleep_ms(1);
+    }
+    governors_set_current_transient(g);
+    governor_resume();
+    return ok;
+}
+
+/* Primary metric: the fourth field of gov,target,metric,value,... */
+static double csv_value(const char *csv)
+{
+    for (int commas = 0; *csv && commas < 3; ++csv)
+        if (*csv == ',') commas++;
+    return strtod(csv, NULL);
+}
+
+static bool evaluate(const Governor *g, const autotune_state_t *st,
+                     autotune_result_t *r)
+{
+    char csv[256];
+    for (uint32_t b = 0; b < st->nbench; ++b) {
+        const char *target = bench_targets[st->bench[b]];
+        if (!cold_start(g)) {
+            printf("autotune: could not park the clock before %s\n", target);
+            return false;
+        }
+
+        repeating_timer_t rt;
+        s_ttm_ceiling_khz = freq_policy_clamp(MAX_KHZ);
+        s_ttm_hit         = false;
+        s_ttm_t0_us       = time_us_64();
+        bool timer = add_repeating_timer_ms(-(int32_t)AUTOTUNE_TTM_POLL_MS,
+                                            ttm_poll, NULL, &rt);
+        uint64_t uj0 = energy_total_uj();
+        int rc = bench_run_collect(target, st->bench_ms, csv, sizeof(csv));
+        r->uj[b] = (double)(energy_total_uj() - uj0);
+        if (timer) cancel_repeating_timer(&rt);
+        if (rc != 0) return false;
+
+        r->value[b]  = csv_value(csv);
+        r->ttm_ms[b] = s_ttm_hit ? (uint32_t)(s_ttm_us / 1000u) : st->bench_ms;
+        sleep_ms(AUTOTUNE_GAP_MS);
+    }
+    return true;
+}
+
+static double score(const autotune_state_t *st, const autotune_result_t *r)
+{
+    double tp = 0.0, en = 0.0, ttm = 0.0;
+    for (uint32_t b = 0; b < st->nbench; ++b) {
+        tp  += st->ref_value[b] > 0.0 ? r->value[b] / st->ref_value[b] : 1.0;
+        en  += st->ref_uj[b] > 0.0 ? r->uj[b] / st->ref_uj[b] : 1.0;
+        ttm += (double)r->ttm_ms[b] / (double)st->bench_ms;
+    }
+    double n = (double)st->nbench;
+    return tp / n - AUTOTUNE_W_ENERGY * (en / n - 1.0) - AUTOTUNE_W_TTM * ttm / n;
+}
+
+/* --------------------------------------------------------------------------
+ * Run loop
+ * -------------------------------------------------------------------------- */
+
+static void log_point(const char *what, int sp, const double *v, double sc)
+{
+    char line[160];
+    int n = snprintf(line, sizeof(line), "autotune: %s score=%.3f", what, sc);
+    for (uint32_t i = 0; i < spaces[sp].n && n > 0 && (size_t)n < sizeof(line); ++i)
+        n += snprintf(line + n, sizeof(line) - n, " %g", v[i]);
+    dmesg_log(line);
+    printf("%s\n", line);
+}
+
+static int run(autotune_state_t *st)
+{
+    const Governor *g = governors_find_by_name(st->gov);
+    int sp = g ? find_space(g->name) : -1;
+    tune_dim_t dims[TUNE_SEARCH_MAX_DIMS];
+    if (sp < 0 || !build_dims(g, sp, dims) || st->search.ndims != spaces[sp].n) {
+        printf("autotune: no search space for %s\n", st->gov);
+        return -1;
+    }
+
+    const Governor *prev = governors_get_current();
+    uint32_t eval_ms = st->nbench * (st->bench_ms + AUTOTUNE_GAP_MS);
+    const char *why = "converged";
+    int rc = 0;
+    uint32_t unsaved = 0;                /* evaluations since the last save */
+    uint32_t pass_dim = st->search.dim;
+
+    printf("autotune: %s, %lu/%lu s used, press any key to pause\n", g->name,
+           (unsigned long)(st->elapsed_ms / 1000u), (unsigned long)(st->budget_ms / 1000u));
+
+    double cand[TUNE_SEARCH_MAX_DIMS];
+    while (tune_search_next(&st->search, dims, cand)) {
+        if (getchar_timeout_us(0) != PICO_ERROR_TIMEOUT) { why = "paused"; rc = 1; break; }
+        if (st->elapsed_ms + eval_ms > st->budget_ms)    { why = "budget spent"; break; }
+
+        /* Checkpoint so a reset, brownout or watchdog reboot costs at most
+         * one pass: whenever a pass over the dimensions has completed, and
+         * every AUTOTUNE_CHECKPOINT_EVALS evaluations within a long one. */
+        bool swept = st->search.dim < pass_dim;
+        pass_dim = st->search.dim;
+        if (unsaved && (swept || unsaved >= AUTOTUNE_CHECKPOINT_EVALS)) {
+            persist_save_autotune(st, sizeof(*st));
+            unsaved = 0;
+        }
+
+        const char *param = spaces[sp].dims[st->search.dim].param;
+        apply_point(g, sp, cand);
+        autotune_result_t r;
+        uint64_t t0 = time_us_64();
+        if (!evaluate(g, st, &r)) { why = "evaluation failed, paused"; rc = 1; break; }
+        st->elapsed_ms += (uint32_t)((time_us_64() - t0) / 1000u);
+
+        double sc = score(st, &r);
+        tune_search_report(&st->search, dims, sc);
+
+        char what[64];
+        snprintf(what, sizeof(what), "eval %lu %s %lu/%lus best=%.3f",
+                 (unsigned long)st->search.evals,
+                 param,
+                 (unsigned long)(st->elapsed_ms / 1000u),
+                 (unsigned long)(st->budget_ms / 1000u), st->search.best_score);
+        log_point(what, sp, cand, sc);
+        unsaved++;
+    }
+
+    /* At the end the winning tunables (and drop the checkpoint); on a
+     * pause the state, unless the last checkpoint already has it. */
+    apply_point(g, sp, st->search.best);
+    if (rc == 0) {
+        gov_tunables_save(g);
+        persist_clear_autotune();
+    } else if (unsaved) {
+        persist_save_autotune(st, sizeof(*st));
+    }
+    if (prev) governors_set_current_transient(prev);
+
+    char line[128];
+    snprintf(line, sizeof(line),
+             "autotune: %s after %lu evals, %lu moves, score %.3f -> %.3f%s",
+             why, (unsigned long)st->search.evals, (unsigned long)st->search.moves,
+             st->start_score, st->search.best_score,
+             rc == 0 ? " (saved)" : " (gov autotune resume)");
+    dmesg_log(line);
+    printf("%s\n", line);
+    return rc;
+}
+
+/* --------------------------------------------------------------------------
+ * API
+ * -------------------------------------------------------------------------- */
+
+static bool parse_mix(autotune_state_t *st, const char *mix)
+{
+    st->nbench = 0;
+    while (*mix) {
+        const char *end = strchr(mix, ',');
+        size_t len = end ? (size_t)(end - mix) : strlen(mix);
+        size_t i = 0;
+        while (i < BENCH_TARGETS &&
+               !(strlen(bench_targets[i]) == len && strncmp(bench_targets[i], mix, len) == 0))
+            ++i;
+        if (i == BENCH_TARGETS || st->nbench == AUTOTUNE_MAX_BENCH) {
+            printf("autotune: bad benchmark '%.*s'\n", (int)len, mix);
+            return false;
+        }
+        st->bench[st->nbench++] = (uint8_t)i;
+        if (!end) break;
+        mix = end + 1;
+    }
+    return st->nbench > 0;
+}
+
+int autotune_start(const char *gov, uint32_t budget_s, const char *mix,
+                   uint32_t bench_ms)
+{
+    const Governor *g = gov ? governors_find_by_name(gov) : NULL;
+    int sp = g ? find_space(g->name) : -1;
+    tune_dim_t dims[TUNE_SEARCH_MAX_DIMS];
+    if (sp < 0 || !build_dims(g, sp, dims)) {
+        printf("autotune: no search space for %s\n", gov ? gov : "(null)");
+        return -1;
+    }
+
+    autotune_state_t *st = &s_state;
+    memset(st, 0, sizeof(*st));
+    st->version = AUTOTUNE_VERSION;
+    strncpy(st->gov, g->name, sizeof(st->gov) - 1);
+    st->budget_ms = budget_s * 1000u;
+    st->bench_ms  = bench_ms ? bench_ms : AUTOTUNE_DEFAULT_BENCH_MS;
+    if (!parse_mix(st, mix ? mix : AUTOTUNE_DEFAULT_MIX)) return -1;
+
+    double start[TUNE_SEARCH_MAX_DIMS];
+    for (uint32_t i = 0; i < spaces[sp].n; ++i)
+        gov_tunable_get(g, spaces[sp].dims[i].param, &start[i]);
+
+    /* The starting set is the reference every candidate is scored against. */
+    const Governor *prev = governors_get_current();
+    autotune_result_t r;
+    uint64_t t0 = time_us_64();
+    bool ok = evaluate(g, st, &r);
+    if (prev) governors_set_current_transient(prev);
+    if (!ok) return -1;
+    st->elapsed_ms = (uint32_t)((time_us_64() - t0) / 1000u);
+    for (uint32_t b = 0; b < st->nbench; ++b) {
+        st->ref_value[b] = r.value[b];
+        st->ref_uj[b]    = r.uj[b];
+    }
+    st->start_score = score(st, &r);
+    tune_search_init(&st->search, dims, spaces[sp].n, start, st->start_score,
+                     AUTOTUNE_MIN_GAIN);
+    log_point("baseline", sp, start, st->start_score);
+
+    /* Replaces any older saved run straight away, and keeps the baseline. */
+    persist_save_autotune(st, sizeof(*st));
+    return run(st);
+}
+
+static bool load_state(autotune_state_t *st)
+{
+    return persist_load_autotune(st, sizeof(*st)) == (int)sizeof(*st) &&
+           st->version == AUTOTUNE_VERSION;
+}
+
+int autotune_resume(void)
+{
+    if (!load_state(&s_state)) {
+        printf("autotune: no saved run\n");
+        return -1;
+    }
+    return run(&s_state);
+}
+
+void autotune_status(void)
+{
+    autotune_state_t *st = &s_state;
+    if (!load_state(st)) {
+        printf("autotune: no saved run\n");
+        return;
+    }
+    printf("autotune: %s, %lu/%lu s used, %lu ms per benchmark, mix",
+           st->gov, (unsigned long)(st->elapsed_ms / 1000u),
+           (unsigned long)(st->budget_ms / 1000u), (unsigned long)st->bench_ms);
+    for (uint32_t b = 0; b < st->nbench && st->bench[b] < BENCH_TARGETS; ++b)
+        printf("%c%s", b ? ',' : ' ', bench_targets[st->bench[b]]);
+    printf("\n  evals %lu, moves %lu, score %.3f -> %.3f\n",
+           (unsigned long)st->search.evals, (unsigned long)st->search.moves,
+           st->start_score, st->search.best_score);
+
+    int sp = find_space(st->gov);
+    if (sp < 0 || st->search.ndims != spaces[sp].n) return;
+    for (uint32_t i = 0; i < spaces[sp].n; ++i)
+        printf("  %-22s: %g (step %g)%s\n", spaces[sp].dims[i].param,
+               st->search.best[i], st->search.step[i],
+               i == st->search.dim ? " <" : "");
+}
+
+int autotune_clear(void)
+{
+    return persist_clear_autotune();
+}
@@ -0,0 +1,72 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+/*
+ * autotune.h  –  on-device search for governor tunables
+ *
+ * autotune_start() (Core 0, blocks for the budget) scores parameter sets
+ * of a governor against a mix of bench_run_collect() workloads and walks
+ * them with coordinate descent (tune_search.h).  Every benchmark starts
+ * cold: the governor is suspended, clk_sys is parked at the policy
+ * minimum and the governor is re-initialised, so the run measures how
+ * fast it ramps as well as where it settles.  Per benchmark:
+ *
+ *   throughput  the benchmark's own metric, relative to the starting set
+ *   energy      energy_total_uj() over the run, relative to the starting set
+ *   ttm         time until clk_sys reached the policy maximum, as a
+ *               fraction of the run (the whole run if it never did)
+ *
+ *   score = mean(throughput) - W_ENERGY * (mean(energy) - 1) - W_TTM * mean(ttm)
+ *
+ * The starting set scores 1 - W_TTM * ttm.  Only the governor's
+ * responsiveness fields are searched; thermal limits are left alone.
+ *
+ * Flash is never written per benchmark: the benchmarks switch governors
+ * without persisting the selection.  The search state is checkpointed
+ * after the baseline, whenever a pass over the dimensions completes and
+ * at least every AUTOTUNE_CHECKPOINT_EVALS (autotune.c) evaluations, so
+ * a reset, brownout or watchdog reboot loses at most that much work.  A
+ * key press pauses the run between benchmarks and saves the state;
+ * autotune_resume() continues from the last save with the remaining
+ * budget.  When the search converges or the budget runs out the best set
+ * is applied and saved as the governor's tunables (gov_tunables_save())
+ * and the saved state is dropped.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUTOTUNE_DEFAULT_MIX       "cpu,memcpy,rand_access"
+#define AUTOTUNE_DEFAULT_BENCH_MS  1000u
+#define AUTOTUNE_MAX_BENCH         6u
+#define AUTOTUNE_W_ENERGY          0.5
+#define AUTOTUNE_W_TTM             0.5
+#define AUTOTUNE_MIN_GAIN          0.01     /* score noise floor */
+
+/**
+ * Tune governor `gov` for budget_s seconds of benchmarking.  mix is a
+ * comma-separated list of benchmark names (NULL = AUTOTUNE_DEFAULT_MIX),
+ * each run for bench_ms (0 = default).  Returns 0 when the search
+ * finished, 1 when paused, -1 on bad arguments or if the governor has no
+ * search space.  Replaces any saved run.
+ */
+int autotune_start(const char *gov, uint32_t budget_s, const char *mix,
+                   uint32_t bench_ms);
+
+/** Continue the run saved in flash.  Same returns; -1 if there is none. */
+int autotune_resume(void);
+
+/** Print the saved run, if any. */
+void autotune_status(void);
+
+/** Drop the saved run. */
+int autotune_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUTOTUNE_H */
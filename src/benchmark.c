@@ -4,10 +4,16 @@
 #include <stdint.h>
 #include "pico/stdlib.h"
 #include "pico/time.h"
+#include "pico/sync.h"
+#include "hardware/structs/systick.h"
 #include "benchmark.h"
 #include "dmesg.h"
 #include "governors.h"
 #include "metrics.h"
+#include "safepoint.h"
+#include "energy.h"
+#include "pio_idle.h"
+#include "seqlock.h"
 
 /* External declarations for live stats display during benchmarks */
 extern volatile bool live_stats;
@@ -41,6 +47,15 @@ void bench_list(void)
 
 /* External state accessors */
 extern volatile uint32_t current_khz;
+
+/* Benchmarks report their load under their own metrics source so they can
+ * be told apart from (or weighted against) application samples. */
+static metrics_source_t bench_source(void)
+{
+    static metrics_source_t src = -1;
+    if (src < 0) src = metrics_register_source("bench", METRICS_WEIGHT_DEFAULT);
+    return src;
+}
 extern float read_onboard_temperature(void);
 
 /* Measurement helpers return primary metric and seconds */
@@ -75,13 +90,14 @@ static void measure_cpu(uint32_t ms, uint64_t *out_iters, double *out_secs)
             double intensity = (double)iters_done / 5000000.0 * 100.0;
             if (intensity < 1.0) intensity = 1.0;
             if (intensity > 100.0) intensity = 100.0;
-            metrics_submit(100, (int)intensity, 100);
+            metrics_submit_src(bench_source(), 100, (int)intensity, 100);
             last_metric_us = now_us;
             last_progress_us = now_us;
             snprintf(log_buf, sizeof(log_buf), "bench:cpu @%ums iters=%llu intensity=%.0f%% freq=%uMHz", 
                 (unsigned)((now_us - start_us) / 1000), (unsigned long long)iter, intensity, current_khz/1000);
             dmesg_log(log_buf);
             sleep_us(100);  /* Yield briefly to allow Core 0 REPL to update stats */
+            safepoint_poll();  /* app-provided safe point for PLL changes */
         }
         /* Update stats display every 500ms to match main loop tickrate */
         if (live_stats && (now_us - last_stats_us >= 500000)) {
@@ -142,13 +158,14 @@ static void measure_memcpy(uint32_t ms, double *out_mb, double *out_secs)
             double intensity = bytes / (5.0 * 1024.0 * 1024.0) * 100.0;
             if (intensity < 1.0) intensity = 1.0;
             if (intensity > 100.0) intensity = 100.0;
-            metrics_submit(100, (int)intensity, 100);
+            metrics_submit_src(bench_source(), 100, (int)intensity, 100);
             last_metric_us = now_us;
             double mb_so_far = (double)(ops * BUF_SIZE) / (1024.0 * 1024.0);
             snprintf(log_buf, sizeof(log_buf), "bench:memcpy @%ums ops=%llu MB=%.2f intensity=%.0f%% freq=%uMHz", 
                 (unsigned)((now_us - start_us) / 1000), (unsigned long long)ops, mb_so_far, intensity, current_khz/1000);
             dmesg_log(log_buf);
             sleep_us(100);  /* Yield briefly to allow Core 0 REPL to update stats */
+            safepoint_poll();  /* app-provided safe point for PLL changes */
         }
         /* Update stats display every 500ms to match main loop tickrate */
         if (live_stats && (now_us - last_stats_us >= 500000)) {
@@ -203,13 +220,14 @@ static void measure_memset(uint32_t ms, double *out_mb, double *out_secs)
             double intensity = bytes / (5.0 * 1024.0 * 1024.0) * 100.0;
             if (intensity < 1.0) intensity = 1.0;
             if (intensity > 100.0) intensity = 100.0;
-            metrics_submit(100, (int)intensity, 100);
+            metrics_submit_src(bench_source(), 100, (int)intensity, 100);
             last_metric_us = now_us;
             double mb_so_far = (double)(ops * BUF_SIZE) / (1024.0 * 1024.0);
             snprintf(log_buf, sizeof(log_buf), "bench:memset @%ums ops=%llu MB=%.2f intensity=%.0f%% freq=%uMHz", 
                 (unsigned)((now_us - start_us) / 1000), (unsigned long long)ops, mb_so_far, intensity, current_khz/1000);
             dmesg_log(log_buf);
             sleep_us(100);  /* Yield briefly to allow Core 0 REPL to update stats */
+            safepoint_poll();  /* app-provided safe point for PLL changes */
         }
         /* Update stats display every 500ms to match main loop tickrate */
         if (live_stats && (now_us - last_stats_us >= 500000)) {
@@ -266,13 +284,14 @@ static void measure_mem_stream(uint32_t ms, double *out_mb, double *out_secs)
             double intensity = (double)bytes_done / (5.0 * 1024.0 * 1024.0) * 100.0;
             if (intensity < 1.0) intensity = 1.0;
             if (intensity > 100.0) intensity = 100.0;
-            metrics_submit(100, (int)intensity, 100);
+            metrics_submit_src(bench_source(), 100, (int)intensity, 100);
             last_metric_us = now_us;
             double mb_so_far = (double)bytes / (1024.0 * 1024.0);
             snprintf(log_buf, sizeof(log_buf), "bench:mem_stream @%ums passes=%llu MB=%.2f intensity=%.0f%% freq=%uMHz", 
                 (unsigned)((now_us - start_us) / 1000), (unsigned long long)(bytes / BUF_SIZE), mb_so_far, intensity, current_khz/1000);
             dmesg_log(log_buf);
             sleep_us(100);  /* Yield briefly to allow Core 0 REPL to update stats */
+            safepoint_poll();  /* app-provided safe point for PLL changes */
         }
         /* Update stats display every 500ms to match main loop tickrate */
         if (live_stats && (now_us - last_stats_us >= 500000)) {
@@ -342,13 +361,14 @@ static void measure_mem_stream_dma(uint32_t ms, double *out_mb, double *out_secs
             double intensity = (double)ops_done / 500.0 * 100.0; /* rough scale */
             if (intensity < 1.0) intensity = 1.0;
             if (intensity > 100.0) intensity = 100.0;
-            metrics_submit(100, (int)intensity, 100);
+            metrics_submit_src(bench_source(), 100, (int)intensity, 100);
             last_metric_us = now_us;
             double mb_so_far = (double)(ops * BUF_SIZE) / (1024.0 * 1024.0);
             snprintf(log_buf, sizeof(log_buf), "bench:mem_stream_dma @%ums ops=%llu MB=%.2f intensity=%.0f%% freq=%uMHz", 
                 (unsigned)((now_us - start_us) / 1000), (unsigned long long)ops, mb_so_far, intensity, current_khz/1000);
             dmesg_log(log_buf);
             sleep_us(100);  /* Yield briefly to allow Core 0 REPL to update stats */
+            safepoint_poll();  /* app-provided safe point for PLL changes */
         }
         /* Update stats display every 500ms to match main loop tickrate */
         if (live_stats && (now_us - last_stats_us >= 500000)) {
@@ -416,13 +436,14 @@ static void measure_rand_access(uint32_t ms, double *out_accesses_k, double *out
             double intensity = (double)acc_done / 500000.0 * 100.0; /* rough calibration */
             if (intensity < 1.0) intensity = 1.0;
             if (intensity > 100.0) intensity = 100.0;
-            metrics_submit(100, (int)intensity, 100);
+            metrics_submit_src(bench_source(), 100, (int)intensity, 100);
             last_metric_us = now_us;
             double kacc_so_far = (double)accesses / 1000.0;
             snprintf(log_buf, sizeof(log_buf), "bench:rand_access @%ums acc=%llu Kacc=%.1f intensity=%.0f%% freq=%uMHz", 
                 (unsigned)((now_us - start_us) / 1000), (unsigned long long)accesses, kacc_so_far, intensity, current_khz/1000);
             dmesg_log(log_buf);
             sleep_us(100);  /* Yield briefly to allow Core 0 REPL to update stats */
+            safepoint_poll();  /* app-provided safe point for PLL changes */
         }
         /* Update stats display every 500ms to match main loop tickrate */
         if (live_stats && (now_us - last_stats_us >= 500000)) {
@@ -444,49 +465,54 @@ static void measure_rand_access(uint32_t ms, double *out_accesses_k, double *out
     printf("%s\n", log_buf);
 }
 
+/* Append the energy columns shared by every CSV summary:
+ *   ,mJ,<estimated energy>,mW,<average power>,per_mJ,<value per mJ> */
+static void append_energy(char *out, size_t out_len, double value, double secs,
+                          uint64_t uj)
+{
+    size_t used = strlen(out);
+    if (used >= out_len) return;
+    double mj = (double)uj / 1000.0;
+    double mw = (secs > 0.0) ? mj / secs : 0.0;
+    double per_mj = (mj > 0.0) ? value / mj : 0.0;
+    snprintf(out + used, out_len - used, ",mJ,%.3f,mW,%.1f,per_mJ,%.3f",
+             mj, mw, per_mj);
+}
+
 /* Helper: run a single target and optionally produce a CSV summary */
 int bench_run_collect(const char *target, uint32_t ms, char *out, size_t out_len)
 {
-    char log_buf[128];
     if (!target) return -1;
-    
+    const char *gov = governors_get_current() ? governors_get_current()->name : "unknown";
+    uint64_t uj0 = energy_total_uj();
+    double value, secs;
+
     if (strcmp(target, "cpu") == 0) {
-        uint64_t iters; double secs;
+        uint64_t iters;
         measure_cpu(ms, &iters, &secs);
-        if (out) snprintf(out, out_len, "%s,cpu,iterations,%llu,sec,%.3f", governors_get_current() ? governors_get_current()->name : "unknown", (unsigned long long)iters, secs);
-        return 0;
+        value = (double)iters;
+        if (out) snprintf(out, out_len, "%s,cpu,iterations,%llu,sec,%.3f", gov, (unsigned long long)iters, secs);
+    } else if (strcmp(target, "memcpy") == 0) {
+        measure_memcpy(ms, &value, &secs);
+        if (out) snprintf(out, out_len, "%s,memcpy,MB,%.2f,sec,%.3f", gov, value, secs);
+    } else if (strcmp(target, "mem_stream_dma") == 0) {
+        measure_mem_stream_dma(ms, &value, &secs);
+        if (out) snprintf(out, out_len, "%s,mem_stream_dma,MB,%.2f,sec,%.3f", gov, value, secs);
+    } else if (strcmp(target, "memset") == 0) {
+        measure_memset(ms, &value, &secs);
+        if (out) snprintf(out, out_len, "%s,memset,MB,%.2f,sec,%.3f", gov, value, secs);
+    } else if (strcmp(target, "mem_stream") == 0) {
+        measure_mem_stream(ms, &value, &secs);
+        if (out) snprintf(out, out_len, "%s,mem_stream,MB,%.2f,sec,%.3f", gov, value, secs);
+    } else if (strcmp(target, "rand_access") == 0) {
+        measure_rand_access(ms, &value, &secs);
+        if (out) snprintf(out, out_len, "%s,rand_access,Kaccess,%.0f,sec,%.3f", gov, value, secs);
+    } else {
+        return -1;
     }
-    if (strcmp(target, "memcpy") == 0) {
-        double mb, secs;
-        measure_memcpy(ms, &mb, &secs);
-        if (out) snprintf(out, out_len, "%s,memcpy,MB,%.2f,sec,%.3f", governors_get_current() ? governors_get_current()->name : "unknown", mb, secs);
-        return 0;
-    }
-    if (strcmp(target, "mem_stream_dma") == 0) {
-        double mb, secs;
-        measure_mem_stream_dma(ms, &mb, &secs);
-        if (out) snprintf(out, out_len, "%s,mem_stream_dma,MB,%.2f,sec,%.3f", governors_get_current() ? governors_get_current()->name : "unknown", mb, secs);
-        return 0;
-    }
-    if (strcmp(target, "memset") == 0) {
-        double mb, secs;
-        measure_memset(ms, &mb, &secs);
-        if (out) snprintf(out, out_len, "%s,memset,MB,%.2f,sec,%.3f", governors_get_current() ? governors_get_current()->name : "unknown", mb, secs);
-        return 0;
-    }
-    if (strcmp(target, "mem_stream") == 0) {
-        double mb, secs;
-        measure_mem_stream(ms, &mb, &secs);
-        if (out) snprintf(out, out_len, "%s,mem_stream,MB,%.2f,sec,%.3f", governors_get_current() ? governors_get_current()->name : "unknown", mb, secs);
-        return 0;
-    }
-    if (strcmp(target, "rand_access") == 0) {
-        double kacc, secs;
-        measure_rand_access(ms, &kacc, &secs);
-        if (out) snprintf(out, out_len, "%s,rand_access,Kaccess,%.0f,sec,%.3f", governors_get_current() ? governors_get_current()->name : "unknown", kacc, secs);
-        return 0;
-    }
-    return -1;
+
+    if (out) append_energy(out, out_len, value, secs, energy_total_uj() - uj0);
+    return 0;
 }
 
 
@@ -536,12 +562,21 @@ void bench_suite(uint32_t ms_per_test, int csv)
         governors_set_current(g);
         /* allow governor to settle */
         sleep_ms(250);
+
+        /* Per-governor energy over the benchmark runs only (not the gaps). */
+        uint64_t gov_uj = 0;
+        uint64_t gov_us = 0;
         
         for (size_t t = 0; t < tcount; ++t) {
             char out[256];
-            if (bench_run_collect(targets[t], ms_per_test, out, sizeof(out)) == 0) {
+            uint64_t uj0 = energy_total_uj();
+            uint64_t us0 = time_us_64();
+            int rc = bench_run_collect(targets[t], ms_per_test, out, sizeof(out));
+            gov_uj += energy_total_uj() - uj0;
+            gov_us += time_us_64() - us0;
+            if (rc == 0) {
                 if (csv) {
-                    /* CSV: governor,benchmark,metric,value,unit,sec,secs */
+                    /* CSV: governor,benchmark,metric,value,sec,secs,mJ,mj,mW,mw,per_mJ,v */
                     printf("%s\n", out);
                 } else {
                     printf("%s\n", out);
@@ -549,6 +584,12 @@ void bench_suite(uint32_t ms_per_test, int csv)
             }
             sleep_ms(20);
         }
+
+        double gov_mj   = (double)gov_uj / 1000.0;
+        double gov_secs = (double)gov_us / 1e6;
+        /* CSV: governor,TOTAL,mJ,<mJ>,sec,<s>,mW,<avg mW> */
+        printf("%s,TOTAL,mJ,%.3f,sec,%.3f,mW,%.1f\n", g->name, gov_mj, gov_secs,
+               gov_secs > 0.0 ? gov_mj / gov_secs : 0.0);
         
         snprintf(log_buf, sizeof(log_buf), "--- Governor %s: all benchmarks complete", g->name);
         dmesg_log(log_buf);
@@ -559,3 +600,235 @@ void bench_suite(uint32_t ms_per_test, int csv)
     dmesg_log(log_buf);
     printf("%s\n", log_buf);
 }
+
+/* --------------------------------------------------------------------------
+ * Metrics path microbenchmark
+ *
+ * ref_* is the metrics implementation this tree used before the lock-free
+ * rings: one mutex around a 128-record ring, aggregate walks every record.
+ * -------------------------------------------------------------------------- */
+
+#define REF_METRICS_SZ 128
+
+static struct {
+    uint32_t workload, intensity, duration_ms, ts_ms;
+} ref_buf[REF_METRICS_SZ];
+static uint32_t ref_head, ref_tail, ref_cnt;
+static mutex_t  ref_lock;
+
+static void ref_submit(uint32_t workload, uint32_t intensity, uint32_t duration_ms)
+{
+    uint32_t ts = to_ms_since_boot(get_absolute_time());
+    mutex_enter_blocking(&ref_lock);
+    ref_buf[ref_head].workload = workload;
+    ref_buf[ref_head].intensity = intensity;
+    ref_buf[ref_head].duration_ms = duration_ms;
+    ref_buf[ref_head].ts_ms = ts;
+    ref_head = (ref_head + 1) & (REF_METRICS_SZ - 1);
+    if (ref_cnt < REF_METRICS_SZ) ref_cnt++; else ref_tail = ref_head;
+    mutex_exit(&ref_lock);
+}
+
+static uint32_t ref_aggregate(metrics_agg_t *out)
+{
+    uint64_t sum_work = 0, sum_int = 0, sum_dur = 0;
+    uint32_t last_ts = 0, n = 0;
+    mutex_enter_blocking(&ref_lock);
+    uint32_t i = ref_tail;
+    for (; n < ref_cnt; ++n) {
+        sum_work += ref_buf[i].workload;
+        sum_int  += ref_buf[i].intensity;
+        sum_dur  += ref_buf[i].duration_ms;
+        last_ts   = ref_buf[i].ts_ms;
+        i = (i + 1) & (REF_METRICS_SZ - 1);
+    }
+    mutex_exit(&ref_lock);
+    out->count = n;
+    out->avg_workload    = n ? (double)sum_work / n : 0.0;
+    out->avg_intensity   = n ? (double)sum_int / n : 0.0;
+    out->avg_duration_ms = n ? (double)sum_dur / n : 0.0;
+    out->last_ts_ms      = last_ts;
+    return n;
+}
+
+static double ns_per_op(uint64_t t0, uint64_t t1, uint32_t n)
+{
+    return n ? (double)(t1 - t0) * 1000.0 / (double)n : 0.0;
+}
+
+void bench_metrics(uint32_t iterations)
+{
+    if (iterations == 0) iterations = 1;
+    static bool ref_inited = false;
+    if (!ref_inited) {
+        mutex_init(&ref_lock);
+        ref_inited = true;
+    }
+    metrics_init();
+    metrics_agg_t agg;
+    /* Weight 0: the synthetic samples never reach the governor. */
+    metrics_source_t src = metrics_register_source("bench_metrics", 0);
+
+    printf("[bench:metrics] %u iterations @ %u MHz\n", iterations, current_khz / 1000);
+
+    uint64_t t0 = time_us_64();
+    for (uint32_t i = 0; i < iterations; ++i) ref_submit(i, 1, 1);
+    uint64_t t1 = time_us_64();
+    for (uint32_t i = 0; i < iterations; ++i) metrics_submit_src(src, i, 1, 1);
+    uint64_t t2 = time_us_64();
+    double ref_sub = ns_per_op(t0, t1, iterations);
+    double lf_sub  = ns_per_op(t1, t2, iterations);
+
+    /* Aggregate with a full reference ring (the old per-tick worst case). */
+    uint32_t agg_n = iterations / 10u ? iterations / 10u : 1u;
+    t0 = time_us_64();
+    for (uint32_t i = 0; i < agg_n; ++i) ref_aggregate(&agg);
+    t1 = time_us_64();
+    for (uint32_t i = 0; i < agg_n; ++i) metrics_get_aggregate(&agg, 0);
+    t2 = time_us_64();
+    double ref_agg = ns_per_op(t0, t1, agg_n);
+    double lf_agg  = ns_per_op(t1, t2, agg_n);
+
+    printf("  submit    : mutex %8.0f ns  lock-free %8.0f ns  (%.1fx)\n",
+           ref_sub, lf_sub, lf_sub > 0.0 ? ref_sub / lf_sub : 0.0);
+    printf("  aggregate : mutex %8.0f ns  lock-free %8.0f ns  (%.1fx, %u records vs %u rings)\n",
+           ref_agg, lf_agg, lf_agg > 0.0 ? ref_agg / lf_agg : 0.0,
+           ref_cnt, METRICS_RINGS);
+
+    char log_buf[128];
+    snprintf(log_buf, sizeof(log_buf),
+             "[bench:metrics] submit %.0f->%.0f ns, aggregate %.0f->%.0f ns",
+             ref_sub, lf_sub, ref_agg, lf_agg);
+    dmesg_log(log_buf);
+}
+
+/* --------------------------------------------------------------------------
+ * Seqlock microbenchmark + stress
+ *
+ * Cycle counts come from SysTick running on the processor clock (24-bit,
+ * so operations are timed in short batches).  The mutex / critical_section
+ * columns copy the same structures the way this tree did before the
+ * snapshots moved to seqlock.h.
+ * -------------------------------------------------------------------------- */
+
+#define SEQ_BATCH 16u
+
+static inline void cyc_start(void)
+{
+    systick_hw->rvr = 0x00FFFFFFu;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+static inline uint32_t cyc_now(void)
+{
+    return systick_hw->cvr;             /* counts down */
+}
+
+static inline uint32_t cyc_since(uint32_t start)
+{
+    return (start - cyc_now()) & 0x00FFFFFFu;
+}
+
+/* Stress object: every word equals the writer's counter, so any torn copy
+ * has two different words. */
+#define SEQ_STRESS_WORDS 16u
+
+static struct {
+    uint32_t w[SEQ_STRESS_WORDS];
+} seq_obj;
+static seqlock_t         seq_obj_lock = SEQLOCK_INIT;
+static volatile uint32_t seq_obj_writes;
+
+static bool seq_stress_writer(repeating_timer_t *t)
+{
+    (void)t;
+    uint32_t v = seq_obj_writes + 1u;
+    seqlock_write_begin(&seq_obj_lock);
+    for (uint32_t i = 0; i < SEQ_STRESS_WORDS; ++i) seq_obj.w[i] = v;
+    seqlock_write_end(&seq_obj_lock);
+    seq_obj_writes = v;
+    return true;
+}
+
+void bench_seqlock(uint32_t iterations)
+{
+    if (iterations < SEQ_BATCH) iterations = SEQ_BATCH;
+    uint32_t batches = iterations / SEQ_BATCH;
+
+    static kernel_metrics_t ref_snap, out_snap;
+    static pio_idle_stats_t ref_pio, out_pio;
+    static mutex_t          ref_mutex;
+    static critical_section_t ref_cs;
+    static bool ref_inited = false;
+    if (!ref_inited) {
+        mutex_init(&ref_mutex);
+        critical_section_init(&ref_cs);
+        ref_inited = true;
+    }
+
+    printf("[bench:seqlock] %u reads @ %u MHz (cycles/read, SysTick)\n",
+           batches * SEQ_BATCH, current_khz / 1000);
+    cyc_start();
+
+    uint64_t c_seq = 0, c_mtx = 0, c_pseq = 0, c_pcs = 0;
+    for (uint32_t b = 0; b < batches; ++b) {
+        uint32_t t = cyc_now();
+        for (uint32_t i = 0; i < SEQ_BATCH; ++i) metrics_get_kernel_snapshot(&out_snap);
+        c_seq += cyc_since(t);
+
+        t = cyc_now();
+        for (uint32_t i = 0; i < SEQ_BATCH; ++i) {
+            mutex_enter_blocking(&ref_mutex);
+            memcpy(&out_snap, &ref_snap, sizeof(out_snap));
+            mutex_exit(&ref_mutex);
+        }
+        c_mtx += cyc_since(t);
+
+        t = cyc_now();
+        for (uint32_t i = 0; i < SEQ_BATCH; ++i) pio_idle_get_stats(&out_pio);
+        c_pseq += cyc_since(t);
+
+        t = cyc_now();
+        for (uint32_t i = 0; i < SEQ_BATCH; ++i) {
+            critical_section_enter_blocking(&ref_cs);
+            out_pio = ref_pio;
+            critical_section_exit(&ref_cs);
+        }
+        c_pcs += cyc_since(t);
+    }
+    uint32_t n = batches * SEQ_BATCH;
+    printf("  kernel_metrics_t (%u B): seqlock %5u  mutex %5u\n",
+           (unsigned)sizeof(kernel_metrics_t),
+           (unsigned)(c_seq / n), (unsigned)(c_mtx / n));
+    printf("  pio_idle_stats_t (%u B): seqlock %5u  critical_section %5u (IRQs masked)\n",
+           (unsigned)sizeof(pio_idle_stats_t),
+           (unsigned)(c_pseq / n), (unsigned)(c_pcs / n));
+
+    /* Stress: a 20 us timer IRQ rewrites the object while this thread
+     * reads it; every accepted copy must be internally consistent. */
+    repeating_timer_t rt;
+    seq_obj_writes = 0;
+    if (!add_repeating_timer_us(-20, seq_stress_writer, NULL, &rt)) {
+        printf("  stress: no timer available\n");
+        return;
+    }
+    uint32_t torn = 0, retries = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t copy[SEQ_STRESS_WORDS];
+        retries += seqlock_read(&seq_obj_lock, copy, &seq_obj, sizeof(copy));
+        for (uint32_t k = 1; k < SEQ_STRESS_WORDS; ++k) {
+            if (copy[k] != copy[0]) { torn++; break; }
+        }
+    }
+    cancel_repeating_timer(&rt);
+    printf("  stress: %u reads vs %u IRQ writes: %u retries, %u torn%s\n",
+           n, seq_obj_writes, retries, torn, torn ? "  ** FAIL **" : "");
+
+    char log_buf[128];
+    snprintf(log_buf, sizeof(log_buf),
+             "[bench:seqlock] kmetrics %u vs %u cyc, pio %u vs %u cyc, torn=%u",
+             (unsigned)(c_seq / n), (unsigned)(c_mtx / n),
+             (unsigned)(c_pseq / n), (unsigned)(c_pcs / n), torn);
+    dmesg_log(log_buf);
+}
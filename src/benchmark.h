@@ -14,6 +14,17 @@ int bench_run(const char *target, uint32_t ms);
  */
 void bench_suite(uint32_t ms_per_test, int csv);
 
+/* Microbenchmark metrics_submit()/metrics_get_aggregate() against the
+ * previous mutex + 128-record ring implementation (kept here as reference).
+ * Its samples go to the weight-0 "bench_metrics" source, so governors do
+ * not see them. */
+void bench_metrics(uint32_t iterations);
+
+/* Cycles per snapshot read: seqlock vs the previous mutex / critical_section
+ * copies of kernel_metrics_t and pio_idle_stats_t, then a stress run with a
+ * timer IRQ writer against a reading thread (reports torn copies; must be 0). */
+void bench_seqlock(uint32_t iterations);
+
 /* Run a benchmark but return a CSV summary in out (if not NULL). */
 int bench_run_collect(const char *target, uint32_t ms, char *out, size_t out_len);
 
@@ -14,9 +14,20 @@
 #include "benchmark.h"
 #include "metrics.h"
 #include "uart_log.h"
-#include "governors_rp2040_perf.h"
+#include "gov_tunable.h"
 #include "persist.h"
 #include "pio_idle.h"
+#include "ramp_stats.h"
+#include "safepoint.h"
+#include "vreg_cal.h"
+#include "temp_service.h"
+#include "freq_stats.h"
+#include "energy.h"
+#include "freq_boost.h"
+#include "freq_policy.h"
+#include "pll_table.h"
+#include "trace.h"
+#include "autotune.h"
 
 /* Safe MMIO address range for peek/poke. */
 #define SAFE_ADDR_MIN      0x10000000UL
@@ -24,7 +35,12 @@
 
 static void cmd_set(const char *args)
 {
-    if (!args || !*args) { printf("Usage: set <mhz>\n"); return; }
+    if (!args || !*args) { printf("Usage: set <mhz>|auto\n"); return; }
+    if (strncmp(args, "auto", 4) == 0) {
+        freq_policy_clear(FREQ_POLICY_USER);
+        printf("User limit cleared; governor selects the frequency\n");
+        return;
+    }
     uint32_t mhz = (uint32_t)atoi(args);
     uint32_t khz = mhz * 1000;
 
@@ -32,11 +48,22 @@ static void cmd_set(const char *args)
         printf("Out of range (%u - %u MHz)\n", MIN_KHZ / 1000, MAX_KHZ / 1000);
         return;
     }
-    if (throttle_active) {
-        printf("Warning: thermal throttle active. Target stored but may be overridden.\n");
-    }
+    /* Pin scaling_min = scaling_max so governors cannot move it, on a
+     * frequency the PLL can actually make. */
+    const pll_entry_t *e = pll_table_nearest(khz);
+    if (e) khz = e->khz;
+    freq_policy_set(FREQ_POLICY_USER, khz, khz);
     target_khz = khz;
-    printf("Target set to %u MHz\n", mhz);
+    freq_policy_t p;
+    freq_policy_get(&p);
+    if (p.max_src != FREQ_POLICY_USER)
+        printf("Warning: %s limit (%u MHz) binds; pin applies once it lifts.\n",
+               freq_policy_src_name(p.max_src), p.max_khz / 1000);
+    if (khz != mhz * 1000u)
+        printf("%u MHz is not a PLL frequency; nearest is %u.%03u MHz\n",
+               mhz, khz / 1000u, khz % 1000u);
+    printf("Target pinned to %u.%03u MHz ('set auto' to release)\n",
+           khz / 1000u, khz % 1000u);
 }
 
 static void cmd_peek(const char *args)
@@ -124,34 +151,147 @@ static void cmd_stats(const char *args)
 
 static void cmd_temp(const char *args)
 {
-    (void)args;
-    printf("Core Temperature : %.1f °C\n", read_onboard_temperature());
+    char buf[32] = "";
+    if (args) {
+        strncpy(buf, args, sizeof(buf)-1);
+        buf[sizeof(buf)-1] = '\0';
+    }
+    char *sub = strtok(buf, " ");
+    if (sub && strcmp(sub, "horizon") == 0) {
+        char *v = strtok(NULL, " ");
+        if (v) temp_service_set_horizon_ms((uint32_t)atoi(v));
+        printf("Prediction horizon: %u ms\n", temp_service_get_horizon_ms());
+        return;
+    }
+
+    temp_reading_t tr;
+    temp_service_read(&tr);
+    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+    printf("Core Temperature : %.1f °C (filtered, %u ms old)\n",
+           tr.celsius, now_ms - tr.ts_ms);
+    printf("Slope            : %+.3f °C/s\n", tr.slope_c_per_s);
+    printf("Predicted        : %.1f °C in %u ms\n", tr.predicted_c,
+           temp_service_get_horizon_ms());
     printf("Vreg             : %s\n", voltage_label(current_voltage_mv));
     printf("Throttle active  : %s\n", throttle_active ? "YES" : "no");
 }
 
+static void print_metric_sources(void)
+{
+    uint32_t n = metrics_source_count();
+    printf("Sources (lifetime):\n");
+    printf("  %-15s %6s %8s %8s %9s %9s\n",
+           "name", "weight", "samples", "avg int", "avg dur", "last ms");
+    for (uint32_t s = 0; s < n; ++s) {
+        metrics_source_info_t si;
+        if (metrics_get_source_info((metrics_source_t)s, &si) != 0) continue;
+        printf("  %-15s %6u %8u %8.1f %9.1f %9u%s\n",
+               si.name, si.weight, si.samples, si.avg_intensity,
+               si.avg_duration_ms, si.last_ts_ms,
+               si.weight ? "" : "  (ignored)");
+    }
+}
+
 static void cmd_metrics(const char *args)
 {
-    (void)args;
+    char abuf[48] = "";
+    if (args) {
+        strncpy(abuf, args, sizeof(abuf)-1);
+        abuf[sizeof(abuf)-1] = '\0';
+    }
+    char *sub = strtok(abuf, " ");
+    if (sub && strcmp(sub, "wake") == 0) {
+        char *v = strtok(NULL, " ");
+        if (v) {
+            uint32_t thr = (strcmp(v, "off") == 0) ? 0u : (uint32_t)atoi(v);
+            if (thr > 100) {
+                printf("Usage: metrics wake [<1-100>|off]\n");
+                return;
+            }
+            metrics_set_wake_threshold(thr);
+        }
+        uint32_t thr = metrics_get_wake_threshold();
+        if (thr) printf("Wake threshold: intensity >= %u\n", thr);
+        else     printf("Wake threshold: off (governors wake on their own pacing)\n");
+        return;
+    }
+    if (sub && strcmp(sub, "weight") == 0) {
+        char *name = strtok(NULL, " ");
+        char *v    = strtok(NULL, " ");
+        metrics_source_t src = name ? metrics_find_source(name) : -1;
+        if (!v || src < 0 || atoi(v) < 0 || (uint32_t)atoi(v) > METRICS_WEIGHT_MAX) {
+            if (name && src < 0) printf("Unknown source: %s\n", name);
+            printf("Usage: metrics weight <source> <0-%u>  (0 = ignore)\n",
+                   METRICS_WEIGHT_MAX);
+            return;
+        }
+        metrics_set_source_weight(src, (uint32_t)atoi(v));
+        print_metric_sources();
+        return;
+    }
+
     metrics_init();
     metrics_agg_t agg;
     uint32_t n = metrics_get_aggregate(&agg, 0);
     if (n == 0) {
-        printf("No metrics samples available\n");
-        return;
+        printf("No metrics samples since the last governor tick\n");
+    } else {
+        printf("Metrics samples: %u\n", n);
+        printf("  avg workload : %.2f\n", agg.avg_workload);
+        printf("  avg intensity: %.2f\n", agg.avg_intensity);
+        printf("  avg duration : %.2f ms\n", agg.avg_duration_ms);
+        printf("  last sample at: %u ms since boot\n", agg.last_ts_ms);
+    }
+    if (agg.iowait)
+        printf("I/O-wait flags since the last governor tick: %u\n", agg.iowait);
+
+    metrics_stats_t st;
+    if (metrics_get_stats(&st)) {
+        printf("Windows (decaying; intensity %% | duration ms):\n");
+        printf("  %-6s %8s %7s %4s %4s %4s | %8s %6s %6s %6s\n",
+               "win", "rate/s", "avg", "p50", "p95", "max",
+               "avg", "p50", "p95", "max");
+        for (uint32_t w = 0; w < METRICS_WINDOWS; ++w) {
+            const metrics_window_stats_t *ws = &st.win[w];
+            char label[8];
+            if (ws->horizon_ms >= 1000u)
+                snprintf(label, sizeof(label), "%us", (unsigned)(ws->horizon_ms / 1000u));
+            else
+                snprintf(label, sizeof(label), "%ums", (unsigned)ws->horizon_ms);
+            printf("  %-6s %8.1f %7.1f %4u %4u %4u | %8.1f %6u %6u %6u\n",
+                   label, ws->rate_hz, ws->avg_intensity,
+                   ws->p50_intensity, ws->p95_intensity, ws->max_intensity,
+                   ws->avg_duration_ms, ws->p50_duration_ms,
+                   ws->p95_duration_ms, ws->max_duration_ms);
+        }
     }
-    printf("Metrics samples: %u\n", n);
-    printf("  avg workload : %.2f\n", agg.avg_workload);
-    printf("  avg intensity: %.2f\n", agg.avg_intensity);
-    printf("  avg duration : %.2f ms\n", agg.avg_duration_ms);
-    printf("  last sample at: %u ms since boot\n", agg.last_ts_ms);
+
+    print_metric_sources();
 
     kernel_metrics_t ks;
     if (metrics_get_kernel_snapshot(&ks)) {
         printf("Kernel snapshot:\n");
         printf("  gov tick count : %u\n", ks.gov_tick_count);
-        printf("  gov tick avg   : %.3f ms\n", ks.gov_tick_avg_ms);
+        printf("  gov tick avg   : %.3f ms (execution; sampling %u ms, tickless %s, %u idle sleeps)\n",
+               ks.gov_tick_avg_ms, ks.gov_sampling_ms, ks.tickless ? "on" : "off",
+               ks.tickless_sleeps);
         printf("  last at        : %u ms since boot\n", ks.last_ts_ms);
+        printf("  transitions    : %u (last %u us, avg %u us, max %u us)\n",
+               ks.ramp_transitions, ks.ramp_last_latency_us,
+               ks.ramp_avg_latency_us, ks.ramp_max_latency_us);
+        printf("  pll steps      : %u (core0 stall avg %u us, max %u us; pll max %u us)\n",
+               ks.ramp_steps, ks.ramp_stall_avg_us, ks.ramp_stall_max_us,
+               ks.ramp_pll_max_us);
+        printf("  safe-point     : %u cooperative (parked avg %u us, max %u us), %u forced\n",
+               ks.sp_handshakes, ks.sp_stall_avg_us, ks.sp_stall_max_us,
+               ks.sp_forced);
+        printf("  wakeups        : %u (submit->decision last %u us, avg %u us, max %u us)\n",
+               ks.wake_count, ks.wake_last_latency_us,
+               ks.wake_avg_latency_us, ks.wake_max_latency_us);
+        printf("  freq changes   : %u (time-in-state: freqstat)\n", ks.freq_trans_total);
+        printf("  boosts         : %u (%u active, floor %u kHz, %u ms boosted)\n",
+               ks.boost_requests, ks.boost_active, ks.boost_floor_khz,
+               ks.boost_time_ms);
     } else {
         printf("No kernel snapshot available\n");
     }
@@ -184,6 +324,13 @@ static void cmd_persist(const char *args)
     } else {
         printf("rp2040_perf parameters: not found\n");
     }
+
+    vreg_table_t vt;
+    if (persist_load_vreg_table(&vt, sizeof(vt)) > 0 && vt.valid) {
+        printf("VREG table: calibrated (margin %u mV)\n", vt.margin_mv);
+    } else {
+        printf("VREG table: not found\n");
+    }
 }
 
 static void cmd_uptime(const char *args)
@@ -238,16 +385,16 @@ static void cmd_reboot(const char *args)
 static void cmd_gov(const char *args)
 {
     if (!args || !*args) {
-        printf("Usage: gov <list|set <name>|status>\n");
+        printf("Usage: gov <list|set <name>|status|tune|tickless|autotune>\n");
         return;
     }
 
-    char buf[64];
+    char buf[128];
     strncpy(buf, args, sizeof(buf)-1);
     buf[sizeof(buf)-1] = '\0';
 
     char *cmd = strtok(buf, " ");
-    if (!cmd) { printf("Usage: gov <list|set <name>|status>\n"); return; }
+    if (!cmd) { printf("Usage: gov <list|set <name>|status|tune|tickless|autotune>\n"); return; }
 
     if (strcmp(cmd, "list") == 0) {
         size_t n = governors_count();
@@ -278,40 +425,72 @@ static void cmd_gov(const char *args)
         return;
     }
 
+    if (strcmp(cmd, "tickless") == 0) {
+        char *arg = strtok(NULL, " ");
+        if (arg && strcmp(arg, "on") == 0)       governors_set_tickless(true);
+        else if (arg && strcmp(arg, "off") == 0) governors_set_tickless(false);
+        else if (arg) { printf("Usage: gov tickless [on|off]\n"); return; }
+        printf("Tickless: %s (idle sleep up to %u ms)\n",
+               governors_tickless() ? "on" : "off", GOV_TICKLESS_MAX_MS);
+        return;
+    }
+
     if (strcmp(cmd, "tune") == 0) {
         char *name = strtok(NULL, " ");
-        if (!name) { printf("Usage: gov tune <name> <show|get|set> [param] [value]\n"); return; }
-        if (strcmp(name, "rp2040_perf") == 0) {
-            char *sub = strtok(NULL, " ");
-            if (!sub) { printf("Usage: gov tune rp2040_perf <show|get|set> [param] [value]\n"); return; }
-            if (strcmp(sub, "show") == 0) { rp2040_perf_print_params(); return; }
-            if (strcmp(sub, "get") == 0) {
-                char *param = strtok(NULL, " ");
-                if (!param) { printf("Usage: gov tune rp2040_perf get <param>\n"); return; }
-                double v; if (rp2040_perf_get_param(param, &v) == 0) printf("%s = %.3f\n", param, v);
-                else printf("Unknown param: %s\n", param);
-                return;
-            }
-            if (strcmp(sub, "set") == 0) {
-                char *param = strtok(NULL, " ");
-                char *val_s = strtok(NULL, " ");
-                if (!param || !val_s) { printf("Usage: gov tune rp2040_perf set <param> <value>\n"); return; }
-                double v = atof(val_s);
-                int rc = rp2040_perf_set_param(param, v);
-                if (rc == 0) printf("Set %s = %.3f\n", param, v);
-                else if (rc == -2) printf("Invalid value for %s: %s\n", param, val_s);
-                else printf("Unknown param: %s\n", param);
-                return;
+        if (!name) { printf("Usage: gov tune <name> <show|list|get|set> [param] [value]\n"); return; }
+        const Governor *g = governors_find_by_name(name);
+        if (!g) { printf("Unknown governor: %s\n", name); return; }
+        if (!g->tunables) { printf("%s has no tunable parameters\n", g->name); return; }
+        char *sub = strtok(NULL, " ");
+        if (!sub) { printf("Usage: gov tune %s <show|list|get|set> [param] [value]\n", g->name); return; }
+        if (strcmp(sub, "show") == 0) { gov_tunables_print(g); return; }
+        if (strcmp(sub, "list") == 0) { gov_tunables_list(g); return; }
+        if (strcmp(sub, "get") == 0) {
+            char *param = strtok(NULL, " ");
+            if (!param) { printf("Usage: gov tune %s get <param>\n", g->name); return; }
+            double v; if (gov_tunable_get(g, param, &v) == 0) printf("%s = %.3f\n", param, v);
+            else printf("Unknown param: %s\n", param);
+            return;
+        }
+        if (strcmp(sub, "set") == 0) {
+            char *param = strtok(NULL, " ");
+            char *val_s = strtok(NULL, " ");
+            if (!param || !val_s) { printf("Usage: gov tune %s set <param> <value>\n", g->name); return; }
+            double v = atof(val_s);
+            int rc = gov_tunable_set(g, param, v);
+            if (rc == 0) printf("Set %s = %.3f\n", param, v);
+            else if (rc == -2) {
+                const gov_tunable_t *d = gov_tunable_find(g->tunables, param);
+                printf("Invalid value for %s: %s (range %g..%g)\n", param, val_s, d->min, d->max);
             }
-            if (strcmp(sub, "list") == 0) { rp2040_perf_list_params(); return; }
-            printf("Unknown subcommand. Use show/get/set.\n");
+            else printf("Unknown param: %s\n", param);
             return;
         }
-        printf("Unknown governor: %s\n", name);
+        printf("Unknown subcommand. Use show/list/get/set.\n");
         return;
     }
 
-    printf("Unknown gov command. Use list/set/status.\n");
+    if (strcmp(cmd, "autotune") == 0) {
+        char *name = strtok(NULL, " ");
+        if (name && strcmp(name, "resume") == 0) { autotune_resume(); return; }
+        if (name && strcmp(name, "status") == 0) { autotune_status(); return; }
+        if (name && strcmp(name, "clear") == 0) {
+            printf(autotune_clear() == 0 ? "Saved autotune run dropped\n" : "Clear failed\n");
+            return;
+        }
+        char *budget_s = strtok(NULL, " ");
+        if (!name || !budget_s || atoi(budget_s) <= 0) {
+            printf("Usage: gov autotune <name> <budget_s> [bench,...] [ms] | resume | status | clear\n");
+            return;
+        }
+        char *mix = strtok(NULL, " ");
+        char *ms_s = strtok(NULL, " ");
+        autotune_start(name, (uint32_t)atoi(budget_s), mix,
+                       ms_s ? (uint32_t)atoi(ms_s) : 0);
+        return;
+    }
+
+    printf("Unknown gov command. Use list/set/status/tune/tickless/autotune.\n");
 }
 
 /* =========================================================================
@@ -468,6 +647,480 @@ static void cmd_pio(const char *args)
            "  pio watch [ms [n]] Poll stats every <ms> ms, <n> times\n");
 }
 
+/* =========================================================================
+ * Ramp command group
+ *
+ *   ramp                   – show mode, bypass source and transition latency
+ *   ramp mode <step|direct>
+ *   ramp bypass <usb|xosc>
+ *   ramp stats [reset]     – per-phase timing histograms (direction, VREG)
+ *   ramp handshake <on|off|timeout <us>>
+ * ========================================================================= */
+
+static void ramp_print_hist_row(const char *label, const ramp_hist_t *h)
+{
+    if (h->count == 0) {
+        printf("    %-10s %7u\n", label, 0u);
+        return;
+    }
+    printf("    %-10s %7u %7u %7u %7u %7u\n", label, h->count,
+           (uint32_t)(h->total_us / h->count),
+           ramp_hist_percentile(h, 50), ramp_hist_percentile(h, 95),
+           h->max_us);
+}
+
+static void ramp_print_stats(void)
+{
+    static ramp_stats_t snap;          /* ~6 KB: off the stack */
+    const ramp_stats_t *rs = &snap;
+    ramp_stats_snapshot(&snap);
+    static const char *const dir_names[RAMP_DIR_COUNT] = { "up", "down" };
+
+    printf("Ramp phase timing: %u steps (us)\n", rs->steps);
+    for (uint32_t d = 0; d < RAMP_DIR_COUNT; ++d) {
+        printf("  %-12s %7s %7s %7s %7s %7s\n",
+               dir_names[d], "count", "avg", "p50", "p95", "max");
+        for (uint32_t p = 0; p < RAMP_PHASE_COUNT; ++p) {
+            if (p == RAMP_PHASE_VREG_PRE  && d != RAMP_DIR_UP)   continue;
+            if (p == RAMP_PHASE_VREG_POST && d != RAMP_DIR_DOWN) continue;
+            ramp_print_hist_row(ramp_phase_name((ramp_phase_t)p), &rs->by_dir[d][p]);
+        }
+    }
+
+    printf("  Core 0 stall histogram        up    down\n");
+    const ramp_hist_t *su = &rs->by_dir[RAMP_DIR_UP][RAMP_PHASE_STALL];
+    const ramp_hist_t *sd = &rs->by_dir[RAMP_DIR_DOWN][RAMP_PHASE_STALL];
+    for (uint32_t b = 0; b < RAMP_HIST_BUCKETS; ++b) {
+        if (!su->buckets[b] && !sd->buckets[b]) continue;
+        if (b + 1u < RAMP_HIST_BUCKETS)
+            printf("    [%6u, %6u) us  %7u %7u\n", ramp_hist_bucket_floor(b),
+                   ramp_hist_bucket_floor(b + 1u), su->buckets[b], sd->buckets[b]);
+        else
+            printf("    [%6u,    inf) us  %7u %7u\n", ramp_hist_bucket_floor(b),
+                   su->buckets[b], sd->buckets[b]);
+    }
+
+    printf("  by VREG level %7s %7s %7s %7s %7s   (stall | pll)\n",
+           "count", "avg", "p50", "p95", "max");
+    for (uint32_t v = 0; v < RAMP_VLEVELS; ++v) {
+        const ramp_hist_t *hs = &rs->by_vlevel[v][RAMP_PHASE_STALL];
+        if (hs->count == 0) continue;
+        char label[16];
+        uint32_t mv = RAMP_VLEVEL_MIN_MV + v * RAMP_VLEVEL_STEP_MV;
+        snprintf(label, sizeof(label), "%u.%02uV", mv / 1000u, (mv % 1000u) / 10u);
+        printf("  %s\n", label);
+        ramp_print_hist_row("stall", hs);
+        ramp_print_hist_row("pll", &rs->by_vlevel[v][RAMP_PHASE_PLL]);
+    }
+}
+
+static void cmd_ramp(const char *args)
+{
+    char buf[64] = "";
+    if (args) {
+        strncpy(buf, args, sizeof(buf)-1);
+        buf[sizeof(buf)-1] = '\0';
+    }
+    char *sub = strtok(buf, " ");
+
+    if (!sub) {
+        ramp_latency_t lat;
+        ramp_get_latency(&lat);
+        printf("Ramp:\n");
+        printf("  mode           : %s\n", ramp_mode_name(ramp_get_mode()));
+        printf("  bypass source  : %s\n", ramp_bypass_name(ramp_get_bypass()));
+        printf("  handshake      : %s (timeout %u us)\n",
+               safepoint_enabled() ? "on" : "off", safepoint_get_timeout_us());
+        printf("  transitions    : %u\n", lat.transitions);
+        if (lat.transitions) {
+            printf("  last           : %u us (%u -> %u kHz)\n",
+                   lat.last_us, lat.last_from_khz, lat.last_to_khz);
+            printf("  avg            : %u us\n",
+                   (uint32_t)(lat.total_us / lat.transitions));
+            printf("  max            : %u us\n", lat.max_us);
+        }
+        safepoint_stats_t sp;
+        safepoint_get_stats(&sp);
+        if (sp.handshakes || sp.forced) {
+            printf("  safe-point     : %u cooperative, %u forced\n",
+                   sp.handshakes, sp.forced);
+            if (sp.handshakes) {
+                printf("  core0 parked   : last %u us, avg %u us, max %u us\n",
+                       sp.stall_last_us,
+                       (uint32_t)(sp.stall_total_us / sp.handshakes),
+                       sp.stall_max_us);
+                printf("  ack wait       : avg %u us, max %u us\n",
+                       (uint32_t)(sp.ack_wait_total_us / sp.handshakes),
+                       sp.ack_wait_max_us);
+            }
+        }
+        return;
+    }
+
+    char *opt = strtok(NULL, " ");
+    if (strcmp(sub, "stats") == 0) {
+        if (opt && strcmp(opt, "reset") == 0) {
+            ramp_stats_reset();
+            safepoint_reset_stats();
+            printf("Ramp phase statistics cleared\n");
+            return;
+        }
+        ramp_print_stats();
+        return;
+    }
+    if (strcmp(sub, "mode") == 0) {
+        if (opt && strcmp(opt, "step") == 0)        ramp_set_mode(RAMP_MODE_STEP);
+        else if (opt && strcmp(opt, "direct") == 0) ramp_set_mode(RAMP_MODE_DIRECT);
+        else { printf("Usage: ramp mode <step|direct>\n"); return; }
+        printf("Ramp mode: %s\n", ramp_mode_name(ramp_get_mode()));
+        return;
+    }
+    if (strcmp(sub, "handshake") == 0) {
+        if (opt && strcmp(opt, "on") == 0)       safepoint_set_enabled(true);
+        else if (opt && strcmp(opt, "off") == 0) safepoint_set_enabled(false);
+        else if (opt && strcmp(opt, "timeout") == 0) {
+            char *us_s = strtok(NULL, " ");
+            int us = us_s ? atoi(us_s) : 0;
+            if (us <= 0) { printf("Usage: ramp handshake timeout <us>\n"); return; }
+            safepoint_set_timeout_us((uint32_t)us);
+        }
+        else { printf("Usage: ramp handshake <on|off|timeout <us>>\n"); return; }
+        printf("Safe-point handshake: %s (timeout %u us)\n",
+               safepoint_enabled() ? "on" : "off", safepoint_get_timeout_us());
+        return;
+    }
+    if (strcmp(sub, "bypass") == 0) {
+        if (opt && strcmp(opt, "usb") == 0)       ramp_set_bypass(RAMP_BYPASS_PLL_USB);
+        else if (opt && strcmp(opt, "xosc") == 0) ramp_set_bypass(RAMP_BYPASS_XOSC);
+        else { printf("Usage: ramp bypass <usb|xosc>\n"); return; }
+        printf("Ramp bypass source: %s\n", ramp_bypass_name(ramp_get_bypass()));
+        return;
+    }
+
+    printf("Usage:\n"
+           "  ramp                     Show ramp mode and transition latency\n"
+           "  ramp mode <step|direct>  Stepped or single-hop transitions\n"
+           "  ramp bypass <usb|xosc>   Temporary clk_sys source during relock\n"
+           "  ramp stats [reset]       Per-phase timing histograms\n"
+           "  ramp handshake <on|off>  Park Core 0 at safe points instead of forced lockout\n"
+           "  ramp handshake timeout <us>\n");
+}
+
+static void vreg_print_table(void)
+{
+    const vreg_table_t *t = vreg_cal_table();
+    printf("VREG table: %s", t->valid ? "calibrated" : "stock");
+    if (t->valid) printf(" (margin %u mV)", t->margin_mv);
+    printf("\n  %-17s %-16s %s\n", "band (MHz)", "stock", "active");
+    for (uint32_t b = 0; b < VREG_TABLE_BANDS; ++b) {
+        uint32_t hi = vreg_table_band_top_khz(b);
+        uint32_t lo = (b == 0) ? MIN_KHZ : vreg_table_band_top_khz(b - 1u);
+        char range[24];
+        snprintf(range, sizeof(range), "%3u - %3u", lo / 1000u, hi / 1000u);
+        printf("  %-17s %-16s %s\n", range,
+               voltage_label(vreg_default_mv(hi)),
+               voltage_label(vreg_mv_for_khz(hi)));
+    }
+}
+
+static void cmd_vreg(const char *args)
+{
+    char buf[64] = "";
+    if (args) {
+        strncpy(buf, args, sizeof(buf)-1);
+        buf[sizeof(buf)-1] = '\0';
+    }
+    char *sub = strtok(buf, " ");
+
+    if (!sub) {
+        printf("Vreg now : %s @ %.2f MHz\n", voltage_label(current_voltage_mv),
+               current_khz / 1000.0f);
+        vreg_print_table();
+        return;
+    }
+
+    if (strcmp(sub, "cal") == 0) {
+        char *m = strtok(NULL, " ");
+        uint32_t margin = m ? (uint32_t)atoi(m) : VREG_CAL_DEFAULT_MARGIN_MV;
+        if (margin % VREG_TABLE_STEP_MV) {
+            printf("Margin must be a multiple of %u mV\n", VREG_TABLE_STEP_MV);
+            return;
+        }
+        printf("Calibrating (governor suspended; a hang means power-cycle)...\n");
+        if (vreg_cal_run(margin) > 0) vreg_print_table();
+        return;
+    }
+
+    if (strcmp(sub, "reset") == 0) {
+        int rc = vreg_cal_clear();
+        if (rc == 0) printf("VREG table cleared; stock voltages\n");
+        else if (rc > 0) printf("VREG table cleared (flash update failed)\n");
+        return;
+    }
+
+    printf("Usage: vreg [cal [margin_mv]|reset]\n");
+}
+
+static void freqstat_print_csv(const freq_stats_t *fs)
+{
+    printf("bucket_lo_khz,bucket_hi_khz,residency_ms\n");
+    for (uint32_t b = 0; b < FREQ_STATS_BUCKETS; ++b) {
+        printf("%u,%u,%llu\n", freq_stats_bucket_lo_khz(b),
+               freq_stats_bucket_lo_khz(b + 1u),
+               (unsigned long long)(fs->residency_us[b] / 1000u));
+    }
+    printf("\nfrom_khz\\to_khz");
+    for (uint32_t t = 0; t < FREQ_STATS_BUCKETS; ++t)
+        printf(",%u", freq_stats_bucket_lo_khz(t));
+    printf("\n");
+    for (uint32_t f = 0; f < FREQ_STATS_BUCKETS; ++f) {
+        printf("%u", freq_stats_bucket_lo_khz(f));
+        for (uint32_t t = 0; t < FREQ_STATS_BUCKETS; ++t)
+            printf(",%u", fs->trans[f][t]);
+        printf("\n");
+    }
+}
+
+static void cmd_freqstat(const char *args)
+{
+    char buf[32] = "";
+    if (args) {
+        strncpy(buf, args, sizeof(buf)-1);
+        buf[sizeof(buf)-1] = '\0';
+    }
+    char *sub = strtok(buf, " ");
+
+    if (sub && strcmp(sub, "reset") == 0) {
+        freq_stats_reset();
+        printf("Frequency stats reset\n");
+        return;
+    }
+
+    freq_stats_t fs;
+    freq_stats_snapshot(&fs);
+
+    if (sub && strcmp(sub, "csv") == 0) {
+        freqstat_print_csv(&fs);
+        return;
+    }
+    if (sub) {
+        printf("Usage: freqstat [reset|csv]\n");
+        return;
+    }
+
+    uint64_t total_us = 0;
+    for (uint32_t b = 0; b < FREQ_STATS_BUCKETS; ++b) total_us += fs.residency_us[b];
+    printf("Time in state (%.1f s since reset, governor %s):\n",
+           (double)total_us / 1e6,
+           governors_get_current() ? governors_get_current()->name : "none");
+    for (uint32_t b = 0; b < FREQ_STATS_BUCKETS; ++b) {
+        double pct = total_us ? 100.0 * (double)fs.residency_us[b] / (double)total_us : 0.0;
+        printf("  %3u-%3u MHz %c %10.1f s  %5.1f %%\n",
+               freq_stats_bucket_lo_khz(b) / 1000u,
+               freq_stats_bucket_lo_khz(b + 1u) / 1000u,
+               (b == fs.cur_bucket) ? '*' : ' ',
+               (double)fs.residency_us[b] / 1e6, pct);
+    }
+
+    printf("Transitions: %u (rows = from, cols = to, MHz)\n", fs.trans_total);
+    printf("     ");
+    for (uint32_t t = 0; t < FREQ_STATS_BUCKETS; ++t)
+        printf("%5u", freq_stats_bucket_lo_khz(t) / 1000u);
+    printf("\n");
+    for (uint32_t f = 0; f < FREQ_STATS_BUCKETS; ++f) {
+        printf("%5u", freq_stats_bucket_lo_khz(f) / 1000u);
+        for (uint32_t t = 0; t < FREQ_STATS_BUCKETS; ++t)
+            printf("%5u", fs.trans[f][t]);
+        printf("\n");
+    }
+}
+
+static void print_policy(void)
+{
+    freq_policy_t p;
+    freq_policy_get(&p);
+    printf("%-8s %10s %10s\n", "source", "min MHz", "max MHz");
+    for (uint32_t i = 0; i < FREQ_POLICY_SOURCES; ++i) {
+        uint32_t lo, hi;
+        freq_policy_get_constraint((freq_policy_src_t)i, &lo, &hi);
+        char lo_s[12] = "-", hi_s[12] = "-";
+        if (lo) snprintf(lo_s, sizeof(lo_s), "%.2f", lo / 1000.0f);
+        if (hi) snprintf(hi_s, sizeof(hi_s), "%.2f", hi / 1000.0f);
+        printf("%-8s %10s %10s\n", freq_policy_src_name((freq_policy_src_t)i), lo_s, hi_s);
+    }
+    printf("scaling_min_khz: %u (bound by %s)\n", p.min_khz, freq_policy_src_name(p.min_src));
+    printf("scaling_max_khz: %u (bound by %s)\n", p.max_khz, freq_policy_src_name(p.max_src));
+    printf("target %.2f MHz, clock %.2f MHz\n", target_khz / 1000.0f, current_khz / 1000.0f);
+}
+
+static void cmd_policy(const char *args)
+{
+    char abuf[32] = "";
+    if (args) {
+        strncpy(abuf, args, sizeof(abuf) - 1);
+        abuf[sizeof(abuf) - 1] = '\0';
+    }
+    char *tok = strtok(abuf, " ");
+    if (tok) {
+        uint32_t lo, hi;
+        freq_policy_get_constraint(FREQ_POLICY_USER, &lo, &hi);
+        char *v = strtok(NULL, " ");
+        uint32_t khz = v ? (uint32_t)atoi(v) * 1000u : 0u;
+        bool in_range = (khz >= MIN_KHZ && khz <= MAX_KHZ);
+        if (strcmp(tok, "reset") == 0) {
+            lo = hi = 0;
+        } else if (strcmp(tok, "min") == 0 && in_range) {
+            lo = khz;
+            if (hi && hi < lo) hi = lo;
+        } else if (strcmp(tok, "max") == 0 && in_range) {
+            hi = khz;
+            if (lo > hi) lo = hi;
+        } else {
+            printf("Usage: policy [min <mhz>|max <mhz>|reset]  (%u - %u MHz)\n",
+                   MIN_KHZ / 1000, MAX_KHZ / 1000);
+            return;
+        }
+        freq_policy_set(FREQ_POLICY_USER, lo, hi);
+    }
+    print_policy();
+}
+
+static void cmd_boost(const char *args)
+{
+    static int shell_handle = -1;       /* last boost taken from the shell */
+    char abuf[32] = "";
+    if (args) {
+        strncpy(abuf, args, sizeof(abuf) - 1);
+        abuf[sizeof(abuf) - 1] = '\0';
+    }
+    char *tok = strtok(abuf, " ");
+
+    if (tok && strcmp(tok, "release") == 0) {
+        freq_boost_release(shell_handle);
+        shell_handle = -1;
+    } else if (tok) {
+        char *ms_s = strtok(NULL, " ");
+        int mhz = atoi(tok);
+        int ms  = ms_s ? atoi(ms_s) : 0;
+        if (mhz <= 0 || ms <= 0) {
+            printf("Usage: boost [<mhz> <ms>|release]\n");
+            return;
+        }
+        int h = freq_boost_request((uint32_t)mhz * 1000u, (uint32_t)ms);
+        if (h < 0) {
+            printf("boost: no free slot (%u in use)\n", FREQ_BOOST_SLOTS);
+            return;
+        }
+        shell_handle = h;
+    }
+
+    freq_boost_stats_t bs;
+    freq_boost_get_stats(&bs);
+    if (bs.floor_khz)
+        printf("Boost floor : %.2f MHz (%u active)\n", bs.floor_khz / 1000.0f, bs.active);
+    else
+        printf("Boost floor : none\n");
+    printf("Requests    : %u granted, %u rejected, %u expired\n",
+           bs.requests, bs.rejected, bs.expired);
+    printf("Boosted for : %.3f s total\n", bs.boosted_us / 1e6);
+    printf("Clock       : %.2f MHz (governor target %.2f MHz)\n",
+           current_khz / 1000.0f, target_khz / 1000.0f);
+}
+
+static void cmd_energy(const char *args)
+{
+    char buf[96] = "";
+    if (args) {
+        strncpy(buf, args, sizeof(buf)-1);
+        buf[sizeof(buf)-1] = '\0';
+    }
+    char *sub = strtok(buf, " ");
+    energy_coeffs_t c;
+    energy_get_coeffs(&c);
+
+    if (!sub) {
+        double mj   = (double)energy_total_uj() / 1000.0;
+        double secs = (double)energy_window_us() / 1e6;
+        printf("Energy model: P = %.4f*V^2*f[MHz] + %.4f*V  (mW)\n", c.k_dyn, c.k_static);
+        printf("  now        : %.1f mW @ %.2f MHz, %s\n",
+               energy_power_mw(current_khz, current_voltage_mv),
+               current_khz / 1000.0f, voltage_label(current_voltage_mv));
+        printf("  since reset: %.3f mJ over %.1f s (avg %.1f mW)\n",
+               mj, secs, secs > 0.0 ? mj / secs : 0.0);
+        return;
+    }
+
+    if (strcmp(sub, "reset") == 0) {
+        energy_reset();
+        printf("Energy counter reset\n");
+        return;
+    }
+
+    if (strcmp(sub, "coeff") == 0) {
+        char *a = strtok(NULL, " ");
+        char *b = strtok(NULL, " ");
+        if (!a || !b) { printf("Usage: energy coeff <k_dyn> <k_static>\n"); return; }
+        c.k_dyn    = strtof(a, NULL);
+        c.k_static = strtof(b, NULL);
+        if (energy_set_coeffs(&c) != 0) printf("Coefficients rejected or not persisted\n");
+        else printf("Coefficients set: k_dyn=%.4f k_static=%.4f\n", c.k_dyn, c.k_static);
+        return;
+    }
+
+    if (strcmp(sub, "fit") == 0) {
+        char *v[6];
+        for (int k = 0; k < 6; ++k) v[k] = strtok(NULL, " ");
+        if (!v[5]) {
+            printf("Usage: energy fit <mhz1> <mv1> <mw1> <mhz2> <mv2> <mw2>\n");
+            return;
+        }
+        energy_coeffs_t fit;
+        if (!energy_fit((uint32_t)atoi(v[0]) * 1000u, (uint32_t)atoi(v[1]), strtof(v[2], NULL),
+                        (uint32_t)atoi(v[3]) * 1000u, (uint32_t)atoi(v[4]), strtof(v[5], NULL),
+                        &fit)) {
+            printf("Points do not determine the model (same V/f ratio or negative fit)\n");
+            return;
+        }
+        if (energy_set_coeffs(&fit) != 0) printf("Fit computed but not persisted\n");
+        printf("Fitted: k_dyn=%.4f k_static=%.4f\n", fit.k_dyn, fit.k_static);
+        return;
+    }
+
+    printf("Usage: energy [reset|coeff <k_dyn> <k_static>|fit <mhz1> <mv1> <mw1> <mhz2> <mv2> <mw2>]\n");
+}
+
+static void cmd_trace(const char *args)
+{
+    char buf[32] = "";
+    if (args) {
+        strncpy(buf, args, sizeof(buf)-1);
+        buf[sizeof(buf)-1] = '\0';
+    }
+    char *sub = strtok(buf, " ");
+
+    if (sub && strcmp(sub, "start") == 0) {
+        trace_start();
+        printf("Recording governor inputs (%u records max)\n", TRACE_MAX_RECORDS);
+        return;
+    }
+    if (sub && strcmp(sub, "stop") == 0) {
+        trace_stop();
+    } else if (sub && strcmp(sub, "dump") == 0) {
+        trace_stop();
+        trace_dump_csv();
+        return;
+    } else if (sub) {
+        printf("Usage: trace [start|stop|dump]\n");
+        return;
+    }
+
+    uint32_t n = trace_count();
+    const trace_rec_t *last = n ? trace_get(n - 1u) : NULL;
+    printf("Trace: %s, %u/%u records, %.1f s\n",
+           trace_active() ? "recording" : "stopped", n, TRACE_MAX_RECORDS,
+           last ? last->ts_ms / 1000.0f : 0.0f);
+}
+
 static void cmd_help(const char *args); /* forward decl */
 
 typedef struct {
@@ -504,6 +1157,18 @@ static void cmd_bench(const char *args)
         if (bench_run("cpu", ms) == 0) return;
     }
 
+    if (strcmp(tok, "seqlock") == 0) {
+        char *n_s = strtok(NULL, " ");
+        bench_seqlock(n_s ? (uint32_t)atoi(n_s) : 4096u);
+        return;
+    }
+
+    if (strcmp(tok, "metrics") == 0) {
+        char *n_s = strtok(NULL, " ");
+        bench_metrics(n_s ? (uint32_t)atoi(n_s) : 10000u);
+        return;
+    }
+
     if (strcmp(tok, "suite") == 0) {
         char *dur_s = strtok(NULL, " ");
         uint32_t ms = 1000;
@@ -525,22 +1190,29 @@ static void cmd_bench(const char *args)
 }
 
 static const Command commands[] = {
-    { "set",     cmd_set,     "set <mhz>",                    "Set target frequency (125-264 MHz)"            },
+    { "set",     cmd_set,     "set <mhz>|auto",               "Pin frequency (125-264 MHz) / release the pin" },
+    { "policy",  cmd_policy,  "policy [min|max <mhz>|reset]", "Scaling limits and which source binds them"    },
     { "peek",    cmd_peek,    "peek <hex>",                   "Read 32-bit MMIO register"                     },
     { "poke",    cmd_poke,    "poke <hex> <hex>",             "Write 32-bit value to MMIO register"           },
     { "clocks",  cmd_clocks,  "clocks",                       "Dump all PLL/clock divider frequencies"        },
     { "flash",   cmd_flash,   "flash",                        "Show flash size and firmware usage"            },
     { "stats",   cmd_stats,   "stats",                        "Toggle live clock/temp display"                },
-    { "temp",    cmd_temp,    "temp",                         "Read core temperature and vreg state"          },
+    { "temp",    cmd_temp,    "temp [horizon <ms>]",          "Filtered/predicted temperature and vreg state" },
     { "uptime",  cmd_uptime,  "uptime",                       "Show system uptime"                            },
     { "dmesg",   cmd_dmesg,   "dmesg",                        "Print system log"                              },
     { "bootsel", cmd_bootsel, "bootsel",                      "Reboot into UF2 flash mode"                    },
     { "reboot",  cmd_reboot,  "reboot",                       "Restart system"                               },
-    { "metrics", cmd_metrics, "metrics",                      "Show aggregated app-submitted metrics"         },
+    { "metrics", cmd_metrics, "metrics [wake|weight ...]",    "App metrics, wake threshold, source weights"   },
     { "persist", cmd_persist, "persist",                      "Show persisted governor and rp_params status"  },
     { "pio",     cmd_pio,     "pio [stats|safe|reset|watch]", "PIO idle/jitter subsystem commands"            },
+    { "ramp",    cmd_ramp,    "ramp [mode|bypass|stats]",     "Frequency transition mode, latency, timing"    },
+    { "vreg",    cmd_vreg,    "vreg [cal [margin_mv]|reset]", "Per-band VREG table and undervolt calibration" },
+    { "freqstat", cmd_freqstat, "freqstat [reset|csv]",       "Time-in-state and transition table per 10 MHz" },
+    { "boost",   cmd_boost,   "boost [<mhz> <ms>|release]",   "Time-bounded frequency floor (app boost)"      },
+    { "energy",  cmd_energy,  "energy [reset|coeff|fit]",     "Estimated power/energy and model calibration"  },
+    { "trace",   cmd_trace,   "trace [start|stop|dump]",      "Record governor inputs as CSV for sim/govsim"  },
     { "help",    cmd_help,    "help",                         "Show this help"                                },
-    { "gov",     cmd_gov,     "gov <list|set|status>",        "Governor controls (list/set/status)"           },
+    { "gov",     cmd_gov,     "gov <list|set|tune|autotune|..>", "Governors, tunables, tickless, auto-tuning"  },
     { "clear",   cmd_clear,   "clear",                        "Clear the screen"                              },
     { "bench",   cmd_bench,   "bench <target> <ms>",          "Run benchmark on specified target"             },
 };
@@ -0,0 +1,128 @@
+/*
+ * energy.c  –  estimated core energy from clk_sys and VREG state
+ */
+
+#include "energy.h"
+#include "system.h"
+#include "persist.h"
+#include "dmesg.h"
+#include "pico/stdlib.h"
+#include "pico/sync.h"
+#include <string.h>
+#include <math.h>
+
+static energy_coeffs_t    s_coeffs = { ENERGY_DEFAULT_K_DYN, ENERGY_DEFAULT_K_STATIC };
+static critical_section_t s_cs;
+static bool               s_inited = false;
+
+/* Running interval: operating point in force since s_last_us. */
+static uint64_t s_acc_nj  = 0;           /* mW * µs = nJ */
+static uint64_t s_reset_us = 0;
+static uint64_t s_last_us = 0;
+static uint32_t s_last_khz = 0;
+static uint32_t s_last_mv  = 0;
+
+float energy_power_mw(uint32_t khz, uint32_t mv)
+{
+    float v = (float)mv / 1000.0f;
+    float f = (float)khz / 1000.0f;
+    return s_coeffs.k_dyn * v * v * f + s_coeffs.k_static * v;
+}
+
+/* Energy of the open interval up to `now`; caller holds s_cs. */
+static uint64_t open_interval_nj(uint64_t now)
+{
+    float mw = energy_power_mw(s_last_khz, s_last_mv);
+    return (uint64_t)(mw * (float)(now - s_last_us));
+}
+
+void energy_init(void)
+{
+    if (s_inited) return;
+    critical_section_init(&s_cs);
+
+    energy_coeffs_t c;
+    if (persist_load_energy_coeffs(&c, sizeof(c)) == (int)sizeof(c) &&
+        c.k_dyn >= 0.0f && c.k_static >= 0.0f) {
+        s_coeffs = c;
+        dmesg_log("energy: loaded calibrated coefficients");
+    }
+
+    s_last_us  = time_us_64();
+    s_reset_us = s_last_us;
+    s_last_khz = current_khz;
+    s_last_mv  = current_voltage_mv;
+    s_inited = true;
+}
+
+void energy_update(void)
+{
+    if (!s_inited) return;
+    uint64_t now = time_us_64();
+    critical_section_enter_blocking(&s_cs);
+    s_acc_nj  += open_interval_nj(now);
+    s_last_us  = now;
+    s_last_khz = current_khz;
+    s_last_mv  = current_voltage_mv;
+    critical_section_exit(&s_cs);
+}
+
+uint64_t energy_total_uj(void)
+{
+    if (!s_inited) return 0;
+    uint64_t now = time_us_64();
+    critical_section_enter_blocking(&s_cs);
+    uint64_t nj = s_acc_nj + open_interval_nj(now);
+    critical_section_exit(&s_cs);
+    return nj / 1000u;
+}
+
+void energy_reset(void)
+{
+    if (!s_inited) return;
+    critical_section_enter_blocking(&s_cs);
+    s_acc_nj   = 0;
+    s_last_us  = time_us_64();
+    s_reset_us = s_last_us;
+    critical_section_exit(&s_cs);
+}
+
+uint64_t energy_window_us(void)
+{
+    return s_inited ? time_us_64() - s_reset_us : 0;
+}
+
+void energy_get_coeffs(energy_coeffs_t *out)
+{
+    if (out) *out = s_coeffs;
+}
+
+int energy_set_coeffs(const energy_coeffs_t *c)
+{
+    if (!c || c->k_dyn < 0.0f || c->k_static < 0.0f) return -1;
+    /* Charge the time so far at the old coefficients. */
+    energy_update();
+    s_coeffs = *c;
+    return persist_save_energy_coeffs(c, sizeof(*c));
+}
+
+bool energy_fit(uint32_t khz1, uint32_t mv1, float mw1,
+                uint32_t khz2, uint32_t mv2, float mw2,
+                energy_coeffs_t *out)
+{
+    /* P = k_dyn * x + k_static * y, x = V^2 f, y = V */
+    float v1 = (float)mv1 / 1000.0f, v2 = (float)mv2 / 1000.0f;
+    float x1 = v1 * v1 * ((float)khz1 / 1000.0f);
+    float x2 = v2 * v2 * ((float)khz2 / 1000.0f);
+    float det = x1 * v2 - x2 * v1;
+    if (fabsf(det) < 1e-3f) return false;
+
+    float k_dyn    = (mw1 * v2 - mw2 * v1) / det;
+    float k_static = (x1 * mw2 - x2 * mw1) / det;
+    if (k_dyn < 0.0f || k_static < 0.0f) return false;
+    if (out) {
+        out->k_dyn    = k_dyn;
+        out->k_static = k_static;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef ENERGY_H
+#define ENERGY_H
+
+/*
+ * energy.h  –  estimated core energy from clk_sys and VREG state
+ *
+ * Power model (DVDD core domain):
+ *
+ *   P[mW] = k_dyn * V^2 * f + k_static * V
+ *
+ *   V = current_voltage_mv / 1000, f = current_khz / 1000 (MHz)
+ *   k_dyn    [mW / (V^2 * MHz)]  switched capacitance term
+ *   k_static [mW / V] (= mA)     leakage + always-on current
+ *
+ * The estimate is integrated piecewise: every clock or voltage change
+ * closes the running interval at the old operating point (energy_update()
+ * is called from ramp_step() and vreg_apply_mv()).  Readers fold in the
+ * open interval, so energy_total_uj() is exact to the model at any time.
+ *
+ * The defaults are datasheet-order estimates.  Measure board power at two
+ * operating points and use energy_fit() (shell: "energy fit") to calibrate;
+ * the coefficients persist across reboots.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENERGY_DEFAULT_K_DYN     0.15f   /* ~0.18 mW/MHz at 1.10 V */
+#define ENERGY_DEFAULT_K_STATIC  1.0f    /* ~1 mA */
+
+typedef struct {
+    float k_dyn;
+    float k_static;
+} energy_coeffs_t;
+
+/** Load persisted coefficients and start integrating.  Core 0, at boot. */
+void energy_init(void);
+
+/** Close the running interval at the previous operating point. */
+void energy_update(void);
+
+/** Model power at an operating point. */
+float energy_power_mw(uint32_t khz, uint32_t mv);
+
+/** Energy since boot or the last energy_reset(), in µJ. */
+uint64_t energy_total_uj(void);
+void     energy_reset(void);
+
+/** Time covered by energy_total_uj(), in µs. */
+uint64_t energy_window_us(void);
+
+void energy_get_coeffs(energy_coeffs_t *out);
+/** Set and persist.  Returns 0 on success. */
+int  energy_set_coeffs(const energy_coeffs_t *c);
+
+/**
+ * Solve the model for two measured operating points.  Returns false if
+ * the points do not determine both coefficients (or give negative ones).
+ */
+bool energy_fit(uint32_t khz1, uint32_t mv1, float mw1,
+                uint32_t khz2, uint32_t mv2, float mw2,
+                energy_coeffs_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENERGY_H */
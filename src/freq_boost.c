@@ -0,0 +1,143 @@
+/*
+ * freq_boost.c  –  time-bounded frequency floor for latency-critical bursts
+ */
+
+#include "freq_boost.h"
+#include "system.h"
+#include "pico/stdlib.h"
+#include "pico/sync.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t min_khz;
+    uint64_t expires_us;
+    uint8_t  gen;           /* bumped on reuse so stale handles miss */
+    bool     used;
+} boost_slot_t;
+
+static boost_slot_t       s_slots[FREQ_BOOST_SLOTS];
+static freq_boost_stats_t s_stats;
+static uint64_t           s_boost_since_us;   /* floor went non-zero */
+static volatile bool      s_pending = false;
+static critical_section_t s_cs;
+static volatile bool      s_inited  = false;
+
+void freq_boost_init(void)
+{
+    if (s_inited) return;
+    critical_section_init(&s_cs);
+    memset(s_slots, 0, sizeof(s_slots));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_inited = true;
+}
+
+/* Recompute floor/active from the slots.  Caller holds s_cs. */
+static void boost_refresh_locked(uint64_t now)
+{
+    uint32_t floor = 0, active = 0;
+    for (uint32_t i = 0; i < FREQ_BOOST_SLOTS; ++i) {
+        boost_slot_t *s = &s_slots[i];
+        if (!s->used) continue;
+        if (now >= s->expires_us) {
+            s->used = false;
+            s_stats.expired++;
+            continue;
+        }
+        active++;
+        if (s->min_khz > floor) floor = s->min_khz;
+    }
+
+    if (floor && !s_stats.floor_khz)
+        s_boost_since_us = now;
+    else if (!floor && s_stats.floor_khz)
+        s_stats.boosted_us += now - s_boost_since_us;
+    s_stats.floor_khz = floor;
+    s_stats.active    = active;
+}
+
+int freq_boost_request(uint32_t min_khz, uint32_t duration_ms)
+{
+    if (duration_ms == 0 || !s_inited) return -1;
+    if (min_khz < MIN_KHZ) min_khz = MIN_KHZ;
+    if (min_khz > MAX_KHZ) min_khz = MAX_KHZ;
+    if (duration_ms > FREQ_BOOST_MAX_MS) duration_ms = FREQ_BOOST_MAX_MS;
+
+    uint64_t now = time_us_64();
+    int handle = -1;
+
+    critical_section_enter_blocking(&s_cs);
+    for (uint32_t i = 0; i < FREQ_BOOST_SLOTS; ++i) {
+        boost_slot_t *s = &s_slots[i];
+        if (s->used && now < s->expires_us) continue;
+        if (s->used) s_stats.expired++;
+        s->used       = true;
+        s->gen++;
+        s->min_khz    = min_khz;
+        s->expires_us = now + (uint64_t)duration_ms * 1000u;
+        handle = (int)(((uint32_t)s->gen << 8) | i);
+        break;
+    }
+    if (handle >= 0) s_stats.requests++;
+    else             s_stats.rejected++;
+    boost_refresh_locked(now);
+    critical_section_exit(&s_cs);
+
+    if (handle >= 0) {
+        s_pending = true;
+        __sev();                    /* wake Core 1 out of core1_wait_ms() */
+    }
+    return handle;
+}
+
+void freq_boost_release(int handle)
+{
+    if (handle < 0 || !s_inited) return;
+    uint32_t i   = (uint32_t)handle & 0xFFu;
+    uint8_t  gen = (uint8_t)((uint32_t)handle >> 8);
+    if (i >= FREQ_BOOST_SLOTS) return;
+
+    critical_section_enter_blocking(&s_cs);
+    if (s_slots[i].used && s_slots[i].gen == gen)
+        s_slots[i].used = false;
+    boost_refresh_locked(time_us_64());
+    critical_section_exit(&s_cs);
+}
+
+uint32_t freq_boost_floor_khz(void)
+{
+    if (!s_inited) return 0;
+    critical_section_enter_blocking(&s_cs);
+    boost_refresh_locked(time_us_64());
+    uint32_t floor = s_stats.floor_khz;
+    critical_section_exit(&s_cs);
+    return floor;
+}
+
+bool freq_boost_pending(void)
+{
+    return s_pending;
+}
+
+bool freq_boost_take(void)
+{
+    bool p = s_pending;
+    s_pending = false;
+    return p;
+}
+
+void freq_boost_get_stats(freq_boost_stats_t *out)
+{
+    if (!out) return;
+    if (!s_inited) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    critical_section_enter_blocking(&s_cs);
+    uint64_t now = time_us_64();
+    boost_refresh_locked(now);
+    *out = s_stats;
+    if (out->floor_khz)             /* include the interval in progress */
+        out->boosted_us += now - s_boost_since_us;
+    critical_section_exit(&s_cs);
+}
@@ -0,0 +1,72 @@
+#ifndef FREQ_BOOST_H
+#define FREQ_BOOST_H
+
+/*
+ * freq_boost.h  –  time-bounded frequency floor for latency-critical bursts
+ *
+ * freq_boost_request() lets an application say "I need at least min_khz
+ * for the next duration_ms" without going through the metrics heuristics.
+ * Each request holds one slot (a reference); the effective floor is the
+ * highest min_khz among live slots and drops back to 0 once every slot
+ * has expired or been released.
+ *
+ *   freq_boost_request()  (either core, IRQ-safe)
+ *     └─ slot + SEV ──► Core 1 leaves core1_wait_ms() and hops straight to
+ *                       the floor (RAMP_MODE_DIRECT, voltage pre-raised)
+ *   freq_policy           the floor is the QOS minimum of the policy range,
+ *                         which ramp_step() clamps every target to (a
+ *                         thermal or user maximum still wins)
+ *
+ * The floor never applies while the governor is suspended (calibration
+ * owns the clock then).
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FREQ_BOOST_SLOTS        8u
+#define FREQ_BOOST_MAX_MS       10000u   /* longest single request */
+
+typedef struct {
+    uint32_t requests;      /* granted requests since boot          */
+    uint32_t rejected;      /* no free slot                         */
+    uint32_t expired;       /* slots that ran out (not released)    */
+    uint32_t active;        /* live references                      */
+    uint32_t floor_khz;     /* current floor, 0 if none             */
+    uint64_t boosted_us;    /* total time with a floor in force     */
+} freq_boost_stats_t;
+
+/** Call once on Core 0 before launching Core 1. */
+void freq_boost_init(void);
+
+/**
+ * Raise the frequency floor to at least min_khz (clamped to
+ * [MIN_KHZ, MAX_KHZ]) for duration_ms (capped at FREQ_BOOST_MAX_MS).
+ * Returns a handle for freq_boost_release(), or -1 if all slots are busy
+ * (or duration_ms is 0).
+ */
+int freq_boost_request(uint32_t min_khz, uint32_t duration_ms);
+
+/** Drop a reference early.  Stale or invalid handles are ignored. */
+void freq_boost_release(int handle);
+
+/** Current floor in kHz (0 = none); expires stale slots as a side effect. */
+uint32_t freq_boost_floor_khz(void);
+
+/** Core 1: true if a request arrived since the last freq_boost_take(). */
+bool freq_boost_pending(void);
+
+/** Core 1: consume the pending flag. */
+bool freq_boost_take(void);
+
+void freq_boost_get_stats(freq_boost_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREQ_BOOST_H */
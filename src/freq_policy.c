@@ -0,0 +1,147 @@
+/*
+ * freq_policy.c  –  scaling_min_khz / scaling_max_khz from named constraints
+ */
+
+#include "freq_policy.h"
+#include "freq_boost.h"
+#include "system.h"
+#include "pll_table.h"
+#include "pico/sync.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t min_khz;
+    uint32_t max_khz;
+} constraint_t;
+
+static constraint_t       s_c[FREQ_POLICY_SOURCES];
+static critical_section_t s_cs;
+static bool               s_inited = false;
+
+static const char *const src_names[FREQ_POLICY_SOURCES] = {
+    "boot", "user", "thermal", "qos",
+};
+
+void freq_policy_init(void)
+{
+    if (s_inited) return;
+    critical_section_init(&s_cs);
+    memset(s_c, 0, sizeof(s_c));
+    s_c[FREQ_POLICY_BOOT].min_khz = MIN_KHZ;
+    s_c[FREQ_POLICY_BOOT].max_khz = MAX_KHZ;
+    s_inited = true;
+}
+
+void freq_policy_set(freq_policy_src_t src, uint32_t min_khz, uint32_t max_khz)
+{
+    if (!s_inited || src <= FREQ_POLICY_BOOT || src >= FREQ_POLICY_SOURCES) return;
+    critical_section_enter_blocking(&s_cs);
+    s_c[src].min_khz = min_khz;
+    s_c[src].max_khz = max_khz;
+    critical_section_exit(&s_cs);
+}
+
+void freq_policy_clear(freq_policy_src_t src)
+{
+    freq_policy_set(src, 0, 0);
+}
+
+/* QoS is the explicit slot combined with the live boost floor. */
+static constraint_t constraint_of(freq_policy_src_t src, const constraint_t *c)
+{
+    constraint_t r = c[src];
+    if (src == FREQ_POLICY_QOS) {
+        uint32_t floor = freq_boost_floor_khz();
+        if (floor > r.min_khz) r.min_khz = floor;
+    }
+    return r;
+}
+
+void freq_policy_get_constraint(freq_policy_src_t src,
+                                uint32_t *min_khz, uint32_t *max_khz)
+{
+    constraint_t r = { 0, 0 };
+    if (s_inited && src < FREQ_POLICY_SOURCES) {
+        constraint_t c[FREQ_POLICY_SOURCES];
+        critical_section_enter_blocking(&s_cs);
+        memcpy(c, s_c, sizeof(c));
+        critical_section_exit(&s_cs);
+        r = constraint_of(src, c);
+    }
+    if (min_khz) *min_khz = r.min_khz;
+    if (max_khz) *max_khz = r.max_khz;
+}
+
+void freq_policy_get(freq_policy_t *out)
+{
+    if (!out) return;
+    out->min_khz = MIN_KHZ;
+    out->max_khz = MAX_KHZ;
+    out->min_src = FREQ_POLICY_BOOT;
+    out->max_src = FREQ_POLICY_BOOT;
+    if (!s_inited) return;
+
+    constraint_t c[FREQ_POLICY_SOURCES];
+    critical_section_enter_blocking(&s_cs);
+    memcpy(c, s_c, sizeof(c));
+    critical_section_exit(&s_cs);
+
+    /* Later sources win ties, so BOOT only binds when nothing else does. */
+    for (uint32_t i = FREQ_POLICY_USER; i < FREQ_POLICY_SOURCES; ++i) {
+        constraint_t r = constraint_of((freq_policy_src_t)i, c);
+        if (r.min_khz && r.min_khz >= out->min_khz) {
+            out->min_khz = r.min_khz;
+            out->min_src = (freq_policy_src_t)i;
+        }
+        if (r.max_khz && r.max_khz <= out->max_khz) {
+            out->max_khz = r.max_khz;
+            out->max_src = (freq_policy_src_t)i;
+        }
+    }
+    if (out->min_khz > out->max_khz) {
+        out->min_khz = out->max_khz;    /* max wins */
+        out->min_src = out->max_src;
+    }
+}
+
+/* A range with no PLL frequency inside (e.g. a pin between two entries)
+ * resolves to the entry nearest its middle, never to a raw bound. */
+static uint32_t nearest_to_range(const freq_policy_t *p)
+{
+    const pll_entry_t *e = pll_table_nearest(p->min_khz + (p->max_khz - p->min_khz) / 2u);
+    return e ? e->khz : p->min_khz;
+}
+
+uint32_t freq_policy_clamp(uint32_t khz)
+{
+    freq_policy_t p;
+    freq_policy_get(&p);
+    if (khz < p.min_khz) {
+        const pll_entry_t *e = pll_table_ceil(p.min_khz);
+        khz = (e && e->khz <= p.max_khz) ? e->khz : nearest_to_range(&p);
+    }
+    if (khz > p.max_khz) {
+        const pll_entry_t *e = pll_table_floor(p.max_khz);
+        khz = (e && e->khz >= p.min_khz) ? e->khz : nearest_to_range(&p);
+    }
+    return khz;
+}
+
+uint32_t freq_policy_min_khz(void)
+{
+    freq_policy_t p;
+    freq_policy_get(&p);
+    return p.min_khz;
+}
+
+uint32_t freq_policy_max_khz(void)
+{
+    freq_policy_t p;
+    freq_policy_get(&p);
+    return p.max_khz;
+}
+
+const char *freq_policy_src_name(freq_policy_src_t src)
+{
+    return (src < FREQ_POLICY_SOURCES) ? src_names[src] : "?";
+}
@@ -0,0 +1,78 @@
+#ifndef FREQ_POLICY_H
+#define FREQ_POLICY_H
+
+/*
+ * freq_policy.h  –  scaling_min_khz / scaling_max_khz from named constraints
+ *
+ * Several parties have an opinion on clk_sys.  Instead of each writing
+ * target_khz and overwriting the others, each owns a constraint slot:
+ *
+ *   BOOT     hardware range [MIN_KHZ, MAX_KHZ], always present
+ *   USER     shell: `set <mhz>` pins min = max, `policy min|max` bounds
+ *   THERMAL  global throttle: max = THERMAL_CAP_KHZ while engaged
+ *   QOS      application boosts: min = freq_boost_floor_khz()
+ *
+ * The effective range is the highest min and the lowest max; when they
+ * cross, max wins (a thermal cap is never overridden by a boost).  The
+ * source that supplied each bound is reported as the one that binds it.
+ *
+ * Governors pick target_khz within the range (Core 1 clamps target_khz to
+ * it before every tick) and ramp_step() clamps its goal to it, so no
+ * governor decision can leave it.  The range is not applied while the
+ * governor is suspended (VREG calibration owns the clock then).
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FREQ_POLICY_BOOT = 0,
+    FREQ_POLICY_USER,
+    FREQ_POLICY_THERMAL,
+    FREQ_POLICY_QOS,
+    FREQ_POLICY_SOURCES
+} freq_policy_src_t;
+
+typedef struct {
+    uint32_t          min_khz;    /* scaling_min_khz */
+    uint32_t          max_khz;    /* scaling_max_khz */
+    freq_policy_src_t min_src;    /* source binding each bound */
+    freq_policy_src_t max_src;
+} freq_policy_t;
+
+/** Install the BOOT constraint.  Call once on Core 0 before launching Core 1. */
+void freq_policy_init(void);
+
+/**
+ * Set a source's constraint; 0 leaves that side unconstrained.  Either
+ * core.  The BOOT slot cannot be changed.
+ */
+void freq_policy_set(freq_policy_src_t src, uint32_t min_khz, uint32_t max_khz);
+void freq_policy_clear(freq_policy_src_t src);
+
+/** A source's own constraint (0 = none on that side). */
+void freq_policy_get_constraint(freq_policy_src_t src,
+                                uint32_t *min_khz, uint32_t *max_khz);
+
+/** Effective range and binding sources. */
+void freq_policy_get(freq_policy_t *out);
+
+/**
+ * khz moved into the effective range, on achievable PLL frequencies.  If
+ * no PLL frequency lies in the range, the one nearest to it.
+ */
+uint32_t freq_policy_clamp(uint32_t khz);
+
+uint32_t freq_policy_min_khz(void);
+uint32_t freq_policy_max_khz(void);
+
+const char *freq_policy_src_name(freq_policy_src_t src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREQ_POLICY_H */
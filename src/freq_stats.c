@@ -0,0 +1,79 @@
+/*
+ * freq_stats.c  –  clk_sys time-in-state and transition accounting
+ */
+
+#include "freq_stats.h"
+#include "system.h"
+#include "pico/stdlib.h"
+#include "pico/sync.h"
+#include <string.h>
+
+static freq_stats_t       s_stats;
+static uint64_t           s_enter_us;    /* when the current bucket was entered */
+static critical_section_t s_cs;
+static bool               s_inited = false;
+
+uint32_t freq_stats_bucket(uint32_t khz)
+{
+    if (khz <= MIN_KHZ) return 0;
+    uint32_t b = (khz - MIN_KHZ) / FREQ_STATS_BUCKET_KHZ;
+    return (b < FREQ_STATS_BUCKETS) ? b : FREQ_STATS_BUCKETS - 1u;
+}
+
+uint32_t freq_stats_bucket_lo_khz(uint32_t bucket)
+{
+    return MIN_KHZ + bucket * FREQ_STATS_BUCKET_KHZ;
+}
+
+void freq_stats_init(uint32_t khz)
+{
+    if (s_inited) return;
+    critical_section_init(&s_cs);
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_enter_us          = time_us_64();
+    s_stats.since_us    = s_enter_us;
+    s_stats.cur_bucket  = freq_stats_bucket(khz);
+    s_inited = true;
+}
+
+void freq_stats_record(uint32_t from_khz, uint32_t to_khz)
+{
+    if (!s_inited) return;
+    uint32_t from = freq_stats_bucket(from_khz);
+    uint32_t to   = freq_stats_bucket(to_khz);
+    uint64_t now  = time_us_64();
+
+    critical_section_enter_blocking(&s_cs);
+    s_stats.residency_us[from] += now - s_enter_us;
+    s_stats.trans[from][to]++;
+    s_stats.trans_total++;
+    s_stats.cur_bucket = to;
+    s_enter_us = now;
+    critical_section_exit(&s_cs);
+}
+
+void freq_stats_snapshot(freq_stats_t *out)
+{
+    if (!out) return;
+    if (!s_inited) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    critical_section_enter_blocking(&s_cs);
+    memcpy(out, &s_stats, sizeof(*out));
+    uint64_t open_us = time_us_64() - s_enter_us;
+    critical_section_exit(&s_cs);
+    out->residency_us[out->cur_bucket] += open_us;
+}
+
+void freq_stats_reset(void)
+{
+    if (!s_inited) return;
+    critical_section_enter_blocking(&s_cs);
+    uint32_t cur = s_stats.cur_bucket;
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_enter_us         = time_us_64();
+    s_stats.since_us   = s_enter_us;
+    s_stats.cur_bucket = cur;
+    critical_section_exit(&s_cs);
+}
@@ -0,0 +1,54 @@
+#ifndef FREQ_STATS_H
+#define FREQ_STATS_H
+
+/*
+ * freq_stats.h  –  clk_sys time-in-state and transition accounting
+ *
+ * The RP2040 equivalent of cpufreq's stats/time_in_state and
+ * stats/trans_table.  [MIN_KHZ, MAX_KHZ] is split into FREQ_STATS_BUCKETS
+ * buckets of FREQ_STATS_BUCKET_KHZ (bucket i = [MIN + i*B, MIN + (i+1)*B),
+ * the last bucket also holds MAX_KHZ).  ramp_step() reports every clock
+ * change; residency accrues to the bucket of the clock that was running,
+ * and each change bumps trans[from][to].
+ *
+ * Updates come from Core 1, snapshots/resets from either core; both sides
+ * take a critical_section, held only for the copy.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FREQ_STATS_BUCKET_KHZ  10000u
+#define FREQ_STATS_BUCKETS     14u      /* 125 .. 264 MHz */
+
+typedef struct {
+    uint64_t residency_us[FREQ_STATS_BUCKETS];            /* incl. current state */
+    uint32_t trans[FREQ_STATS_BUCKETS][FREQ_STATS_BUCKETS]; /* [from][to]        */
+    uint32_t trans_total;
+    uint32_t cur_bucket;
+    uint64_t since_us;                                     /* last reset          */
+} freq_stats_t;
+
+/** Start accounting at `khz`.  Call once on Core 0 before launching Core 1. */
+void freq_stats_init(uint32_t khz);
+
+/** Record a clk_sys change.  Called by ramp_step() after each PLL step. */
+void freq_stats_record(uint32_t from_khz, uint32_t to_khz);
+
+/** Consistent copy with the running state's residency folded in. */
+void freq_stats_snapshot(freq_stats_t *out);
+
+/** Zero residency and transitions; accounting continues from now. */
+void freq_stats_reset(void);
+
+uint32_t freq_stats_bucket(uint32_t khz);
+uint32_t freq_stats_bucket_lo_khz(uint32_t bucket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREQ_STATS_H */
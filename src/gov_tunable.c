@@ -0,0 +1,172 @@
+/*
+ * gov_tunable.c  –  descriptor tables for governor parameters
+ */
+
+#include "gov_tunable.h"
+#include "governors.h"
+#include "persist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Largest params struct that fits a persist slot with the layout tag. */
+#define GOV_TUNABLE_MAX_SIZE  (PERSIST_GOV_PARAMS_MAX - sizeof(uint32_t))
+
+static int desc_cmp(const void *key, const void *elem)
+{
+    return strcmp((const char *)key, ((const gov_tunable_t *)elem)->name);
+}
+
+const gov_tunable_t *gov_tunable_find(const gov_tunables_t *t, const char *name)
+{
+    if (!t || !t->desc || !name) return NULL;
+    return bsearch(name, t->desc, t->count, sizeof(t->desc[0]), desc_cmp);
+}
+
+static double field_get(const gov_tunables_t *t, const gov_tunable_t *d)
+{
+    const uint8_t *p = (const uint8_t *)t->params + d->offset;
+    switch (d->type) {
+    case GOV_TUNABLE_U32:    return *(const uint32_t *)p;
+    case GOV_TUNABLE_FLOAT:  return *(const float *)p;
+    case GOV_TUNABLE_DOUBLE: return *(const double *)p;
+    }
+    return 0.0;
+}
+
+static void field_set(const gov_tunables_t *t, const gov_tunable_t *d, double v)
+{
+    uint8_t *p = (uint8_t *)t->params + d->offset;
+    switch (d->type) {
+    case GOV_TUNABLE_U32:    *(uint32_t *)p = (uint32_t)(v + 0.5); break;
+    case GOV_TUNABLE_FLOAT:  *(float *)p    = (float)v;            break;
+    case GOV_TUNABLE_DOUBLE: *(double *)p   = v;                   break;
+    }
+}
+
+int gov_tunable_get(const Governor *g, const char *name, double *out)
+{
+    if (!g || !out) return -1;
+    const gov_tunable_t *d = gov_tunable_find(g->tunables, name);
+    if (!d) return -1;
+    *out = field_get(g->tunables, d);
+    return 0;
+}
+
+int gov_tunable_apply(const Governor *g, const char *name, double val)
+{
+    if (!g) return -1;
+    const gov_tunable_t *d = gov_tunable_find(g->tunables, name);
+    if (!d) return -1;
+    if (!(val >= d->min && val <= d->max)) return -2;   /* also rejects NaN */
+    field_set(g->tunables, d, val);
+    return 0;
+}
+
+int gov_tunable_set(const Governor *g, const char *name, double val)
+{
+    int rc = gov_tunable_apply(g, name, val);
+    if (rc == 0) gov_tunables_save(g);
+    return rc;
+}
+
+static void print_value(const gov_tunables_t *t, const gov_tunable_t *d)
+{
+    if (d->type == GOV_TUNABLE_U32)
+        printf("%lu", (unsigned long)*(const uint32_t *)((const uint8_t *)t->params + d->offset));
+    else
+        printf("%.2f", field_get(t, d));
+}
+
+void gov_tunables_print(const Governor *g)
+{
+    if (!g || !g->tunables) return;
+    const gov_tunables_t *t = g->tunables;
+    printf("%s parameters:\n", g->name);
+    for (size_t i = 0; i < t->count; ++i) {
+        const gov_tunable_t *d = &t->desc[i];
+        printf("  %-22s: ", d->name);
+        print_value(t, d);
+        printf(" %s\n", d->unit);
+    }
+}
+
+void gov_tunables_list(const Governor *g)
+{
+    if (!g || !g->tunables) return;
+    const gov_tunables_t *t = g->tunables;
+    printf("Available params for %s:\n", g->name);
+    for (size_t i = 0; i < t->count; ++i) {
+        const gov_tunable_t *d = &t->desc[i];
+        printf("  %-22s [%g .. %g] %s\n", d->name, d->min, d->max, d->unit);
+    }
+}
+
+bool gov_tunables_check(const gov_tunables_t *t)
+{
+    if (!t) return true;
+    if (t->size > GOV_TUNABLE_MAX_SIZE) return false;
+    for (size_t i = 1; i < t->count; ++i)
+        if (strcmp(t->desc[i - 1].name, t->desc[i].name) >= 0) return false;
+    return true;
+}
+
+/* FNV-1a */
+static uint32_t fnv1a(uint32_t h, const void *buf, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+#define FNV_BASIS 2166136261u
+
+static uint32_t name_key(const Governor *g)
+{
+    return fnv1a(FNV_BASIS, g->name, strlen(g->name));
+}
+
+/* Changes whenever a field is added, removed, renamed, retyped or moved. */
+static uint32_t layout_hash(const gov_tunables_t *t)
+{
+    uint32_t h = fnv1a(FNV_BASIS, &t->size, sizeof(t->size));
+    for (size_t i = 0; i < t->count; ++i) {
+        const gov_tunable_t *d = &t->desc[i];
+        uint32_t tag[2] = { (uint32_t)d->type, d->offset };
+        h = fnv1a(h, d->name, strlen(d->name));
+        h = fnv1a(h, tag, sizeof(tag));
+    }
+    return h;
+}
+
+int gov_tunables_save(const Governor *g)
+{
+    if (!g || !g->name || !g->tunables) return -1;
+    const gov_tunables_t *t = g->tunables;
+    if (t->size > GOV_TUNABLE_MAX_SIZE) return -1;
+
+    uint8_t rec[PERSIST_GOV_PARAMS_MAX];
+    uint32_t layout = layout_hash(t);
+    memcpy(rec, &layout, sizeof(layout));
+    memcpy(rec + sizeof(layout), t->params, t->size);
+    return persist_save_gov_params(name_key(g), rec, sizeof(layout) + t->size);
+}
+
+int gov_tunables_load(const Governor *g)
+{
+    if (!g || !g->name || !g->tunables) return -1;
+    const gov_tunables_t *t = g->tunables;
+    if (t->size > GOV_TUNABLE_MAX_SIZE) return -1;
+
+    uint8_t rec[PERSIST_GOV_PARAMS_MAX];
+    int n = persist_load_gov_params(name_key(g), rec, sizeof(rec));
+    uint32_t layout;
+    if (n != (int)(sizeof(layout) + t->size)) return -1;
+    memcpy(&layout, rec, sizeof(layout));
+    if (layout != layout_hash(t)) return -1;
+    memcpy(t->params, rec + sizeof(layout), t->size);
+    return (int)t->size;
+}
@@ -0,0 +1,97 @@
+#ifndef GOV_TUNABLE_H
+#define GOV_TUNABLE_H
+
+/*
+ * gov_tunable.h  –  descriptor tables for governor parameters
+ *
+ * A governor keeps its thresholds in one plain params struct and describes
+ * each field once:
+ *
+ *   static const gov_tunable_t ond_desc[] = {          (sorted by name)
+ *       GOV_TUNABLE(ond_params_t, hot_C,  GOV_TUNABLE_FLOAT, 40, 90, "C"),
+ *       GOV_TUNABLE(ond_params_t, ...),
+ *   };
+ *
+ * and points Governor.tunables at the table, the struct and its size.
+ * `gov tune <governor> show|list|get|set` then works on any governor
+ * without per-parameter code: names are found by binary search (the
+ * table must be sorted by strcmp order; governors_init() checks), values
+ * are range-checked against min/max and stored through the field offset.
+ *
+ * Every set persists the whole struct to flash under the governor's name,
+ * tagged with a hash of the table layout; governors_init() restores all
+ * governors at boot and a record whose layout no longer matches the
+ * firmware is ignored instead of being misread.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    GOV_TUNABLE_U32 = 0,
+    GOV_TUNABLE_FLOAT,
+    GOV_TUNABLE_DOUBLE,
+} gov_tunable_type_t;
+
+typedef struct {
+    const char        *name;
+    gov_tunable_type_t type;
+    uint16_t           offset;      /* of the field in the params struct */
+    double             min;         /* inclusive range for set */
+    double             max;
+    const char        *unit;        /* shown by list/show, may be "" */
+} gov_tunable_t;
+
+typedef struct {
+    const gov_tunable_t *desc;      /* sorted by name */
+    size_t               count;
+    void                *params;    /* the governor's live params struct */
+    size_t               size;
+} gov_tunables_t;
+
+#define GOV_TUNABLE(st, field, type, lo, hi, unit) \
+    { #field, (type), (uint16_t)offsetof(st, field), (lo), (hi), (unit) }
+
+#define GOV_TUNABLES(desc, params) \
+    { (desc), sizeof(desc) / sizeof((desc)[0]), &(params), sizeof(params) }
+
+struct Governor;
+
+/** Descriptor for `name`, or NULL.  O(log n). */
+const gov_tunable_t *gov_tunable_find(const gov_tunables_t *t, const char *name);
+
+/** 0 on success, -1 unknown governor/param. */
+int gov_tunable_get(const struct Governor *g, const char *name, double *out);
+
+/**
+ * Range-check, store and persist.  Returns 0 on success, -1 unknown
+ * governor/param, -2 value outside [min, max].
+ */
+int gov_tunable_set(const struct Governor *g, const char *name, double val);
+
+/** As gov_tunable_set() without the flash write (trial values, autotune). */
+int gov_tunable_apply(const struct Governor *g, const char *name, double val);
+
+/** Current values (show) or names with unit and range (list). */
+void gov_tunables_print(const struct Governor *g);
+void gov_tunables_list(const struct Governor *g);
+
+/** True if the table is sorted with unique names. */
+bool gov_tunables_check(const gov_tunables_t *t);
+
+/** Write the params struct to flash.  0 on success. */
+int gov_tunables_save(const struct Governor *g);
+
+/** Restore persisted params; returns bytes loaded or -1 if none/stale. */
+int gov_tunables_load(const struct Governor *g);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOV_TUNABLE_H */
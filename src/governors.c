@@ -1,25 +1,71 @@
 #include "governors.h"
 #include <stddef.h>
 #include <string.h>
+#include <stdio.h>
 #include "persist.h"
+#include "dmesg.h"
+#include "gov_tunable.h"
 
 /* Registry of built-in governors */
 extern const Governor *governor_ondemand(void);
 extern const Governor *governor_schedutil(void);
 extern const Governor *governor_performance(void);
 extern const Governor *governor_rp2040_perf(void);
+extern const Governor *governor_pid(void);
+extern const Governor *governor_predictive(void);
+extern const Governor *governor_conservative(void);
+extern const Governor *governor_deadline(void);
 
-static const Governor *registry[8];
+static const Governor *registry[GOVERNOR_MAX];
 static size_t registry_n = 0;
 static const Governor *current = NULL;
+static volatile bool tickless = false;
+static uint32_t tick_request = GOV_TICK_NONE;    /* Core 1 only */
+
+/* Every registered governor needs a tunables slot inside the sector. */
+_Static_assert(PERSIST_GOV_PARAMS_OFFSET + GOVERNOR_MAX * PERSIST_GOV_PARAMS_SLOT
+               <= PERSIST_SECTOR_SIZE, "GOVERNOR_MAX tunables slots overrun the persist sector");
+
+static void governors_register(const Governor *g)
+{
+    if (registry_n < GOVERNOR_MAX) {
+        registry[registry_n++] = g;
+        return;
+    }
+    char buf[64];
+    snprintf(buf, sizeof(buf), "gov:%s not registered, raise GOVERNOR_MAX", g->name);
+    dmesg_log(buf);
+}
 
 void governors_init(void)
 {
     if (registry_n == 0) {
-        registry[registry_n++] = governor_ondemand();
-        registry[registry_n++] = governor_schedutil();
-        registry[registry_n++] = governor_performance();
-            registry[registry_n++] = governor_rp2040_perf();
+        governors_register(governor_ondemand());
+        governors_register(governor_schedutil());
+        governors_register(governor_performance());
+        governors_register(governor_rp2040_perf());
+        governors_register(governor_pid());
+        governors_register(governor_predictive());
+        governors_register(governor_conservative());
+        governors_register(governor_deadline());
+
+        /* Restore every governor's tunables once, so tuning one that is
+           not active never overwrites its saved values with defaults. */
+        for (size_t i = 0; i < registry_n; ++i) {
+            const Governor *g = registry[i];
+            if (!g->tunables) continue;
+            if (!gov_tunables_check(g->tunables)) {
+                char buf[64];
+                snprintf(buf, sizeof(buf), "gov:%s tunables unsorted/too large", g->name);
+                dmesg_log(buf);
+                continue;
+            }
+            if (gov_tunables_load(g) > 0) {
+                char buf[64];
+                snprintf(buf, sizeof(buf), "gov:%s loaded persisted params", g->name);
+                dmesg_log(buf);
+            }
+        }
     }
 
     if (!current) {
@@ -45,10 +91,15 @@ const Governor *governors_get_current(void)
     return current;
 }
 
-void governors_set_current(const Governor *g)
+void governors_set_current_transient(const Governor *g)
 {
     current = g;
     if (current && current->init) current->init();
+}
+
+void governors_set_current(const Governor *g)
+{
+    governors_set_current_transient(g);
     /* persist selection so it survives reboot */
     if (current && current->name) persist_save(current->name);
 }
@@ -72,3 +123,32 @@ const Governor *governors_find_by_name(const char *name)
     }
     return NULL;
 }
+
+uint32_t governor_sampling_rate_ms(const Governor *g)
+{
+    uint32_t ms = (g && g->sampling_rate_ms) ? *g->sampling_rate_ms : GOV_SAMPLING_DEFAULT_MS;
+    return ms ? ms : 1u;
+}
+
+void governor_request_tick(uint32_t ms)
+{
+    if (ms == 0) ms = governor_sampling_rate_ms(current);
+    if (ms < tick_request) tick_request = ms;
+}
+
+uint32_t governor_take_tick_request(void)
+{
+    uint32_t r = tick_request;
+    tick_request = GOV_TICK_NONE;
+    return r;
+}
+
+void governors_set_tickless(bool on)
+{
+    tickless = on;
+}
+
+bool governors_tickless(void)
+{
+    return tickless;
+}
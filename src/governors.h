@@ -3,21 +3,65 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include "metrics.h"
+#include "gov_tunable.h"
 
+/* Pacing is owned by core1_entry(), not by the governors: a tick decides
+ * and returns, then Core 1 waits for the governor's sampling_rate_ms (a
+ * tunable field in its params struct) or until a metrics doorbell, boost
+ * request or rt_task release, and feeds the watchdog itself.
+ *
+ * In tickless mode a tick that leaves nothing pending (no metrics this
+ * tick, clock at target, no governor_request_tick()) is followed by a
+ * sleep of up to GOV_TICKLESS_MAX_MS, the thermal check deadline, instead
+ * of one sampling period.  Governors with time-driven work (cooldowns,
+ * idle timeouts, predicted events) ask for their next tick explicitly. */
 typedef struct Governor {
     const char *name;
     void (*init)(void);
-    /* Called repeatedly on core1; receives latest aggregated metrics (may be NULL) */
+    /* Called on core1 once per sampling period; receives the latest
+       aggregated metrics (may be NULL).  Must not sleep. */
     void (*tick)(const metrics_agg_t *metrics);
     /* Optional: export human-readable stats into provided buffer */
     void (*export_stats)(char *buf, size_t len);
+    /* Optional: parameter descriptors for `gov tune` (see gov_tunable.h) */
+    const gov_tunables_t *tunables;
+    /* Optional: sampling period, normally the governor's sampling_rate_ms
+       tunable (NULL = GOV_SAMPLING_DEFAULT_MS) */
+    const uint32_t *sampling_rate_ms;
+    /* Skip the boost fast path (direct hop with VREG pre-warmed); the
+       governor reaches the QoS floor through its own ramp_step() calls */
+    bool no_fast_ramp;
 } Governor;
 
+#define GOV_SAMPLING_DEFAULT_MS  50u
+#define GOV_TICKLESS_MAX_MS      250u    /* thermal check deadline */
+#define GOV_TICK_NONE            UINT32_MAX
+#define GOVERNOR_MAX             8u      /* registry size; one tunables slot each (persist.h) */
+
+/** Sampling period of g in ms (never 0). */
+uint32_t governor_sampling_rate_ms(const Governor *g);
+
+/**
+ * From tick(): run the next tick within ms (0 = one sampling period) even
+ * in tickless mode.  The earliest request of a tick wins.
+ */
+void governor_request_tick(uint32_t ms);
+
+/** Core 1: consume this tick's request (GOV_TICK_NONE if none). */
+uint32_t governor_take_tick_request(void);
+
+void governors_set_tickless(bool on);
+bool governors_tickless(void);
+
 void governors_init(void);
 const Governor *governors_get_current(void);
 void governors_set_current(const Governor *g);
+/* Same, without writing the selection to flash: for temporary switches
+ * such as autotune's benchmarks, which must not wear the persist sector. */
+void governors_set_current_transient(const Governor *g);
 
 /* Registry access */
 size_t governors_count(void);
@@ -29,5 +73,9 @@ const Governor *governor_ondemand(void);
 const Governor *governor_schedutil(void);
 const Governor *governor_performance(void);
 const Governor *governor_rp2040_perf(void);
+const Governor *governor_pid(void);
+const Governor *governor_predictive(void);
+const Governor *governor_conservative(void);
+const Governor *governor_deadline(void);
 
 #endif
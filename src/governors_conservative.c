@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "system.h"
+#include "dmesg.h"
+#include "governors.h"
+#include "gov_tunable.h"
+#include "freq_policy.h"
+#include "pio_idle.h"
+#include "pll_table.h"
+
+/* Conservative governor, after Linux's cpufreq_conservative: for boards
+ * on weak supplies where a jump to MAX_KHZ (and the VREG step that comes
+ * with it) browns out the rail.
+ *
+ *   load  the larger of the PIO-measured busy share (1 - idle_fraction)
+ *         and the app-reported intensity of this tick
+ *   load > up_threshold    target += freq_step % of scaling_max
+ *   load < down_threshold  target -= freq_step % of scaling_max
+ *
+ * The target moves at most one freq_step per sampling period (metrics
+ * doorbell wakeups in between do not step again), snapped to a PLL
+ * frequency.  VREG is never pre-warmed: ramp_step() raises it just before
+ * the step that needs it and lowers it after the step that allows it.
+ * export_stats reports the largest voltage and frequency change made by a
+ * single ramp_step() and the peak slew, each change over that step's own
+ * duration: a proxy for the supply's dI/dt. */
+
+/* Tunable parameters (adjustable at runtime via `gov tune conservative`) */
+typedef struct {
+    float    up_threshold;       /* load above this steps up */
+    float    down_threshold;     /* load below this steps down */
+    float    freq_step;          /* step, % of scaling_max */
+    uint32_t sampling_rate_ms;   /* tick period */
+} cons_params_t;
+
+static cons_params_t cons_params = {
+    .up_threshold     = 80.0f,
+    .down_threshold   = 20.0f,
+    .freq_step        = 5.0f,
+    .sampling_rate_ms = 100,
+};
+
+/* Sorted by name (binary search in gov_tunable.c). */
+static const gov_tunable_t cons_desc[] = {
+    GOV_TUNABLE(cons_params_t, down_threshold,   GOV_TUNABLE_FLOAT, 0,  99,   "%"),
+    GOV_TUNABLE(cons_params_t, freq_step,        GOV_TUNABLE_FLOAT, 1,  100,  "%"),
+    GOV_TUNABLE(cons_params_t, sampling_rate_ms, GOV_TUNABLE_U32,   10, 1000, "ms"),
+    GOV_TUNABLE(cons_params_t, up_threshold,     GOV_TUNABLE_FLOAT, 1,  100,  "%"),
+};
+
+static const gov_tunables_t cons_tunables = GOV_TUNABLES(cons_desc, cons_params);
+
+static uint32_t last_logged_target = 0;  /* Track to reduce logging spam */
+static uint64_t cons_last_step_us = 0;
+static float    cons_load = 0.0f;
+static uint32_t cons_ups = 0;
+static uint32_t cons_downs = 0;
+
+/* Per-step slew */
+static uint32_t cons_peak_dmv = 0;       /* largest single-step change, mV */
+static uint32_t cons_peak_dkhz = 0;      /* kHz */
+static float    cons_peak_mv_ms = 0.0f;  /* mV/ms */
+static float    cons_peak_khz_ms = 0.0f; /* kHz/ms */
+
+static void cons_export_stats(char *buf, size_t len)
+{
+    if (!buf || len == 0) return;
+    snprintf(buf, len,
+             "conservative: load=%.0f%% up=%lu down=%lu peak step dV=%lumV df=%.1fMHz "
+             "dV/dt=%.1fmV/ms df/dt=%.1fMHz/ms",
+             cons_load, (unsigned long)cons_ups, (unsigned long)cons_downs,
+             (unsigned long)cons_peak_dmv, cons_peak_dkhz / 1000.0f,
+             cons_peak_mv_ms, cons_peak_khz_ms / 1000.0f);
+}
+
+static void cons_init(void) {
+    target_khz = current_khz;  /* Start where we are: no step on switch-in */
+    last_logged_target = target_khz;
+    cons_last_step_us = to_us_since_boot(get_absolute_time());
+    cons_peak_dmv = 0;
+    cons_peak_dkhz = 0;
+    cons_peak_mv_ms = 0.0f;
+    cons_peak_khz_ms = 0.0f;
+    dmesg_log("gov:conservative initialized");
+}
+
+/* One ramp_step(), folding its voltage/frequency change over its own
+ * duration (VREG moves and PLL switch included) into the peaks. */
+static void cons_ramp_step(uint32_t khz)
+{
+    uint32_t mv0 = current_voltage_mv;
+    uint32_t khz0 = current_khz;
+    uint64_t t0 = to_us_since_boot(get_absolute_time());
+    ramp_step(khz);
+    uint64_t dt_us = to_us_since_boot(get_absolute_time()) - t0;
+    if (dt_us == 0) dt_us = 1;
+
+    uint32_t dmv = current_voltage_mv > mv0 ? current_voltage_mv - mv0 : mv0 - current_voltage_mv;
+    uint32_t dkhz = current_khz > khz0 ? current_khz - khz0 : khz0 - current_khz;
+    float ms = (float)dt_us / 1000.0f;
+    if (dmv > cons_peak_dmv) cons_peak_dmv = dmv;
+    if (dkhz > cons_peak_dkhz) cons_peak_dkhz = dkhz;
+    if ((float)dmv / ms > cons_peak_mv_ms) cons_peak_mv_ms = (float)dmv / ms;
+    if ((float)dkhz / ms > cons_peak_khz_ms) cons_peak_khz_ms = (float)dkhz / ms;
+}
+
+static void cons_tick(const metrics_agg_t *metrics)
+{
+    pio_idle_stats_t st;
+    pio_idle_get_stats(&st);
+    float load = (1.0f - st.idle_fraction) * 100.0f;
+    if (metrics && metrics->count > 0 && (float)metrics->avg_intensity > load)
+        load = (float)metrics->avg_intensity;
+    if (load < 0.0f) load = 0.0f;
+    if (load > 100.0f) load = 100.0f;
+    cons_load = load;
+
+    uint32_t lo = freq_policy_min_khz();
+    uint32_t hi = freq_policy_max_khz();
+    uint32_t step = (uint32_t)((float)hi * cons_params.freq_step / 100.0f);
+    uint32_t next = freq_policy_clamp(target_khz);
+
+    /* Metrics doorbells tick early; still one step per sampling period. */
+    uint64_t now_us = to_us_since_boot(get_absolute_time());
+    bool due = now_us - cons_last_step_us >= (uint64_t)cons_params.sampling_rate_ms * 1000u;
+
+    if (!due) {
+        /* hold */
+    } else if (load > cons_params.up_threshold && next < hi) {
+        const pll_entry_t *e = pll_table_ceil(next + step);
+        next = (e && e->khz < hi) ? e->khz : hi;
+        cons_ups++;
+        cons_last_step_us = now_us;
+    } else if (load < cons_params.down_threshold && next > lo) {
+        const pll_entry_t *e = next > lo + step ? pll_table_floor(next - step) : NULL;
+        next = (e && e->khz > lo) ? e->khz : lo;
+        cons_downs++;
+        cons_last_step_us = now_us;
+    }
+
+    if (next != target_khz) {
+        target_khz = next;
+        if (target_khz != last_logged_target) {
+            char buf[80];
+            snprintf(buf, sizeof(buf), "gov:conservative target -> %u kHz (load=%.0f%%)",
+                     target_khz, load);
+            dmesg_log(buf);
+            last_logged_target = target_khz;
+        }
+    }
+
+    /* No vreg_prewarm(): ramp_step() sequences VREG one step at a time. */
+    if (target_khz != current_khz)
+        cons_ramp_step(target_khz);
+
+    /* Idle time raises no event; only settled at the floor may we sleep. */
+    if (target_khz > lo || load >= cons_params.down_threshold)
+        governor_request_tick(0);
+}
+
+static const Governor g = {
+    .name = "conservative",
+    .init = cons_init,
+    .tick = cons_tick,
+    .export_stats = cons_export_stats,
+    .tunables = &cons_tunables,
+    .sampling_rate_ms = &cons_params.sampling_rate_ms,
+    .no_fast_ramp = true,
+};
+
+const Governor *governor_conservative(void) { return &g; }
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "system.h"
+#include "dmesg.h"
+#include "governors.h"
+#include "gov_tunable.h"
+#include "freq_policy.h"
+#include "pll_table.h"
+#include "rt_task.h"
+
+/* Deadline governor: the lowest clock at which the periodic tasks
+ * registered with rt_task_register() stay EDF-schedulable.
+ *
+ *   need  cycle-conserving EDF demand Σ c_i / P_i (rt_sched.h) plus
+ *         margin_pct for interrupts, the shell and the ramp itself
+ *   next  need rounded up to a PLL frequency, within the policy range
+ *
+ * An up-move is a budget that is already due, so it is ramped to in full
+ * within the tick (VREG pre-warmed); down-moves step one PLL step per tick.
+ * rt_task_release() wakes Core 1, so the clock follows each release rather
+ * than the sampling period.  Between events the governor ticks at the
+ * earliest open deadline to flag misses as they happen.
+ *
+ * App metrics and the PIO idle fraction are ignored.  With no tasks
+ * registered the target is scaling_min. */
+
+#define DL_MAX_RAMP_STEPS  64u   /* more than MIN..MAX in 5 MHz steps */
+
+/* Tunable parameters (adjustable at runtime via `gov tune deadline`) */
+typedef struct {
+    uint32_t margin_pct;         /* headroom over the EDF demand */
+    uint32_t sampling_rate_ms;   /* tick period without releases */
+} dl_params_t;
+
+static dl_params_t dl_params = {
+    .margin_pct       = 10,
+    .sampling_rate_ms = 20,
+};
+
+/* Sorted by name (binary search in gov_tunable.c). */
+static const gov_tunable_t dl_desc[] = {
+    GOV_TUNABLE(dl_params_t, margin_pct,       GOV_TUNABLE_U32, 0,  100,  "%"),
+    GOV_TUNABLE(dl_params_t, sampling_rate_ms, GOV_TUNABLE_U32, 1,  1000, "ms"),
+};
+
+static const gov_tunables_t dl_tunables = GOV_TUNABLES(dl_desc, dl_params);
+
+static uint32_t last_logged_target = 0;  /* Track to reduce logging spam */
+static uint32_t dl_seen_misses = 0;
+static uint32_t dl_need_khz = 0;
+static bool     dl_unschedulable = false;
+static rt_task_stats_t dl_st;
+
+static void dl_export_stats(char *buf, size_t len)
+{
+    if (!buf || len == 0) return;
+    snprintf(buf, len,
+             "deadline: tasks=%lu need=%lukHz wcet=%lukHz jobs=%lu misses=%lu "
+             "reclaims=%lu overruns=%lu abandoned=%lu%s",
+             (unsigned long)dl_st.tasks, (unsigned long)dl_need_khz,
+             (unsigned long)dl_st.wcet_khz, (unsigned long)dl_st.jobs,
+             (unsigned long)dl_st.misses, (unsigned long)dl_st.reclaims,
+             (unsigned long)dl_st.overruns, (unsigned long)dl_st.abandoned,
+             dl_unschedulable ? " UNSCHEDULABLE" : "");
+}
+
+static void dl_init(void) {
+    rt_task_get_stats(&dl_st);
+    dl_seen_misses = dl_st.misses;   /* report only misses from here on */
+    dl_unschedulable = false;
+    last_logged_target = target_khz;
+    dmesg_log("gov:deadline initialized");
+}
+
+static void dl_tick(const metrics_agg_t *metrics)
+{
+    (void)metrics;
+    rt_task_get_stats(&dl_st);
+
+    if (dl_st.misses != dl_seen_misses) {
+        char buf[80];
+        snprintf(buf, sizeof(buf), "gov:deadline MISSED %lu deadline(s), %lu total",
+                 (unsigned long)(dl_st.misses - dl_seen_misses),
+                 (unsigned long)dl_st.misses);
+        dmesg_log(buf);
+        dl_seen_misses = dl_st.misses;
+    }
+
+    uint32_t lo = freq_policy_min_khz();
+    uint32_t hi = freq_policy_max_khz();
+    uint64_t need = (uint64_t)dl_st.demand_khz * (100u + dl_params.margin_pct) / 100u;
+    dl_need_khz = need > UINT32_MAX ? UINT32_MAX : (uint32_t)need;
+
+    bool fits = dl_need_khz <= hi;
+    if (!fits && !dl_unschedulable) {
+        char buf[80];
+        snprintf(buf, sizeof(buf), "gov:deadline task set needs %lu kHz > scaling_max %lu kHz",
+                 (unsigned long)dl_need_khz, (unsigned long)hi);
+        dmesg_log(buf);
+    }
+    dl_unschedulable = !fits;
+
+    uint32_t next = lo;
+    if (!fits) {
+        next = hi;
+    } else if (dl_need_khz > lo) {
+        const pll_entry_t *e = pll_table_ceil(dl_need_khz);
+        next = (e && e->khz < hi) ? e->khz : hi;
+    }
+
+    if (next != target_khz) {
+        target_khz = next;
+        if (target_khz != last_logged_target) {
+            char buf[80];
+            snprintf(buf, sizeof(buf), "gov:deadline target -> %u kHz (demand=%lu kHz)",
+                     target_khz, (unsigned long)dl_st.demand_khz);
+            dmesg_log(buf);
+            last_logged_target = target_khz;
+        }
+    }
+
+    if (current_khz < target_khz) {
+        /* The restored budget is due now: get there within this tick. */
+        vreg_prewarm(target_khz);
+        for (uint32_t n = 0; n < DL_MAX_RAMP_STEPS && !ramp_step(target_khz); ++n)
+            ;
+    } else if (target_khz != current_khz) {
+        ramp_step(target_khz);
+    }
+
+    /* Next tick by the earliest open deadline, so a miss is flagged when
+       it happens; releases wake us on their own. */
+    if (target_khz != current_khz) {
+        governor_request_tick(0);
+    } else if (dl_st.next_deadline_us != UINT64_MAX) {
+        uint64_t now_us = to_us_since_boot(get_absolute_time());
+        uint64_t ms = dl_st.next_deadline_us > now_us
+                    ? (dl_st.next_deadline_us - now_us) / 1000u + 1u : 1u;
+        governor_request_tick(ms < GOV_TICKLESS_MAX_MS ? (uint32_t)ms : GOV_TICKLESS_MAX_MS);
+    }
+}
+
+static const Governor g = {
+    .name = "deadline",
+    .init = dl_init,
+    .tick = dl_tick,
+    .export_stats = dl_export_stats,
+    .tunables = &dl_tunables,
+    .sampling_rate_ms = &dl_params.sampling_rate_ms,
+};
+
+const Governor *governor_deadline(void) { return &g; }
@@ -1,78 +1,131 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "system.h"
-#include "hardware/vreg.h"
 #include "dmesg.h"
 #include "governors.h"
+#include "gov_tunable.h"
+#include "freq_policy.h"
+#include "pio_idle.h"
+#include "pll_table.h"
 
-/* On-demand governor: ramp up aggressively when activity seen, back off slowly.
-   For testing we use temperature as proxy for activity. */
+/* On-demand governor, after Linux's cpufreq_ondemand:
+ *
+ *   load  the larger of the PIO-measured busy share (1 - idle_fraction)
+ *         and the app-reported intensity of this tick
+ *   load > up_threshold   jump to scaling_max and hold it for
+ *                         sampling_down_factor samples
+ *   otherwise             scaling_min + load × (scaling_max - scaling_min),
+ *                         rounded up to a PLL frequency
+ *
+ * Temperature no longer drives the decision.  Above hot_C a separate cap
+ * walks down hot_step_khz per tick and climbs back the same way once the
+ * core is below cool_C; the target is min(load target, cap). */
+
+/* Tunable parameters (adjustable at runtime via `gov tune ondemand`) */
+typedef struct {
+    float    up_threshold;         /* load above this jumps to max */
+    uint32_t sampling_down_factor; /* samples to hold max after a jump */
+    float    hot_C;                /* lower the cap above this */
+    float    cool_C;               /* raise it again below this */
+    uint32_t hot_step_khz;         /* cap change per tick */
+    uint32_t sampling_rate_ms;     /* tick period */
+} ond_params_t;
+
+static ond_params_t ond_params = {
+    .up_threshold         = 80.0f,
+    .sampling_down_factor = 4,
+    .hot_C                = 65.0f,
+    .cool_C               = 60.0f,
+    .hot_step_khz         = 10000,
+    .sampling_rate_ms     = 80,
+};
+
+/* Sorted by name (binary search in gov_tunable.c). */
+static const gov_tunable_t ond_desc[] = {
+    GOV_TUNABLE(ond_params_t, cool_C,               GOV_TUNABLE_FLOAT, 20,   100,    "C"),
+    GOV_TUNABLE(ond_params_t, hot_C,                GOV_TUNABLE_FLOAT, 30,   100,    "C"),
+    GOV_TUNABLE(ond_params_t, hot_step_khz,         GOV_TUNABLE_U32,   1000, 100000, "kHz"),
+    GOV_TUNABLE(ond_params_t, sampling_down_factor, GOV_TUNABLE_U32,   1,    100,    ""),
+    GOV_TUNABLE(ond_params_t, sampling_rate_ms,     GOV_TUNABLE_U32,   10,   1000,   "ms"),
+    GOV_TUNABLE(ond_params_t, up_threshold,         GOV_TUNABLE_FLOAT, 1,    100,    "%"),
+};
+
+static const gov_tunables_t ond_tunables = GOV_TUNABLES(ond_desc, ond_params);
 
-static uint64_t last_idle_backoff_us = 0;
-static const uint64_t idle_backoff_cooldown_us = 500000;  /* 500ms between idle backoffs */
 static uint32_t last_logged_target = 0;  /* Track to reduce logging spam */
+static uint32_t ond_hold = 0;            /* samples left at max */
+static uint32_t ond_cap_khz = MAX_KHZ;   /* thermal cap */
+static float    ond_load = 0.0f;
+static uint32_t ond_jumps = 0;
+
+static void ond_export_stats(char *buf, size_t len)
+{
+    if (!buf || len == 0) return;
+    snprintf(buf, len, "ondemand: load=%.0f%% hold=%u cap=%ukHz jumps=%u",
+             ond_load, ond_hold, ond_cap_khz, ond_jumps);
+}
 
-static void ond_init(void) { 
-    last_idle_backoff_us = to_us_since_boot(get_absolute_time());
+static void ond_init(void) {
     target_khz = MIN_KHZ;  /* Start at idle frequency */
     last_logged_target = MIN_KHZ;
+    ond_hold = 0;
+    ond_cap_khz = MAX_KHZ;
     dmesg_log("gov:ondemand initialized at idle");
 }
 
-static void ond_tick(const metrics_agg_t *metrics)
+/* Thermal cap: one hot_step_khz per tick, down while hot, up once cool. */
+static void ond_update_cap(float temp)
 {
-    core1_wdt_ping++;
-    float temp = read_onboard_temperature();
-    uint64_t now_us = to_us_since_boot(get_absolute_time());
-    
-    /* Check idle state first: no metrics or very low activity */
-    bool is_idle = (!metrics || metrics->count == 0 || metrics->avg_intensity < 30.0);
-
-    /* Ramp up aggressively if high activity detected */
-    if (metrics && metrics->count > 0 && metrics->avg_intensity > 70.0) {
-        /* Pre-warm VREG if targeting very high frequencies */
-        if (MAX_KHZ > 250000) {
-#if defined(VREG_VOLTAGE_1_35)
-            vreg_set_voltage(VREG_VOLTAGE_1_35);
-#else
-            vreg_set_voltage(VREG_VOLTAGE_1_30);
-#endif
-        } else if (MAX_KHZ > 200000) {
-            vreg_set_voltage(VREG_VOLTAGE_1_20);
-        }
-        if (target_khz < MAX_KHZ) target_khz += 30000;
-        if (target_khz > MAX_KHZ) target_khz = MAX_KHZ;
-        if (target_khz != last_logged_target) {
-            dmesg_log("gov:ondemand ramp up (metrics)");
-            last_logged_target = target_khz;
-        }
-    } 
-    /* Ramp up if cold AND not idle (prevent oscillation) */
-    else if (!is_idle && temp < 50.0f && target_khz < MAX_KHZ) {
-        target_khz += 20000;
-        if (target_khz > MAX_KHZ) target_khz = MAX_KHZ;
-        if (target_khz != last_logged_target) {
-            dmesg_log("gov:ondemand ramp up");
-            last_logged_target = target_khz;
-        }
-    } 
-    /* Back off if very hot */
-    else if (temp > 65.0f && target_khz > 125000) {
-        target_khz -= 10000;
-        if (target_khz < 125000) target_khz = 125000;
-        if (target_khz != last_logged_target) {
+    uint32_t step = ond_params.hot_step_khz;
+    if (temp > ond_params.hot_C && ond_cap_khz > MIN_KHZ) {
+        ond_cap_khz = ond_cap_khz > MIN_KHZ + step ? ond_cap_khz - step : MIN_KHZ;
+        if (ond_cap_khz == MIN_KHZ || ond_cap_khz + step >= MAX_KHZ)
             dmesg_log("gov:ondemand backoff (hot)");
-            last_logged_target = target_khz;
-        }
+    } else if (temp < ond_params.cool_C && ond_cap_khz < MAX_KHZ) {
+        ond_cap_khz = ond_cap_khz + step < MAX_KHZ ? ond_cap_khz + step : MAX_KHZ;
+        if (ond_cap_khz == MAX_KHZ)
+            dmesg_log("gov:ondemand thermal cap released");
+    }
+}
+
+static void ond_tick(const metrics_agg_t *metrics)
+{
+    pio_idle_stats_t st;
+    pio_idle_get_stats(&st);
+    float load = (1.0f - st.idle_fraction) * 100.0f;
+    if (metrics && metrics->count > 0 && (float)metrics->avg_intensity > load)
+        load = (float)metrics->avg_intensity;
+    if (load < 0.0f) load = 0.0f;
+    if (load > 100.0f) load = 100.0f;
+    ond_load = load;
+
+    ond_update_cap(read_onboard_temperature());
+
+    uint32_t lo = freq_policy_min_khz();
+    uint32_t hi = freq_policy_max_khz();
+    uint32_t next = target_khz;
+    if (load > ond_params.up_threshold) {
+        next = hi;
+        if (target_khz < hi) ond_jumps++;
+        ond_hold = ond_params.sampling_down_factor;
+    } else if (ond_hold > 1) {
+        ond_hold--;                     /* keep the high clock a while */
+    } else {
+        ond_hold = 0;
+        float khz = (float)lo + load / 100.0f * (float)(hi - lo);
+        const pll_entry_t *e = pll_table_ceil((uint32_t)khz);
+        next = e ? e->khz : hi;
     }
-    /* Idle state: gradually back down, but only when cool */
-    else if (is_idle && temp < 48.0f && target_khz > 125000 &&
-             (now_us - last_idle_backoff_us >= idle_backoff_cooldown_us)) {
-        target_khz -= 10000;  /* Larger step to clear PLL quantization boundaries */
-        if (target_khz < 125000) target_khz = 125000;
-        last_idle_backoff_us = now_us;
+    if (next > ond_cap_khz) next = ond_cap_khz;
+
+    if (next != target_khz) {
+        if (next > current_khz) vreg_prewarm(next);
+        target_khz = next;
         if (target_khz != last_logged_target) {
-            dmesg_log("gov:ondemand idle backoff");
+            char buf[80];
+            snprintf(buf, sizeof(buf), "gov:ondemand target -> %u kHz (load=%.0f%%)",
+                     target_khz, load);
+            dmesg_log(buf);
             last_logged_target = target_khz;
         }
     }
@@ -81,13 +134,19 @@ static void ond_tick(const metrics_agg_t *metrics)
     if (target_khz != current_khz)
         ramp_step(target_khz);
 
-    sleep_ms(80);
+    /* Idle at the floor with the cap released: a tickless sleep only
+       delays noticing new PIO load by up to its deadline. */
+    if (target_khz > lo || ond_hold || ond_cap_khz < MAX_KHZ)
+        governor_request_tick(0);
 }
 
 static const Governor g = {
     .name = "ondemand",
     .init = ond_init,
     .tick = ond_tick,
+    .export_stats = ond_export_stats,
+    .tunables = &ond_tunables,
+    .sampling_rate_ms = &ond_params.sampling_rate_ms,
 };
 
 const Governor *governor_ondemand(void) { return &g; }
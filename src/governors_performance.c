@@ -1,11 +1,28 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "system.h"
-#include "hardware/vreg.h"
 #include "dmesg.h"
 #include "governors.h"
+#include "freq_policy.h"
+#include "gov_tunable.h"
 
-/* Performance governor: always aim for max frequency */
+/* Performance governor: always aim for the highest frequency the policy
+ * allows (scaling_max_khz) */
+
+/* Tunable parameters (adjustable at runtime via `gov tune performance`) */
+typedef struct {
+    uint32_t sampling_rate_ms;   /* tick period */
+} perf_params_t;
+
+static perf_params_t perf_params = {
+    .sampling_rate_ms = 200,
+};
+
+static const gov_tunable_t perf_desc[] = {
+    GOV_TUNABLE(perf_params_t, sampling_rate_ms, GOV_TUNABLE_U32, 10, 1000, "ms"),
+};
+
+static const gov_tunables_t perf_tunables = GOV_TUNABLES(perf_desc, perf_params);
 
 static uint32_t last_logged_target = 0;  /* Track to reduce logging spam */
 
@@ -18,22 +35,14 @@ static void perf_init(void)
 
 static void perf_tick(const metrics_agg_t *metrics)
 {
-    core1_wdt_ping++;
     (void)metrics;
     
-    /* Ensure we're always targeting MAX */
-    if (target_khz != MAX_KHZ) {
+    /* Ensure we're always targeting scaling_max */
+    uint32_t max_khz = freq_policy_max_khz();
+    if (target_khz != max_khz) {
         /* Pre-warm VREG for highest targets before switching */
-        if (MAX_KHZ > 250000) {
-#if defined(VREG_VOLTAGE_1_35)
-            vreg_set_voltage(VREG_VOLTAGE_1_35);
-#else
-            vreg_set_voltage(VREG_VOLTAGE_1_30);
-#endif
-        } else if (MAX_KHZ > 200000) {
-            vreg_set_voltage(VREG_VOLTAGE_1_20);
-        }
-        target_khz = MAX_KHZ;
+        vreg_prewarm(max_khz);
+        target_khz = max_khz;
         if (target_khz != last_logged_target) {
             dmesg_log("gov:performance ramp to MAX");
             last_logged_target = target_khz;
@@ -43,14 +52,14 @@ static void perf_tick(const metrics_agg_t *metrics)
     /* Non-blocking: ramp one step at a time instead of blocking */
     if (target_khz != current_khz)
         ramp_step(target_khz);
-    
-    sleep_ms(200);
 }
 
 static const Governor g = {
     .name = "performance",
     .init = perf_init,
     .tick = perf_tick,
+    .tunables = &perf_tunables,
+    .sampling_rate_ms = &perf_params.sampling_rate_ms,
 };
 
 const Governor *governor_performance(void) { return &g; }
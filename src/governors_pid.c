@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "system.h"
+#include "dmesg.h"
+#include "governors.h"
+#include "gov_tunable.h"
+#include "freq_policy.h"
+#include "pll_table.h"
+#include "pio_idle.h"
+#include "pid_ctrl.h"
+
+/* Closed-loop governor: hold Core 0's PIO-measured idle fraction (SM0) at
+ * a setpoint, e.g. 20% headroom.  Too little idle -> raise clk_sys, too
+ * much -> lower it.  Uses no app metrics, so it works for firmware that
+ * never calls metrics_submit().
+ *
+ * The PID (pid_ctrl.c) outputs kHz directly, bounded by the policy range
+ * so a thermal or user cap never winds it up; the output is snapped to
+ * the nearest achievable PLL frequency.  Inside the deadband the target
+ * is held to avoid dithering between neighbouring PLL entries.
+ *
+ * Without pio_idle_init() the idle fraction reads 0 and the loop settles
+ * at scaling_max, i.e. it degrades to the performance governor. */
+
+/* Tunable parameters (adjustable at runtime via `gov tune pid`) */
+typedef struct {
+    float    setpoint_pct;       /* target idle fraction, % */
+    float    kp;                 /* kHz per % idle error */
+    float    ki;                 /* kHz per %·s */
+    float    kd;                 /* kHz per %/s */
+    uint32_t d_tau_ms;           /* derivative low-pass */
+    float    deadband_pct;       /* hold target while |error| is below */
+    uint32_t sampling_rate_ms;   /* control period */
+} pid_params_t;
+
+static pid_params_t pid_params = {
+    .setpoint_pct     = 20.0f,
+    .kp               = 2000.0f,
+    .ki               = 8000.0f,
+    .kd               = 100.0f,
+    .d_tau_ms         = 200,
+    .deadband_pct     = 1.0f,
+    .sampling_rate_ms = 50,
+};
+
+/* Sorted by name (binary search in gov_tunable.c). */
+static const gov_tunable_t pid_desc[] = {
+    GOV_TUNABLE(pid_params_t, d_tau_ms,         GOV_TUNABLE_U32,   0,  5000,   "ms"),
+    GOV_TUNABLE(pid_params_t, deadband_pct,     GOV_TUNABLE_FLOAT, 0,  20,     "%"),
+    GOV_TUNABLE(pid_params_t, kd,               GOV_TUNABLE_FLOAT, 0,  10000,  "kHz*s/%"),
+    GOV_TUNABLE(pid_params_t, ki,               GOV_TUNABLE_FLOAT, 0,  100000, "kHz/(%*s)"),
+    GOV_TUNABLE(pid_params_t, kp,               GOV_TUNABLE_FLOAT, 0,  50000,  "kHz/%"),
+    GOV_TUNABLE(pid_params_t, sampling_rate_ms, GOV_TUNABLE_U32,   10, 1000,   "ms"),
+    GOV_TUNABLE(pid_params_t, setpoint_pct,     GOV_TUNABLE_FLOAT, 0,  90,     "%"),
+};
+
+static const gov_tunables_t pid_tunables = GOV_TUNABLES(pid_desc, pid_params);
+
+static pid_state_t pid_st;
+static uint64_t    pid_last_us = 0;
+static float       pid_last_idle = 0.0f;
+static float       pid_last_out = 0.0f;
+static uint32_t    pid_ticks = 0;
+static uint32_t    pid_sat_ticks = 0;
+static uint32_t    pid_retargets = 0;
+
+static void pid_export_stats(char *buf, size_t len)
+{
+    if (!buf || len == 0) return;
+    snprintf(buf, len,
+             "pid: idle=%.1f%% sp=%.1f%% out=%lukHz P=%.0f I=%.0f D=%.0f "
+             "sat=%lu/%lu retargets=%lu",
+             pid_last_idle, pid_params.setpoint_pct, (unsigned long)pid_last_out,
+             pid_st.p, pid_st.integ, pid_st.d,
+             (unsigned long)pid_sat_ticks, (unsigned long)pid_ticks,
+             (unsigned long)pid_retargets);
+}
+
+static void pid_init(void)
+{
+    /* Bumpless: the integrator starts at the current clock. */
+    pid_reset(&pid_st, (float)current_khz);
+    pid_last_us   = time_us_64();
+    pid_last_out  = (float)current_khz;
+    pid_ticks     = 0;
+    pid_sat_ticks = 0;
+    pid_retargets = 0;
+    target_khz    = current_khz;
+    dmesg_log("gov:pid initialized (idle-fraction setpoint)");
+}
+
+static void pid_tick(const metrics_agg_t *metrics)
+{
+    (void)metrics;      /* driven by PIO idle time, not app metrics */
+
+    uint64_t now = time_us_64();
+    float dt = (float)(now - pid_last_us) * 1e-6f;
+    pid_last_us = now;
+    if (dt < 0.001f) dt = 0.001f;
+    if (dt > 1.0f)   dt = 1.0f;     /* after a suspend: don't integrate the gap */
+
+    pio_idle_stats_t st;
+    pio_idle_get_stats(&st);
+    float idle = st.idle_fraction * 100.0f;
+
+    pid_cfg_t cfg = {
+        .kp      = pid_params.kp,
+        .ki      = pid_params.ki,
+        .kd      = pid_params.kd,
+        .d_tau_s = (float)pid_params.d_tau_ms * 1e-3f,
+        .out_min = (float)freq_policy_min_khz(),
+        .out_max = (float)freq_policy_max_khz(),
+    };
+    float out = pid_update(&cfg, &pid_st, pid_params.setpoint_pct, idle, dt);
+
+    pid_ticks++;
+    if (pid_st.saturated) pid_sat_ticks++;
+    pid_last_idle = idle;
+    pid_last_out  = out;
+
+    if (fabsf(pid_params.setpoint_pct - idle) >= pid_params.deadband_pct) {
+        const pll_entry_t *e = pll_table_nearest((uint32_t)(out + 0.5f));
+        uint32_t khz = e ? e->khz : (uint32_t)(out + 0.5f);
+        if (khz != target_khz) {
+            if (khz > current_khz) vreg_prewarm(khz);
+            target_khz = khz;
+            pid_retargets++;
+        }
+    }
+
+    if (target_khz != current_khz)
+        ramp_step(target_khz);
+
+    /* Idle time changes raise no event, so the loop never goes tickless. */
+    governor_request_tick(0);
+}
+
+static const Governor g = {
+    .name = "pid",
+    .init = pid_init,
+    .tick = pid_tick,
+    .export_stats = pid_export_stats,
+    .tunables = &pid_tunables,
+    .sampling_rate_ms = &pid_params.sampling_rate_ms,
+};
+
+const Governor *governor_pid(void) { return &g; }
@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "system.h"
+#include "dmesg.h"
+#include "governors.h"
+#include "gov_tunable.h"
+#include "freq_policy.h"
+#include "period_detect.h"
+
+/* Predictive governor for periodic load (e.g. a sensor burst every N ms).
+ *
+ * Reactive governors start ramping once a burst has begun and pay the
+ * whole ramp on every burst.  This one keeps the peak intensity per
+ * sampling_rate_ms bucket in a 128-sample ring, finds the period by
+ * autocorrelation (period_detect.c) and, once a burst onset has been seen,
+ * predicts the next one at onset + period.  It raises target_khz to
+ * scaling_max a learnt ramp time (+ lead_margin_ms) before the predicted
+ * onset and drops to scaling_min as soon as a bucket without burst
+ * activity follows the burst.
+ *
+ * Without a period (r below min_corr) it is simply reactive: max while a
+ * burst is in progress, min otherwise.
+ *
+ * A prediction is a hit when the onset arrives within max(2 samples,
+ * period/8) of it; lead is how long the clock had already reached the
+ * burst frequency when the burst started (late: it had not). */
+
+/* Tunable parameters (adjustable at runtime via `gov tune predictive`) */
+typedef struct {
+    uint32_t sampling_rate_ms;   /* tick period and history bucket */
+    float    burst_pct;          /* intensity that counts as a burst */
+    float    min_corr;           /* autocorrelation needed to trust a period */
+    uint32_t lead_margin_ms;     /* extra lead on top of the learnt ramp time */
+    uint32_t hold_ms;            /* stay up this long after a burst ends */
+} pred_params_t;
+
+static pred_params_t pred_params = {
+    .sampling_rate_ms = 10,
+    .burst_pct        = 50.0f,
+    .min_corr         = 0.6f,
+    .lead_margin_ms   = 5,
+    .hold_ms          = 0,
+};
+
+/* Sorted by name (binary search in gov_tunable.c). */
+static const gov_tunable_t pred_desc[] = {
+    GOV_TUNABLE(pred_params_t, burst_pct,        GOV_TUNABLE_FLOAT, 1,   100,  "%"),
+    GOV_TUNABLE(pred_params_t, hold_ms,          GOV_TUNABLE_U32,   0,   5000, "ms"),
+    GOV_TUNABLE(pred_params_t, lead_margin_ms,   GOV_TUNABLE_U32,   0,   1000, "ms"),
+    GOV_TUNABLE(pred_params_t, min_corr,         GOV_TUNABLE_FLOAT, 0.1, 1.0,  ""),
+    GOV_TUNABLE(pred_params_t, sampling_rate_ms, GOV_TUNABLE_U32,   2,   100,  "ms"),
+};
+
+static const gov_tunables_t pred_tunables = GOV_TUNABLES(pred_desc, pred_params);
+
+#define PRED_DETECT_EVERY   16u     /* samples between autocorrelation passes */
+#define PRED_MAX_LAG        64u
+#define PRED_MAX_MISSES     3u      /* consecutive misses before re-syncing */
+
+static period_hist_t hist;
+static uint32_t hist_sample_ms;
+static uint8_t  bucket_max;
+static uint64_t bucket_end_us;
+static uint32_t samples_since_detect;
+
+static uint32_t period_samples;     /* 0 = no period */
+static float    period_corr;
+
+static bool     in_burst;
+static uint64_t last_onset_us;
+static uint64_t burst_end_us;
+static uint64_t next_onset_us;      /* 0 = no prediction */
+static uint32_t miss_run;
+
+static bool     rising;             /* lo -> hi transition in progress */
+static uint64_t rise_start_us;
+static uint64_t ready_us;           /* when current_khz last reached hi */
+static uint64_t ramp_us_ema;        /* learnt lo -> hi ramp time */
+
+static uint32_t st_hits, st_misses, st_late;
+static uint64_t st_lead_us_sum;
+static uint32_t st_lead_n;
+
+static void pred_export_stats(char *buf, size_t len)
+{
+    if (!buf || len == 0) return;
+    uint32_t resolved = st_hits + st_misses;
+    snprintf(buf, len,
+             "predictive: period=%lums r=%.2f hits=%lu/%lu (%lu%%) lead=%lums late=%lu ramp=%lums",
+             (unsigned long)(period_samples * hist_sample_ms), period_corr,
+             (unsigned long)st_hits, (unsigned long)resolved,
+             (unsigned long)(resolved ? st_hits * 100u / resolved : 0u),
+             (unsigned long)(st_lead_n ? st_lead_us_sum / st_lead_n / 1000u : 0u),
+             (unsigned long)st_late, (unsigned long)(ramp_us_ema / 1000u));
+}
+
+static uint64_t period_us(void)
+{
+    return (uint64_t)period_samples * hist_sample_ms * 1000u;
+}
+
+static uint64_t hit_tolerance_us(void)
+{
+    uint64_t tol = 2ull * hist_sample_ms * 1000u;
+    uint64_t p8  = period_us() / 8u;
+    return p8 > tol ? p8 : tol;
+}
+
+static void pred_reset_history(uint64_t now)
+{
+    period_hist_reset(&hist);
+    hist_sample_ms       = pred_params.sampling_rate_ms;
+    bucket_max           = 0;
+    bucket_end_us        = now + (uint64_t)hist_sample_ms * 1000u;
+    samples_since_detect = 0;
+    period_samples       = 0;
+    period_corr          = 0.0f;
+    next_onset_us        = 0;
+    miss_run             = 0;
+}
+
+static void pred_init(void)
+{
+    uint64_t now = time_us_64();
+    pred_reset_history(now);
+    in_burst       = false;
+    last_onset_us  = 0;
+    burst_end_us   = 0;
+    rising         = false;
+    ready_us       = 0;
+    ramp_us_ema    = 50000;
+    st_hits = st_misses = st_late = 0;
+    st_lead_us_sum = 0;
+    st_lead_n      = 0;
+    target_khz     = freq_policy_min_khz();
+    dmesg_log("gov:predictive initialized");
+}
+
+static void pred_on_onset(uint64_t now, uint32_t hi_khz)
+{
+    if (next_onset_us) {
+        uint64_t err = now > next_onset_us ? now - next_onset_us : next_onset_us - now;
+        if (err <= hit_tolerance_us()) { st_hits++; miss_run = 0; }
+        else                           { st_misses++; miss_run++; }
+        if (current_khz >= hi_khz && ready_us) {
+            st_lead_us_sum += now - ready_us;
+            st_lead_n++;
+        } else {
+            st_late++;
+        }
+    }
+
+    in_burst      = true;
+    last_onset_us = now;
+    next_onset_us = period_samples ? now + period_us() : 0;
+}
+
+/* One completed history bucket. */
+static void pred_on_sample(uint8_t v, uint64_t now)
+{
+    period_hist_push(&hist, v);
+
+    if (in_burst && v < pred_params.burst_pct) {
+        in_burst     = false;
+        burst_end_us = now;
+    }
+
+    if (++samples_since_detect >= PRED_DETECT_EVERY) {
+        samples_since_detect = 0;
+        uint32_t p = period_detect(&hist, PRED_MAX_LAG, pred_params.min_corr, &period_corr);
+        if (p != period_samples) {
+            period_samples = p;
+            if (!p) {
+                next_onset_us = 0;
+            } else if (last_onset_us) {
+                next_onset_us = last_onset_us + period_us();
+                while (next_onset_us + hit_tolerance_us() < now) next_onset_us += period_us();
+            }
+            if (p) {
+                char buf[64];
+                snprintf(buf, sizeof(buf), "gov:predictive period %lums (r=%.2f)",
+                         (unsigned long)(period_us() / 1000u), period_corr);
+                dmesg_log(buf);
+            }
+        }
+    }
+}
+
+static void pred_tick(const metrics_agg_t *metrics)
+{
+    uint64_t now = time_us_64();
+    uint32_t hi = freq_policy_max_khz();
+    uint32_t lo = freq_policy_min_khz();
+
+    if (pred_params.sampling_rate_ms != hist_sample_ms || now > bucket_end_us + 1000000u)
+        pred_reset_history(now);     /* retuned, or resumed after a long gap */
+
+    float intensity = (metrics && metrics->count > 0) ? (float)metrics->avg_intensity : 0.0f;
+    if (intensity < 0.0f)   intensity = 0.0f;
+    if (intensity > 100.0f) intensity = 100.0f;
+    uint8_t v = (uint8_t)intensity;
+
+    /* Close the buckets that expired while we slept (tickless) with what
+       they held, before this tick's value: it belongs to the current one. */
+    while (now >= bucket_end_us) {
+        pred_on_sample(bucket_max, bucket_end_us);
+        bucket_max = 0;
+        bucket_end_us += (uint64_t)hist_sample_ms * 1000u;
+    }
+    if (v > bucket_max) bucket_max = v;
+
+    /* Onsets are timed per tick (the metrics doorbell wakes us), ends per
+       bucket so the gaps between submissions inside a burst don't count. */
+    if (!in_burst && intensity >= pred_params.burst_pct)
+        pred_on_onset(now, hi);
+
+    /* A predicted onset that never came. */
+    if (next_onset_us && !in_burst && now > next_onset_us + hit_tolerance_us()) {
+        st_misses++;
+        if (++miss_run >= PRED_MAX_MISSES) {
+            next_onset_us = 0;          /* wait for a fresh onset to re-sync */
+            miss_run = 0;
+        } else {
+            next_onset_us += period_us();
+        }
+    }
+
+    uint64_t lead_us = ramp_us_ema + (uint64_t)pred_params.lead_margin_ms * 1000u;
+    bool prep = next_onset_us && !in_burst && now + lead_us >= next_onset_us;
+    bool hold = burst_end_us && now < burst_end_us + (uint64_t)pred_params.hold_ms * 1000u;
+    bool want_hi = in_burst || prep || hold;
+
+    uint32_t t = want_hi ? hi : lo;
+    if (t != target_khz) {
+        if (want_hi) {
+            vreg_prewarm(hi);
+            rising        = true;
+            rise_start_us = now;
+            ready_us      = 0;
+        } else {
+            rising = false;
+        }
+        target_khz = t;
+    }
+
+    if (target_khz != current_khz)
+        ramp_step(target_khz);
+
+    /* Learn how long lo -> hi takes, so pre-ramping starts early enough. */
+    if (rising && current_khz >= hi) {
+        rising   = false;
+        ready_us = time_us_64();
+        ramp_us_ema = (ramp_us_ema * 3u + (ready_us - rise_start_us)) / 4u;
+    }
+
+    /* Step the ramp at full rate; while a burst is live keep sampling;
+       otherwise only the pre-ramp point needs a tick (buckets missed while
+       asleep are filled in as empty on the next one). */
+    if (target_khz != current_khz) {
+        governor_request_tick(1);
+    } else if (want_hi) {
+        governor_request_tick(0);
+    } else if (next_onset_us) {
+        uint64_t until_ms = next_onset_us > now + lead_us
+                          ? (next_onset_us - lead_us - now) / 1000u : 0u;
+        governor_request_tick(until_ms ? (uint32_t)until_ms : 1u);
+    }
+}
+
+static const Governor g = {
+    .name = "predictive",
+    .init = pred_init,
+    .tick = pred_tick,
+    .export_stats = pred_export_stats,
+    .tunables = &pred_tunables,
+    .sampling_rate_ms = &pred_params.sampling_rate_ms,
+};
+
+const Governor *governor_predictive(void) { return &g; }
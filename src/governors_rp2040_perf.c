@@ -1,10 +1,11 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
-#include "hardware/vreg.h"
 #include "system.h"
+#include "temp_service.h"
 #include "dmesg.h"
 #include "governors.h"
+#include "gov_tunable.h"
 #include "metrics.h"
 #include "pico/time.h"
 #include "governors_rp2040_perf.h"
@@ -22,8 +23,8 @@
  */
 
 
-/* Tunable parameters (adjustable at runtime via CLI) */
-static struct {
+/* Tunable parameters (adjustable at runtime via `gov tune rp2040_perf`) */
+typedef struct {
     uint32_t cooldown_ms;
     uint32_t ramp_up_cooldown_ms;
     double   thr_high_intensity;
@@ -37,7 +38,10 @@ static struct {
     uint32_t backoff_target_khz;
     uint32_t idle_target_khz;
     uint32_t idle_timeout_ms;
-} rp_params = {
+    uint32_t sampling_rate_ms;
+} rp_params_t;
+
+static rp_params_t rp_params = {
     .cooldown_ms = 2000,
     .ramp_up_cooldown_ms = 500,
     .thr_high_intensity = 80.0,
@@ -51,99 +55,52 @@ static struct {
     .backoff_target_khz = 200000,
     .idle_target_khz = 100000,
     .idle_timeout_ms = 5000,
+    .sampling_rate_ms = 40,
+};
+
+/* Sorted by name (binary search in gov_tunable.c). */
+static const gov_tunable_t rp_desc[] = {
+    GOV_TUNABLE(rp_params_t, backoff_target_khz,  GOV_TUNABLE_U32,    MIN_KHZ, MAX_KHZ, "kHz"),
+    GOV_TUNABLE(rp_params_t, cooldown_ms,         GOV_TUNABLE_U32,    0,       60000,   "ms"),
+    GOV_TUNABLE(rp_params_t, dur_high_ms,         GOV_TUNABLE_DOUBLE, 0,       10000,   "ms"),
+    GOV_TUNABLE(rp_params_t, dur_med_ms,          GOV_TUNABLE_DOUBLE, 0,       10000,   "ms"),
+    GOV_TUNABLE(rp_params_t, dur_short_ms,        GOV_TUNABLE_DOUBLE, 0,       10000,   "ms"),
+    GOV_TUNABLE(rp_params_t, idle_target_khz,     GOV_TUNABLE_U32,    MIN_KHZ, MAX_KHZ, "kHz"),
+    GOV_TUNABLE(rp_params_t, idle_timeout_ms,     GOV_TUNABLE_U32,    1000,    60000,   "ms"),
+    GOV_TUNABLE(rp_params_t, ramp_up_cooldown_ms, GOV_TUNABLE_U32,    100,     5000,    "ms"),
+    GOV_TUNABLE(rp_params_t, sampling_rate_ms,    GOV_TUNABLE_U32,    10,      1000,    "ms"),
+    GOV_TUNABLE(rp_params_t, temp_backoff_C,      GOV_TUNABLE_DOUBLE, 30,      100,     "C"),
+    GOV_TUNABLE(rp_params_t, temp_restore_C,      GOV_TUNABLE_DOUBLE, 30,      100,     "C"),
+    GOV_TUNABLE(rp_params_t, thr_high_intensity,  GOV_TUNABLE_DOUBLE, 0,       100,     "%"),
+    GOV_TUNABLE(rp_params_t, thr_low_intensity,   GOV_TUNABLE_DOUBLE, 0,       100,     "%"),
+    GOV_TUNABLE(rp_params_t, thr_med_intensity,   GOV_TUNABLE_DOUBLE, 0,       100,     "%"),
 };
 
+static const gov_tunables_t rp_tunables = GOV_TUNABLES(rp_desc, rp_params);
+
 
-/* Parameter helpers */
+/* Parameter helpers (kept for library users; `gov tune` is generic) */
 int rp2040_perf_set_param(const char *name, double val)
 {
-    if (!name) return -1;
-    /* simple validation and set, then persist */
-    if (strcmp(name, "cooldown_ms") == 0) { rp_params.cooldown_ms = (uint32_t)val; goto persist_and_ok; }
-    if (strcmp(name, "ramp_up_cooldown_ms") == 0) {
-        if (val < 100 || val > 5000) return -2;  /* sanity: 100ms - 5s */
-        rp_params.ramp_up_cooldown_ms = (uint32_t)val; goto persist_and_ok; }
-    if (strcmp(name, "thr_high_intensity") == 0) { rp_params.thr_high_intensity = val; goto persist_and_ok; }
-    if (strcmp(name, "thr_med_intensity") == 0) { rp_params.thr_med_intensity = val; goto persist_and_ok; }
-    if (strcmp(name, "thr_low_intensity") == 0) { rp_params.thr_low_intensity = val; goto persist_and_ok; }
-    if (strcmp(name, "dur_high_ms") == 0) { rp_params.dur_high_ms = val; goto persist_and_ok; }
-    if (strcmp(name, "dur_med_ms") == 0) { rp_params.dur_med_ms = val; goto persist_and_ok; }
-    if (strcmp(name, "dur_short_ms") == 0) { rp_params.dur_short_ms = val; goto persist_and_ok; }
-    if (strcmp(name, "temp_backoff_C") == 0) { rp_params.temp_backoff_C = val; goto persist_and_ok; }
-    if (strcmp(name, "temp_restore_C") == 0) { rp_params.temp_restore_C = val; goto persist_and_ok; }
-    if (strcmp(name, "backoff_target_khz") == 0) {
-        if (val < MIN_KHZ || val > MAX_KHZ) return -2;
-        rp_params.backoff_target_khz = (uint32_t)val; goto persist_and_ok; }
-    if (strcmp(name, "idle_target_khz") == 0) {
-        if (val < MIN_KHZ || val > MAX_KHZ) return -2;
-        rp_params.idle_target_khz = (uint32_t)val; goto persist_and_ok; }
-    if (strcmp(name, "idle_timeout_ms") == 0) {
-        if (val < 1000 || val > 60000) return -2;  /* sanity: 1-60 seconds */
-        rp_params.idle_timeout_ms = (uint32_t)val; goto persist_and_ok; }
-    return -1;
-
-
-persist_and_ok:
-    persist_save_rp_params(&rp_params, sizeof(rp_params));
-    return 0;
+    return gov_tunable_set(governor_rp2040_perf(), name, val);
 }
 
 
 int rp2040_perf_get_param(const char *name, double *out)
 {
-    if (!name || !out) return -1;
-    if (strcmp(name, "cooldown_ms") == 0) { *out = rp_params.cooldown_ms; return 0; }
-    if (strcmp(name, "ramp_up_cooldown_ms") == 0) { *out = rp_params.ramp_up_cooldown_ms; return 0; }
-    if (strcmp(name, "thr_high_intensity") == 0) { *out = rp_params.thr_high_intensity; return 0; }
-    if (strcmp(name, "thr_med_intensity") == 0) { *out = rp_params.thr_med_intensity; return 0; }
-    if (strcmp(name, "thr_low_intensity") == 0) { *out = rp_params.thr_low_intensity; return 0; }
-    if (strcmp(name, "dur_high_ms") == 0) { *out = rp_params.dur_high_ms; return 0; }
-    if (strcmp(name, "dur_med_ms") == 0) { *out = rp_params.dur_med_ms; return 0; }
-    if (strcmp(name, "dur_short_ms") == 0) { *out = rp_params.dur_short_ms; return 0; }
-    if (strcmp(name, "temp_backoff_C") == 0) { *out = rp_params.temp_backoff_C; return 0; }
-    if (strcmp(name, "temp_restore_C") == 0) { *out = rp_params.temp_restore_C; return 0; }
-    if (strcmp(name, "backoff_target_khz") == 0) { *out = rp_params.backoff_target_khz; return 0; }
-    if (strcmp(name, "idle_target_khz") == 0) { *out = rp_params.idle_target_khz; return 0; }
-    if (strcmp(name, "idle_timeout_ms") == 0) { *out = rp_params.idle_timeout_ms; return 0; }
-    return -1;
+    return gov_tunable_get(governor_rp2040_perf(), name, out);
 }
 
 
 void rp2040_perf_print_params(void)
 {
-    printf("rp2040_perf parameters:\n");
-    printf("  cooldown_ms         : %u\n", rp_params.cooldown_ms);
-    printf("  thr_high_intensity  : %.1f\n", rp_params.thr_high_intensity);
-    printf("  thr_med_intensity   : %.1f\n", rp_params.thr_med_intensity);
-    printf("  thr_low_intensity   : %.1f\n", rp_params.thr_low_intensity);
-    printf("  dur_high_ms         : %.1f\n", rp_params.dur_high_ms);
-    printf("  dur_med_ms          : %.1f\n", rp_params.dur_med_ms);
-    printf("  dur_short_ms        : %.1f\n", rp_params.dur_short_ms);
-    printf("  temp_backoff_C      : %.1f\n", rp_params.temp_backoff_C);
-    printf("  temp_restore_C      : %.1f\n", rp_params.temp_restore_C);
-    printf("  backoff_target_khz  : %u\n", rp_params.backoff_target_khz);
-    printf("  idle_target_khz     : %u\n", rp_params.idle_target_khz);
-    printf("  idle_timeout_ms     : %u (sustained inactivity before idle)\n", rp_params.idle_timeout_ms);
-    printf("  ramp_up_cooldown_ms : %u (fast ramp-up on high activity)\n", rp_params.ramp_up_cooldown_ms);
+    gov_tunables_print(governor_rp2040_perf());
 }
 
 
 void rp2040_perf_list_params(void)
 {
-    printf("Available params for rp2040_perf:\n");
-    printf("  cooldown_ms\n");
-    printf("  thr_high_intensity\n");
-    printf("  thr_med_intensity\n");
-    printf("  thr_low_intensity\n");
-    printf("  dur_high_ms\n");
-    printf("  dur_med_ms\n");
-    printf("  dur_short_ms\n");
-    printf("  temp_backoff_C\n");
-    printf("  temp_restore_C\n");
-    printf("  backoff_target_khz\n");
-    printf("  idle_target_khz\n");
-    printf("  idle_timeout_ms\n");
-    printf("  ramp_up_cooldown_ms\n");
+    gov_tunables_list(governor_rp2040_perf());
 }
 
 
@@ -172,25 +129,20 @@ static void rp_init(void)
     metrics_init();
 
 
-    /* Attempt to load persisted parameters if present */
-    if (persist_load_rp_params(&rp_params, sizeof(rp_params)) > 0) {
-        dmesg_log("gov:rp2040_perf loaded persisted params");
+    /* governors_init() restored the persisted params.  Older firmware
+       saved the same struct as a separate RPPP blob: adopt it once if no
+       per-governor record exists yet (the next `gov tune set` migrates it). */
+    static bool legacy_checked = false;
+    if (!legacy_checked) {
+        legacy_checked = true;
+        if (gov_tunables_load(governor_rp2040_perf()) < 0 &&
+            persist_load_rp_params(&rp_params, sizeof(rp_params)) > 0)
+            dmesg_log("gov:rp2040_perf loaded legacy params");
     }
 
 
     /* Pre-warm voltage to highest needed for MAX_KHZ */
-    if (MAX_KHZ > 250000) {
-#if defined(VREG_VOLTAGE_1_35)
-        vreg_set_voltage(VREG_VOLTAGE_1_35);
-        current_voltage_mv = 1350;
-#else
-        vreg_set_voltage(VREG_VOLTAGE_1_30);
-        current_voltage_mv = 1300;
-#endif
-    } else if (MAX_KHZ > 200000) {
-        vreg_set_voltage(VREG_VOLTAGE_1_20);
-        current_voltage_mv = 1200;
-    }
+    vreg_prewarm(MAX_KHZ);
 
 
     /* Start at conservative idle frequency; let activity ramp us up to MAX
@@ -204,7 +156,6 @@ static void rp_init(void)
 
 static void rp_tick(const metrics_agg_t *metrics)
 {
-    core1_wdt_ping++;
     /* Proactive adjustments based on app-submitted metrics */
     metrics_agg_t agg;
     uint32_t samples = 0;
@@ -241,24 +192,22 @@ static void rp_tick(const metrics_agg_t *metrics)
         bool high_activity = (agg.avg_intensity >= 90.0) ||
                             (agg.avg_intensity >= rp_params.thr_high_intensity && 
                              agg.avg_duration_ms >= rp_params.dur_high_ms);
+
+        /* Tail-aware: long, intense samples in the last ~100 ms count even
+         * when short ones dilute this tick's mean. */
+        metrics_stats_t st;
+        if (!high_activity && metrics_get_stats(&st)) {
+            const metrics_window_stats_t *w = &st.win[METRICS_WIN_100MS];
+            high_activity = (w->p95_intensity >= rp_params.thr_high_intensity &&
+                             w->p95_duration_ms >= rp_params.dur_high_ms);
+        }
         
         /* Exit idle state aggressively when high activity detected */
         if (rp_in_idle_state && high_activity) {
             rp_in_idle_state = false;
             dmesg_log("gov:rp2040_perf exiting idle on high activity");
             /* Pre-warm VREG for aggressive ramp-up */
-            if (MAX_KHZ > 250000) {
-#if defined(VREG_VOLTAGE_1_35)
-                vreg_set_voltage(VREG_VOLTAGE_1_35);
-                current_voltage_mv = 1350;
-#else
-                vreg_set_voltage(VREG_VOLTAGE_1_30);
-                current_voltage_mv = 1300;
-#endif
-            } else if (MAX_KHZ > 200000) {
-                vreg_set_voltage(VREG_VOLTAGE_1_20);
-                current_voltage_mv = 1200;
-            }
+            vreg_prewarm(MAX_KHZ);
         }
 
 
@@ -354,16 +303,18 @@ static void rp_tick(const metrics_agg_t *metrics)
     }
 
 
-    /* Monitor temperature; if too hot, reduce target quickly */
+    /* Monitor temperature; if too hot (or about to be), reduce target quickly */
     float temp = read_onboard_temperature();
-    if (temp > rp_params.temp_backoff_C && target_khz > rp_params.backoff_target_khz) {
+    float temp_pred = temp_service_predicted_c();
+    if (temp_pred > rp_params.temp_backoff_C && target_khz > rp_params.backoff_target_khz) {
         target_khz = rp_params.backoff_target_khz;
         rp_in_idle_state = false;  /* exiting idle on thermal backoff */
         dmesg_log("gov:rp2040_perf thermal backoff (param)");
         rp_last_adjust_ms = now_ms;
         rp_last_target_set = target_khz;
         rp_adjust_count++;
-    } else if (temp < rp_params.temp_restore_C && target_khz < MAX_KHZ && !rp_in_idle_state) {
+    } else if (temp < rp_params.temp_restore_C && temp_pred < rp_params.temp_restore_C &&
+               target_khz < MAX_KHZ && !rp_in_idle_state) {
         /* restore aggressive target only if cooled AND not in idle state */
         target_khz = MAX_KHZ;
         dmesg_log("gov:rp2040_perf restoring target -> MAX");
@@ -378,8 +329,10 @@ static void rp_tick(const metrics_agg_t *metrics)
     }
 
 
-    /* Small sleep to keep tick responsive but not spin */
-    sleep_ms(40);
+    /* Outside the idle state the inactivity timeout and thermal restore
+       are time-driven: keep sampling.  Idle is settled until metrics. */
+    if (!rp_in_idle_state)
+        governor_request_tick(0);
 }
 
 
@@ -388,6 +341,8 @@ static const Governor g = {
     .init = rp_init,
     .tick = rp_tick,
     .export_stats = rp_export_stats,
+    .tunables = &rp_tunables,
+    .sampling_rate_ms = &rp_params.sampling_rate_ms,
 };
 
 
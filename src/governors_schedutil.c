@@ -1,104 +1,188 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "system.h"
-#include "hardware/vreg.h"
 #include "dmesg.h"
 #include "governors.h"
+#include "gov_tunable.h"
+#include "pll_table.h"
 
-/* Schedutil-style governor: try to follow a 'utilization' estimate.
-   Scales frequency proportionally to workload intensity. */
+/* Schedutil-style governor, after Linux's cpufreq_schedutil:
+ *
+ *   util   app-reported busy share (avg_intensity) made frequency
+ *          invariant: busy × current_khz / MAX_KHZ, the share of the
+ *          fastest clock the same work would occupy
+ *   boost  I/O-wait boost: iowait_boost_min_pct on the first tick that
+ *          sees metrics_submit_iowait() flags, doubled on each further
+ *          one up to 100 %, halved on every tick without, dropped once
+ *          below the minimum
+ *   next   headroom_pct × max(util, boost) × MAX_KHZ, rounded up to an
+ *          achievable PLL frequency
+ *
+ * Work that keeps the core busy 100/headroom_pct of the time at the new
+ * clock maps back to that same clock, so a steady load settles instead of
+ * chasing its own busy share.  Without metrics the target holds, then
+ * backs off step by step once idle_hold_ms has passed. */
+
+/* Tunable parameters (adjustable at runtime via `gov tune schedutil`) */
+typedef struct {
+    uint32_t busy_util;          /* busy share above this counts as activity */
+    uint32_t headroom_pct;       /* next = util × this (Linux: 125) */
+    uint32_t hysteresis_pct;     /* retarget only on a larger move (% of MAX_KHZ) */
+    uint32_t iowait_boost_min_pct; /* first I/O-wait boost, 0 = off */
+    float    idle_cool_C;        /* idle backoff only below this temperature */
+    uint32_t idle_hold_ms;       /* ... and this long after the last activity */
+    uint32_t idle_backoff_ms;    /* between idle backoff steps */
+    uint32_t sampling_rate_ms;   /* tick period */
+} sch_params_t;
+
+static sch_params_t sch_params = {
+    .busy_util            = 50,
+    .headroom_pct         = 125,
+    .hysteresis_pct       = 3,
+    .iowait_boost_min_pct = 50,
+    .idle_cool_C          = 48.0f,
+    .idle_hold_ms         = 2000,
+    .idle_backoff_ms      = 500,
+    .sampling_rate_ms     = 60,
+};
+
+/* Sorted by name (binary search in gov_tunable.c). */
+static const gov_tunable_t sch_desc[] = {
+    GOV_TUNABLE(sch_params_t, busy_util,            GOV_TUNABLE_U32,   0,   100,   "%"),
+    GOV_TUNABLE(sch_params_t, headroom_pct,         GOV_TUNABLE_U32,   100, 200,   "%"),
+    GOV_TUNABLE(sch_params_t, hysteresis_pct,       GOV_TUNABLE_U32,   0,   50,    "%"),
+    GOV_TUNABLE(sch_params_t, idle_backoff_ms,      GOV_TUNABLE_U32,   10,  10000, "ms"),
+    GOV_TUNABLE(sch_params_t, idle_cool_C,          GOV_TUNABLE_FLOAT, 20,  100,   "C"),
+    GOV_TUNABLE(sch_params_t, idle_hold_ms,         GOV_TUNABLE_U32,   0,   60000, "ms"),
+    GOV_TUNABLE(sch_params_t, iowait_boost_min_pct, GOV_TUNABLE_U32,   0,   100,   "%"),
+    GOV_TUNABLE(sch_params_t, sampling_rate_ms,     GOV_TUNABLE_U32,   10,  1000,  "ms"),
+};
+
+static const gov_tunables_t sch_tunables = GOV_TUNABLES(sch_desc, sch_params);
 
 static uint64_t last_high_util_us = 0;
-static const uint64_t idle_backoff_cooldown_us = 500000;  /* 500ms between idle backoffs */
 static uint64_t last_idle_backoff_us = 0;
 static uint32_t last_logged_target = 0;  /* Track to reduce logging spam */
+static float    sch_util = 0.0f;         /* last invariant util, % of MAX_KHZ */
+static uint32_t sch_boost = 0;           /* I/O-wait boost, % of MAX_KHZ */
+static uint32_t sch_retargets = 0;
+static uint32_t sch_boosts = 0;          /* ticks that started a boost */
 
-static void sch_init(void) { 
+static void sch_export_stats(char *buf, size_t len)
+{
+    if (!buf || len == 0) return;
+    snprintf(buf, len, "schedutil: util=%.1f%% iowait_boost=%u%% retargets=%u boosts=%u",
+             sch_util, sch_boost, sch_retargets, sch_boosts);
+}
+
+static void sch_init(void) {
     last_high_util_us = to_us_since_boot(get_absolute_time());
     last_idle_backoff_us = to_us_since_boot(get_absolute_time());
     target_khz = MIN_KHZ;  /* Start at idle frequency */
     last_logged_target = MIN_KHZ;
+    sch_util = 0.0f;
+    sch_boost = 0;
     dmesg_log("gov:schedutil initialized at idle");
 }
 
+/* Double on every tick with I/O-wait flags, halve on every tick without. */
+static void sch_update_boost(uint32_t iowait)
+{
+    uint32_t min = sch_params.iowait_boost_min_pct;
+    if (min == 0) {
+        sch_boost = 0;
+    } else if (iowait) {
+        if (!sch_boost) sch_boosts++;
+        sch_boost = sch_boost ? sch_boost * 2u : min;
+        if (sch_boost > 100u) sch_boost = 100u;
+    } else if (sch_boost) {
+        sch_boost /= 2u;
+        if (sch_boost < min) sch_boost = 0;
+    }
+}
+
+/* headroom × util of MAX_KHZ, rounded up to a PLL frequency. */
+static uint32_t sch_next_khz(float util)
+{
+    float khz = (float)MAX_KHZ * util / 100.0f * (float)sch_params.headroom_pct / 100.0f;
+    if (khz <= (float)MIN_KHZ) return MIN_KHZ;
+    if (khz >= (float)MAX_KHZ) return MAX_KHZ;
+    const pll_entry_t *e = pll_table_ceil((uint32_t)khz);
+    return e ? e->khz : MAX_KHZ;
+}
+
+static void sch_set_target(uint32_t next, const char *why)
+{
+    target_khz = next;
+    sch_retargets++;
+    if (target_khz != last_logged_target) {
+        char buf[96];
+        snprintf(buf, sizeof(buf), "gov:schedutil target -> %u kHz (%s, util=%.0f%% boost=%u%%)",
+                 next, why, sch_util, sch_boost);
+        dmesg_log(buf);
+        last_logged_target = target_khz;
+    }
+}
+
 static void sch_tick(const metrics_agg_t *metrics)
 {
-    core1_wdt_ping++;
-    float temp = read_onboard_temperature();
     uint64_t now_us = to_us_since_boot(get_absolute_time());
-
-    /* Prefer app-reported utilization if available */
-    int util;
     bool has_metrics = (metrics && metrics->count > 0);
-    
+
+    sch_update_boost(metrics ? metrics->iowait : 0);
+
     if (has_metrics) {
-        util = (int)metrics->avg_intensity;
-        char buf[80];
-        snprintf(buf, sizeof(buf), "gov:schedutil metrics (util=%d%%)", util);
-        dmesg_log(buf);
-        if (util > 50)
+        float busy = (float)metrics->avg_intensity;
+        if (busy < 0.0f) busy = 0.0f;
+        if (busy > 100.0f) busy = 100.0f;
+        if (busy > (float)sch_params.busy_util)
             last_high_util_us = now_us;  /* Track when we last saw meaningful activity */
-    } else {
-        /* No metrics: use conservative temperature-based estimate with hysteresis */
-        util = (int) ( (temp - 32.0f) * 0.5f );  /* More conservative scaling */
+        sch_util = busy * (float)current_khz / (float)MAX_KHZ;
     }
-    if (util < 0) util = 0;
-    if (util > 100) util = 100;
-
-    /* Only update target if change is >5% (hysteresis) to avoid oscillation */
-    uint32_t target = MIN_KHZ + (uint32_t)((MAX_KHZ - MIN_KHZ) * util / 100);
-    if (target > MAX_KHZ) target = MAX_KHZ;
-    if (target < MIN_KHZ) target = MIN_KHZ;
-
-    /* Hysteresis: only change if >5% difference from current target */
-    uint32_t current_target_percent = (target_khz - MIN_KHZ) * 100 / (MAX_KHZ - MIN_KHZ);
-    if (target_khz != target && (uint32_t)util > current_target_percent + 5 || (uint32_t)util < current_target_percent - 5) {
-        target_khz = target;
-        if (target_khz != last_logged_target) {
-            char buf[80];
-            snprintf(buf, sizeof(buf), "gov:schedutil target -> %u kHz (util=%d%%)", target, util);
-            dmesg_log(buf);
-            last_logged_target = target_khz;
-        }
-    }
-    
-    /* Idle backoff: if no high util seen for 2s and cool, slowly decay */
-    if (!has_metrics && util < 20 && temp < 48.0f && target_khz > MIN_KHZ &&
-        (now_us - last_high_util_us > 2000000) &&
-        (now_us - last_idle_backoff_us >= idle_backoff_cooldown_us)) {
-        target_khz -= 10000;
-        if (target_khz < MIN_KHZ) target_khz = MIN_KHZ;
+
+    if (has_metrics || sch_boost) {
+        float util = has_metrics ? sch_util : 0.0f;
+        if ((float)sch_boost > util) util = (float)sch_boost;
+        uint32_t next = sch_next_khz(util);
+
+        /* Hysteresis on the frequency itself; the ends of the range are
+           always reachable. */
+        uint32_t band = MAX_KHZ / 100u * sch_params.hysteresis_pct;
+        uint32_t diff = next > target_khz ? next - target_khz : target_khz - next;
+        if (next != target_khz &&
+            (diff > band || next == MIN_KHZ || next == MAX_KHZ))
+            sch_set_target(next, sch_boost && (float)sch_boost >= sch_util ? "iowait" : "util");
+        last_idle_backoff_us = now_us;
+    } else if (read_onboard_temperature() < sch_params.idle_cool_C && target_khz > MIN_KHZ &&
+               (now_us - last_high_util_us > (uint64_t)sch_params.idle_hold_ms * 1000u) &&
+               (now_us - last_idle_backoff_us >= (uint64_t)sch_params.idle_backoff_ms * 1000u)) {
+        /* Idle backoff: no metrics for idle_hold_ms and cool, slowly decay */
+        uint32_t next = target_khz > MIN_KHZ + 10000u ? target_khz - 10000u : MIN_KHZ;
         last_idle_backoff_us = now_us;
-        if (target_khz != last_logged_target) {
-            dmesg_log("gov:schedutil idle backoff");
-            last_logged_target = target_khz;
-        }
+        sch_util = 0.0f;
+        sch_set_target(next, "idle");
     }
 
     /* Non-blocking: ramp one step at a time instead of blocking */
     /* Pre-warm VREG on significant upscales */
-    if (target_khz > current_khz) {
-        if (target_khz > 250000) {
-#if defined(VREG_VOLTAGE_1_35)
-            vreg_set_voltage(VREG_VOLTAGE_1_35);
-#else
-            vreg_set_voltage(VREG_VOLTAGE_1_30);
-#endif
-        } else if (target_khz > 200000) {
-            vreg_set_voltage(VREG_VOLTAGE_1_20);
-        }
-    }
+    if (target_khz > current_khz)
+        vreg_prewarm(target_khz);
 
     if (target_khz != current_khz)
         ramp_step(target_khz);
 
-    sleep_ms(60);
+    /* Settled at the floor with no app metrics; otherwise keep sampling. */
+    if (has_metrics || sch_boost || target_khz > MIN_KHZ)
+        governor_request_tick(0);
 }
 
 static const Governor g = {
     .name = "schedutil",
     .init = sch_init,
     .tick = sch_tick,
+    .export_stats = sch_export_stats,
+    .tunables = &sch_tunables,
+    .sampling_rate_ms = &sch_params.sampling_rate_ms,
 };
 
 const Governor *governor_schedutil(void) { return &g; }
@@ -16,6 +16,15 @@
 #include "system.h"
 #include "commands.h"
 #include "pio_idle.h"   /* PIO idle-time measurement + heartbeat jitter */
+#include "pll_table.h"  /* precomputed PLL divisors for ramp_step() */
+#include "safepoint.h"  /* cooperative Core 0 parking for PLL changes */
+#include "vreg_cal.h"   /* calibrated per-band VREG table */
+#include "temp_service.h" /* DMA-fed ADC temperature filter */
+#include "freq_stats.h" /* time-in-state + transition table */
+#include "energy.h"     /* V/f power model + energy integration */
+#include "freq_boost.h" /* time-bounded frequency floor */
+#include "freq_policy.h" /* scaling min/max from named constraints */
+#include "rt_task.h"    /* periodic tasks for the deadline governor */
 
 int main(void)
 {
@@ -31,16 +40,37 @@ int main(void)
 
     dmesg_init();
 
+    /* Temperature service: ADC ch4 free-runs into a DMA ring from here on;
+     * nothing else may call adc_select_input()/adc_read(). */
+    temp_service_init();
+
     /* PIO subsystem: install programs, claim SM0+SM1 on PIO0, start SMs.
      * Must happen BEFORE multicore_launch_core1() so both output GPIOs are
      * configured before Core 1 starts reading pio_idle_safe_to_scale(). */
     pio_idle_init();
 
+    /* Enumerate every PLL-achievable frequency in [MIN_KHZ, MAX_KHZ] once,
+     * before Core 1 can issue its first ramp_step(). */
+    pll_table_init();
+
+    /* Time-in-state accounting starts at the boot clock. */
+    freq_stats_init(current_khz);
+    freq_boost_init();
+    rt_task_init();
+    freq_policy_init();
+
+    /* Energy estimate integrates from the boot operating point. */
+    energy_init();
+
+    /* Load the calibrated VREG table (if any) before the first ramp. */
+    vreg_cal_init();
+
     printf("\n--- RP2040 Minishell (boot) ---\n");
     printf("Initial clock : %.2f MHz\n", clock_get_hz(clk_sys) / 1e6f);
     dmesg_log("System boot complete");
 
     multicore_lockout_victim_init();
+    safepoint_init();
     multicore_launch_core1(core1_entry);
 
     printf("Type 'help' for available commands.\n");
@@ -57,6 +87,10 @@ int main(void)
     fflush(stdout);
 
     while (true) {
+        /* ---- Safe point: acknowledge a pending PLL change (if the
+         * cooperative handshake is enabled) before touching USB. ------- */
+        safepoint_poll();
+
         /* ---- Heartbeat pulse: SM1 measures the period between these. ----
          * One pulse per loop iteration.  Place it before the getchar call
          * so the measured period captures the full iteration time including
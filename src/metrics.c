@@ -1,56 +1,232 @@
 #include "metrics.h"
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
+#include "pico/stdlib.h"
 #include "pico/time.h"
 #include "pico/sync.h"
+#include "hardware/sync.h"
+#include "seqlock.h"
 
-/* Kernel snapshot storage */
+/* Kernel snapshot storage: written by Core 1 only, read lock-free. */
 static kernel_metrics_t kernel_snap;
-static mutex_t kernel_lock;
-static int kernel_inited = 0;
+static seqlock_t        kernel_lock = SEQLOCK_INIT;
 
-/* Simple fixed-size ring buffer for submitted metrics */
-#define METRICS_BUF_SZ 128
+/* Per-producer sample rings
+ *
+ * One ring per (core, context): Core 0 thread, Core 1 thread, Core 0 IRQ,
+ * Core 1 IRQ.  Each ring has exactly one producer at a time (an IRQ on the
+ * same core cannot interleave with its own ring's thread-mode producer), so
+ * submission needs no lock and is safe from interrupt handlers.
+ *
+ * Besides the last METRICS_RING_SZ records, each ring keeps monotonic
+ * running sums.  The consumer remembers the sums it saw at its last clear
+ * (baseline), so an aggregate is a subtraction per ring: O(1) in the
+ * number of samples.  A per-ring seqlock (the producer is the single
+ * writer) lets readers on either core take a consistent copy.
+ *
+ * Sums are kept per ring and, within a ring, per registered source, so
+ * aggregation can weight or drop sources without touching the producers.
+ * The intensity/duration histograms are monotonic counters in the same
+ * way (fed only by sources with a non-zero weight at submit time);
+ * metrics_stats_update() keeps its own baseline of them.
+ */
+#define METRICS_RING_SZ 32u   /* power of two */
 
 typedef struct {
     uint32_t workload;
     uint32_t intensity;
     uint32_t duration_ms;
     uint32_t ts_ms;
+    uint8_t  src;
 } metric_rec_t;
 
-static metric_rec_t buf[METRICS_BUF_SZ];
-static uint32_t head = 0;
-static uint32_t tail = 0;
-static uint32_t cnt = 0;
-static mutex_t metrics_lock;
+typedef struct {
+    uint32_t head;           /* samples ever submitted (wraps) */
+    uint64_t sum_work;
+    uint64_t sum_int;
+    uint64_t sum_dur;
+    uint32_t last_ts_ms;
+    uint32_t iowait;         /* metrics_submit_iowait() calls (wraps) */
+} ring_totals_t;
+
+#define HIST_INT 0u
+#define HIST_DUR 1u
+
+typedef struct {
+    uint32_t c[2][METRICS_HIST_BUCKETS];   /* [HIST_INT / HIST_DUR] */
+} ring_hist_t;
+
+typedef struct {
+    ring_totals_t tot;                          /* all sources */
+    ring_totals_t src[METRICS_MAX_SOURCES];
+} ring_sums_t;
+
+/* Everything published under the ring's seqlock.  Readers that
+ * do not need the histograms copy only a prefix. */
+typedef struct {
+    ring_sums_t   sums;
+    ring_hist_t   hist;
+} ring_state_t;
+
+typedef struct {
+    seqlock_t         lock;
+    ring_state_t      st;
+    metric_rec_t      rec[METRICS_RING_SZ];
+} metrics_ring_t;
+
+static metrics_ring_t rings[METRICS_RINGS];
+static ring_totals_t  baseline[METRICS_RINGS][METRICS_MAX_SOURCES]; /* consumer-owned */
 static int metrics_inited = 0;
 
+/* Source registry.  Slots are append-only; a handle is its slot index. */
+static char              src_names[METRICS_MAX_SOURCES][METRICS_SOURCE_NAME_LEN] = { "default" };
+static volatile uint32_t src_weight[METRICS_MAX_SOURCES] = { METRICS_WEIGHT_DEFAULT };
+static volatile uint32_t src_count = 1;
+static critical_section_t src_lock;
+
+static const char *const ring_names[METRICS_RINGS] = {
+    "core0", "core1", "core0_irq", "core1_irq",
+};
+
+/* Doorbell: submit stamp of the first unserved high-intensity sample. */
+static volatile uint32_t wake_threshold = METRICS_WAKE_DEFAULT_INTENSITY;
+static volatile uint32_t wake_stamp_us  = 0;
+
 void metrics_init(void)
 {
+    /* Rings and baselines are zero-initialised statics, so submissions
+     * made before (or racing) the first init are never lost. */
     if (metrics_inited) return;
-    mutex_init(&metrics_lock);
-    head = tail = cnt = 0;
     metrics_inited = 1;
-    if (!kernel_inited) {
-        mutex_init(&kernel_lock);
-        memset(&kernel_snap, 0, sizeof(kernel_snap));
-        kernel_inited = 1;
-    }
+    critical_section_init(&src_lock);
+}
+
+static inline uint32_t ring_index(void)
+{
+    uint32_t idx = get_core_num();
+    if (__get_current_exception() != 0) idx += 2u;   /* handler mode */
+    return idx;
+}
+
+/* Histogram bucket: 0..3 exact, then 4 sub-buckets per power of two up
+ * to 65535, then one overflow bucket. */
+static inline uint32_t hist_bucket(uint32_t v)
+{
+    if (v < 4u) return v;
+    uint32_t oct = 31u - (uint32_t)__builtin_clz(v);
+    if (oct >= 16u) return METRICS_HIST_BUCKETS - 1u;
+    return 4u + (oct - 2u) * 4u + ((v >> (oct - 2u)) & 3u);
+}
+
+/* Largest value that maps to bucket b. */
+static uint32_t hist_upper(uint32_t b)
+{
+    if (b < 4u) return b;
+    if (b >= METRICS_HIST_BUCKETS - 1u) return 65536u;
+    uint32_t shift = (b - 4u) / 4u;
+    uint32_t lo    = (4u + ((b - 4u) & 3u)) << shift;
+    return lo + (1u << shift) - 1u;
+}
+
+/* Consistent copy of the first `len` bytes of a ring's state. */
+static inline void ring_copy(const metrics_ring_t *r, void *dst, size_t len)
+{
+    seqlock_read(&r->lock, dst, &r->st, len);
+}
+
+static inline void ring_read_totals(const metrics_ring_t *r, ring_totals_t *out)
+{
+    ring_copy(r, out, sizeof(*out));
+}
+
+/* One source's totals: sources are independent, so readers that walk
+ * them copy one at a time instead of a whole ring_sums_t (~360 B) on
+ * the stack. */
+static inline void ring_read_src(const metrics_ring_t *r, uint32_t s, ring_totals_t *out)
+{
+    seqlock_read(&r->lock, out, &r->st.sums.src[s], sizeof(*out));
+}
+
+
+static inline void totals_add(ring_totals_t *t, uint32_t workload,
+                              uint32_t intensity, uint32_t duration_ms, uint32_t ts)
+{
+    t->head++;
+    t->sum_work += workload;
+    t->sum_int  += intensity;
+    t->sum_dur  += duration_ms;
+    t->last_ts_ms = ts;
 }
 
 void metrics_submit(uint32_t workload, uint32_t intensity, uint32_t duration_ms)
 {
-    if (!metrics_inited) metrics_init();
+    metrics_submit_src(METRICS_SOURCE_DEFAULT, workload, intensity, duration_ms);
+}
+
+void metrics_submit_src(metrics_source_t src, uint32_t workload,
+                        uint32_t intensity, uint32_t duration_ms)
+{
+    if (src < 0 || (uint32_t)src >= src_count) src = METRICS_SOURCE_DEFAULT;
+    uint32_t weight = src_weight[src];
     uint32_t ts = to_ms_since_boot(get_absolute_time());
-    mutex_enter_blocking(&metrics_lock);
-    buf[head].workload = workload;
-    buf[head].intensity = intensity;
-    buf[head].duration_ms = duration_ms;
-    buf[head].ts_ms = ts;
-    head = (head + 1) & (METRICS_BUF_SZ - 1);
-    if (cnt < METRICS_BUF_SZ) cnt++; else tail = head; /* overwrite oldest */
-    mutex_exit(&metrics_lock);
+    metrics_ring_t *r = &rings[ring_index()];
+
+    seqlock_write_begin(&r->lock);
+    metric_rec_t *rec = &r->rec[r->st.sums.tot.head & (METRICS_RING_SZ - 1u)];
+    rec->workload    = workload;
+    rec->intensity   = intensity;
+    rec->duration_ms = duration_ms;
+    rec->ts_ms       = ts;
+    rec->src         = (uint8_t)src;
+    totals_add(&r->st.sums.tot, workload, intensity, duration_ms, ts);
+    totals_add(&r->st.sums.src[src], workload, intensity, duration_ms, ts);
+    if (weight) {
+        r->st.hist.c[HIST_INT][hist_bucket(intensity)]++;
+        r->st.hist.c[HIST_DUR][hist_bucket(duration_ms)]++;
+    }
+    seqlock_write_end(&r->lock);
+
+    uint32_t thr = wake_threshold;
+    if (weight && thr && intensity >= thr && wake_stamp_us == 0) {
+        wake_stamp_us = time_us_32() | 1u;  /* 0 means "not pending" */
+        __sev();
+    }
+}
+
+void metrics_submit_iowait(metrics_source_t src)
+{
+    if (src < 0 || (uint32_t)src >= src_count) src = METRICS_SOURCE_DEFAULT;
+    metrics_ring_t *r = &rings[ring_index()];
+
+    seqlock_write_begin(&r->lock);
+    r->st.sums.tot.iowait++;
+    r->st.sums.src[src].iowait++;
+    seqlock_write_end(&r->lock);
+}
+
+void metrics_set_wake_threshold(uint32_t intensity)
+{
+    wake_threshold = intensity;
+}
+
+uint32_t metrics_get_wake_threshold(void)
+{
+    return wake_threshold;
+}
+
+int metrics_wake_pending(void)
+{
+    return wake_stamp_us != 0;
+}
+
+uint32_t metrics_wake_take(void)
+{
+    /* Single consumer (Core 1); a submit racing this store at worst rings
+     * again for a sample the coming tick already sees. */
+    uint32_t ts = wake_stamp_us;
+    wake_stamp_us = 0;
+    return ts;
 }
 
 uint32_t metrics_get_aggregate(metrics_agg_t *out, int clear)
@@ -58,26 +234,33 @@ uint32_t metrics_get_aggregate(metrics_agg_t *out, int clear)
     if (!metrics_inited) metrics_init();
     if (!out) return 0;
     uint32_t local_cnt = 0;
+    uint64_t w_cnt = 0;
     uint64_t sum_work = 0;
     uint64_t sum_int = 0;
     uint64_t sum_dur = 0;
     uint32_t last_ts = 0;
+    uint32_t iowait = 0;
+    uint32_t nsrc = src_count;
 
-    mutex_enter_blocking(&metrics_lock);
-    uint32_t i = tail;
-    for (uint32_t n = 0; n < cnt; ++n) {
-        metric_rec_t *r = &buf[i];
-        sum_work += r->workload;
-        sum_int  += r->intensity;
-        sum_dur  += r->duration_ms;
-        last_ts = r->ts_ms;
-        i = (i + 1) & (METRICS_BUF_SZ - 1);
-        local_cnt++;
-    }
-    if (clear) {
-        head = tail = cnt = 0;
+    for (uint32_t i = 0; i < METRICS_RINGS; ++i) {
+        for (uint32_t s = 0; s < nsrc; ++s) {
+            ring_totals_t cur;
+            ring_read_src(&rings[i], s, &cur);
+            const ring_totals_t *c = &cur, *b = &baseline[i][s];
+            uint32_t n = c->head - b->head;
+            uint32_t w = src_weight[s];
+            if (w != 0) iowait += c->iowait - b->iowait;
+            if (n != 0 && w != 0) {
+                local_cnt += n;
+                w_cnt     += (uint64_t)w * n;
+                sum_work  += w * (c->sum_work - b->sum_work);
+                sum_int   += w * (c->sum_int  - b->sum_int);
+                sum_dur   += w * (c->sum_dur  - b->sum_dur);
+                if (c->last_ts_ms > last_ts) last_ts = c->last_ts_ms;
+            }
+            if (clear) baseline[i][s] = *c;
+        }
     }
-    mutex_exit(&metrics_lock);
 
     if (local_cnt == 0) {
         out->count = 0;
@@ -85,36 +268,281 @@ uint32_t metrics_get_aggregate(metrics_agg_t *out, int clear)
         out->avg_intensity = 0.0;
         out->avg_duration_ms = 0.0;
         out->last_ts_ms = 0;
+        out->iowait = iowait;
         return 0;
     }
 
     out->count = local_cnt;
-    out->avg_workload = (double)sum_work / (double)local_cnt;
-    out->avg_intensity = (double)sum_int / (double)local_cnt;
-    out->avg_duration_ms = (double)sum_dur / (double)local_cnt;
+    out->iowait = iowait;
+    out->avg_workload = (double)sum_work / (double)w_cnt;
+    out->avg_intensity = (double)sum_int / (double)w_cnt;
+    out->avg_duration_ms = (double)sum_dur / (double)w_cnt;
     out->last_ts_ms = last_ts;
     return local_cnt;
 }
 
-void metrics_publish_kernel(const kernel_metrics_t *snap)
+/* --------------------------------------------------------------------------
+ * Decaying multi-window statistics (Core 1 writes, either core reads)
+ * -------------------------------------------------------------------------- */
+
+typedef struct {
+    float hist[2][METRICS_HIST_BUCKETS];
+    float n;
+    float s_work, s_int, s_dur;
+} decay_win_t;
+
+static const uint32_t win_horizon_ms[METRICS_WINDOWS] = { 100u, 1000u, 10000u };
+
+static decay_win_t   win[METRICS_WINDOWS];
+static ring_state_t  stats_base[METRICS_RINGS];
+static uint32_t      stats_last_us;
+
+static seqlock_t         stats_lock = SEQLOCK_INIT;
+static metrics_stats_t   stats_pub;
+
+/* Smallest bucket whose cumulative weight reaches `target`. */
+static uint32_t hist_percentile(const float *h, float total, float p)
+{
+    float target = total * p, acc = 0.0f;
+    for (uint32_t b = 0; b < METRICS_HIST_BUCKETS; ++b) {
+        acc += h[b];
+        if (acc >= target && acc > 0.0f) return hist_upper(b);
+    }
+    return 0;
+}
+
+static uint32_t hist_max(const float *h)
+{
+    for (uint32_t b = METRICS_HIST_BUCKETS; b-- > 0; )
+        if (h[b] >= 0.5f) return hist_upper(b);
+    return 0;
+}
+
+static inline uint32_t clamp_pct(uint32_t v)
+{
+    return v > 100u ? 100u : v;
+}
+
+void metrics_stats_update(void)
+{
+    uint32_t now_us = time_us_32();
+    uint32_t dt_us  = stats_last_us ? now_us - stats_last_us : 0u;
+    stats_last_us   = now_us;
+
+    /* New counts since the previous update, summed over rings. */
+    static ring_hist_t d;
+    memset(&d, 0, sizeof(d));
+    uint64_t d_work = 0, d_int = 0, d_dur = 0;
+    uint32_t d_n = 0;
+    uint32_t nsrc = src_count;
+    for (uint32_t i = 0; i < METRICS_RINGS; ++i) {
+        static ring_state_t cur;
+        ring_state_t *base = &stats_base[i];
+        ring_copy(&rings[i], &cur, sizeof(cur));
+        if (cur.sums.tot.head == base->sums.tot.head) continue;
+        for (uint32_t s = 0; s < nsrc; ++s) {
+            const ring_totals_t *c = &cur.sums.src[s], *b = &base->sums.src[s];
+            if (c->head == b->head || src_weight[s] == 0) continue;
+            d_n    += c->head - b->head;
+            d_work += c->sum_work - b->sum_work;
+            d_int  += c->sum_int  - b->sum_int;
+            d_dur  += c->sum_dur  - b->sum_dur;
+        }
+        for (uint32_t k = 0; k < 2u; ++k)
+            for (uint32_t b = 0; b < METRICS_HIST_BUCKETS; ++b)
+                d.c[k][b] += cur.hist.c[k][b] - base->hist.c[k][b];
+        *base = cur;
+    }
+
+    metrics_stats_t out;
+    out.ts_ms   = to_ms_since_boot(get_absolute_time());
+    out.updates = stats_pub.updates + 1u;
+
+    for (uint32_t w = 0; w < METRICS_WINDOWS; ++w) {
+        decay_win_t *dw = &win[w];
+        float f = expf(-(float)dt_us / ((float)win_horizon_ms[w] * 1000.0f));
+
+        dw->n *= f; dw->s_work *= f; dw->s_int *= f; dw->s_dur *= f;
+        for (uint32_t k = 0; k < 2u; ++k) {
+            for (uint32_t b = 0; b < METRICS_HIST_BUCKETS; ++b) {
+                float v = dw->hist[k][b];
+                if (v != 0.0f) {
+                    v *= f;
+                    dw->hist[k][b] = (v < 1e-3f) ? 0.0f : v;   /* stay sparse */
+                }
+                if (d_n) dw->hist[k][b] += (float)d.c[k][b];
+            }
+        }
+        dw->n      += (float)d_n;
+        dw->s_work += (float)d_work;
+        dw->s_int  += (float)d_int;
+        dw->s_dur  += (float)d_dur;
+        if (dw->n < 1e-3f) memset(dw, 0, sizeof(*dw));
+
+        metrics_window_stats_t *o = &out.win[w];
+        o->horizon_ms = win_horizon_ms[w];
+        o->weight     = dw->n;
+        o->rate_hz    = dw->n * 1000.0f / (float)win_horizon_ms[w];
+        float inv     = (dw->n > 0.0f) ? 1.0f / dw->n : 0.0f;
+        o->avg_workload    = dw->s_work * inv;
+        o->avg_intensity   = dw->s_int * inv;
+        o->avg_duration_ms = dw->s_dur * inv;
+        o->p50_intensity   = clamp_pct(hist_percentile(dw->hist[HIST_INT], dw->n, 0.50f));
+        o->p95_intensity   = clamp_pct(hist_percentile(dw->hist[HIST_INT], dw->n, 0.95f));
+        o->max_intensity   = clamp_pct(hist_max(dw->hist[HIST_INT]));
+        o->p50_duration_ms = hist_percentile(dw->hist[HIST_DUR], dw->n, 0.50f);
+        o->p95_duration_ms = hist_percentile(dw->hist[HIST_DUR], dw->n, 0.95f);
+        o->max_duration_ms = hist_max(dw->hist[HIST_DUR]);
+    }
+
+    seqlock_write(&stats_lock, &stats_pub, &out, sizeof(out));
+}
+
+int metrics_get_stats(metrics_stats_t *out)
+{
+    if (!out) return 0;
+    seqlock_read(&stats_lock, out, &stats_pub, sizeof(*out));
+    return out->updates != 0;
+}
+
+uint32_t metrics_recent(metrics_sample_t *out, uint32_t max)
+{
+    if (!out || max == 0) return 0;
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < METRICS_RINGS; ++i) {
+        const metrics_ring_t *r = &rings[i];
+        ring_totals_t before, after;
+        ring_read_totals(r, &before);
+        uint32_t avail = (before.head < METRICS_RING_SZ) ? before.head : METRICS_RING_SZ;
+
+        metric_rec_t copy[METRICS_RING_SZ];
+        for (uint32_t k = 0; k < avail; ++k)
+            copy[k] = r->rec[(before.head - avail + k) & (METRICS_RING_SZ - 1u)];
+        __dmb();
+
+        /* Drop slots the producer may have overwritten during the copy. */
+        ring_read_totals(r, &after);
+        uint32_t lost = after.head - before.head;
+        for (uint32_t k = (lost < avail) ? lost : avail; k < avail; ++k) {
+            metrics_sample_t s = {
+                .workload = copy[k].workload, .intensity = copy[k].intensity,
+                .duration_ms = copy[k].duration_ms, .ts_ms = copy[k].ts_ms,
+                .ring = (uint8_t)i, .source = copy[k].src,
+            };
+            /* Keep the `max` newest: insertion into a ts-descending list. */
+            uint32_t pos = n;
+            while (pos > 0 && out[pos - 1].ts_ms < s.ts_ms) pos--;
+            if (pos >= max) continue;
+            uint32_t last = (n < max) ? n : max - 1u;
+            for (uint32_t m = last; m > pos; --m) out[m] = out[m - 1];
+            out[pos] = s;
+            if (n < max) n++;
+        }
+    }
+    return n;
+}
+
+uint32_t metrics_ring_submissions(uint32_t ring)
+{
+    if (ring >= METRICS_RINGS) return 0;
+    ring_totals_t t;
+    ring_read_totals(&rings[ring], &t);
+    return t.head;
+}
+
+const char *metrics_ring_name(uint32_t ring)
+{
+    return (ring < METRICS_RINGS) ? ring_names[ring] : "?";
+}
+
+/* --------------------------------------------------------------------------
+ * Sources
+ * -------------------------------------------------------------------------- */
+
+static inline uint32_t clamp_weight(uint32_t w)
 {
-    if (!kernel_inited) {
-        mutex_init(&kernel_lock);
-        kernel_inited = 1;
+    return w > METRICS_WEIGHT_MAX ? METRICS_WEIGHT_MAX : w;
+}
+
+metrics_source_t metrics_find_source(const char *name)
+{
+    if (!name) return -1;
+    uint32_t n = src_count;
+    for (uint32_t s = 0; s < n; ++s)
+        if (strncmp(src_names[s], name, METRICS_SOURCE_NAME_LEN) == 0)
+            return (metrics_source_t)s;
+    return -1;
+}
+
+metrics_source_t metrics_register_source(const char *name, uint32_t weight)
+{
+    if (!name || !name[0]) return -1;
+    if (!metrics_inited) metrics_init();
+
+    critical_section_enter_blocking(&src_lock);
+    metrics_source_t h = metrics_find_source(name);
+    if (h < 0 && src_count < METRICS_MAX_SOURCES) {
+        uint32_t s = src_count;
+        strncpy(src_names[s], name, METRICS_SOURCE_NAME_LEN - 1u);
+        src_names[s][METRICS_SOURCE_NAME_LEN - 1u] = '\0';
+        src_weight[s] = clamp_weight(weight);
+        __dmb();                        /* slot complete before it is visible */
+        src_count = s + 1u;
+        h = (metrics_source_t)s;
     }
+    critical_section_exit(&src_lock);
+    return h;
+}
+
+int metrics_set_source_weight(metrics_source_t src, uint32_t weight)
+{
+    if (src < 0 || (uint32_t)src >= src_count) return -1;
+    src_weight[src] = clamp_weight(weight);
+    return 0;
+}
+
+uint32_t metrics_source_count(void)
+{
+    return src_count;
+}
+
+int metrics_get_source_info(metrics_source_t src, metrics_source_info_t *out)
+{
+    if (!out || src < 0 || (uint32_t)src >= src_count) return -1;
+    memset(out, 0, sizeof(*out));
+    memcpy(out->name, src_names[src], METRICS_SOURCE_NAME_LEN);
+    out->weight = src_weight[src];
+
+    uint64_t work = 0, inten = 0, dur = 0;
+    for (uint32_t i = 0; i < METRICS_RINGS; ++i) {
+        ring_totals_t cur;
+        ring_read_src(&rings[i], (uint32_t)src, &cur);
+        const ring_totals_t *c = &cur;
+        out->samples += c->head;
+        work  += c->sum_work;
+        inten += c->sum_int;
+        dur   += c->sum_dur;
+        if (c->last_ts_ms > out->last_ts_ms) out->last_ts_ms = c->last_ts_ms;
+    }
+    if (out->samples) {
+        out->avg_workload    = (float)((double)work  / out->samples);
+        out->avg_intensity   = (float)((double)inten / out->samples);
+        out->avg_duration_ms = (float)((double)dur   / out->samples);
+    }
+    return 0;
+}
+
+void metrics_publish_kernel(const kernel_metrics_t *snap)
+{
     if (!snap) return;
-    mutex_enter_blocking(&kernel_lock);
-    memcpy(&kernel_snap, snap, sizeof(kernel_snap));
-    mutex_exit(&kernel_lock);
+    seqlock_write(&kernel_lock, &kernel_snap, snap, sizeof(kernel_snap));
 }
 
 int metrics_get_kernel_snapshot(kernel_metrics_t *out)
 {
-    if (!kernel_inited) return 0;
     if (!out) return 0;
-    mutex_enter_blocking(&kernel_lock);
-    memcpy(out, &kernel_snap, sizeof(kernel_snap));
-    mutex_exit(&kernel_lock);
+    seqlock_read(&kernel_lock, out, &kernel_snap, sizeof(*out));
     /* consider snapshot valid if we've seen at least one tick */
-    return (kernel_snap.gov_tick_count != 0) ? 1 : 0;
+    return (out->gov_tick_count != 0) ? 1 : 0;
 }
@@ -2,6 +2,8 @@
 #define METRICS_H
 
 #include <stdint.h>
+#include "ramp_stats.h"
+#include "freq_stats.h"
 
 typedef struct {
     uint32_t count;
@@ -9,6 +11,7 @@ typedef struct {
     double   avg_intensity;  /* 0..100 percent style */
     double   avg_duration_ms;
     uint32_t last_ts_ms;     /* ms since boot of last sample */
+    uint32_t iowait;         /* metrics_submit_iowait() flags, any count */
 } metrics_agg_t;
 
 /* Kernel-level snapshot that the kernel publishes for governors to consume.
@@ -16,23 +19,220 @@ typedef struct {
  * locking. */
 typedef struct {
     uint32_t gov_tick_count;    /* number of tick measurements */
-    double   gov_tick_avg_ms;   /* running average tick duration (ms) */
+    double   gov_tick_avg_ms;   /* running average tick execution time (ms) */
     uint32_t last_ts_ms;        /* ms since boot of last measurement */
+
+    /* Frequency transitions (end-to-end, see ramp_get_latency()) */
+    uint32_t ramp_transitions;      /* completed transitions             */
+    uint32_t ramp_last_latency_us;
+    uint32_t ramp_avg_latency_us;
+    uint32_t ramp_max_latency_us;
+
+    /* Per-step phase timing (see ramp_stats.h) */
+    uint32_t ramp_steps;            /* PLL steps taken                   */
+    uint32_t ramp_stall_avg_us;     /* Core 0 stall per step             */
+    uint32_t ramp_stall_max_us;
+    uint32_t ramp_pll_max_us;       /* worst pll_sys reprogram           */
+    uint32_t ramp_stall_hist[RAMP_HIST_BUCKETS]; /* log2 µs buckets      */
+
+    /* Cooperative safe-point handshake (see safepoint.h) */
+    uint32_t sp_handshakes;         /* PLL changes with Core 0 parked    */
+    uint32_t sp_forced;             /* timeouts -> forced lockout        */
+    uint32_t sp_stall_avg_us;       /* Core 0 time parked                */
+    uint32_t sp_stall_max_us;
+
+    /* Doorbell wakeups (see metrics_set_wake_threshold()) */
+    uint32_t wake_count;            /* ticks started early by a submit   */
+    uint32_t wake_last_latency_us;  /* submit -> governor decision       */
+    uint32_t wake_avg_latency_us;
+    uint32_t wake_max_latency_us;
+
+    /* Time-in-state (see freq_stats.h); the transition table is read on
+     * demand with freq_stats_snapshot() (`freqstat`), not copied here. */
+    uint32_t freq_residency_ms[FREQ_STATS_BUCKETS];
+    uint32_t freq_trans_total;
+
+    /* Application boosts (see freq_boost.h) */
+    uint32_t boost_requests;        /* granted since boot                */
+    uint32_t boost_active;          /* live references                   */
+    uint32_t boost_floor_khz;       /* floor in force, 0 if none         */
+    uint32_t boost_time_ms;         /* total time with a floor in force  */
+
+    /* Core 1 pacing (see governors.h) */
+    uint32_t gov_sampling_ms;       /* current governor's sampling period */
+    uint32_t tickless;              /* tickless mode on                  */
+    uint32_t tickless_sleeps;       /* idle ticks that slept to the deadline */
 } kernel_metrics_t;
 
+/* Producer rings: one per (core, thread/IRQ context). */
+#define METRICS_RINGS 4u
+
+typedef struct {
+    uint32_t workload;
+    uint32_t intensity;
+    uint32_t duration_ms;
+    uint32_t ts_ms;
+    uint8_t  ring;           /* producer ring, see metrics_ring_name() */
+    uint8_t  source;         /* metrics_source_t of the submitter */
+} metrics_sample_t;
+
+/* Tagged sources.
+ *
+ * Each submitter can register a named source and tag its samples with the
+ * returned handle.  Sums are kept per source, and the per-tick aggregate
+ * is a weighted mean: a source with weight 200 counts twice as much as
+ * one with the default 100, and weight 0 drops it entirely (it is still
+ * counted in its own statistics, but never moves the governor, rings the
+ * wake doorbell or enters the p50/p95/max windows).  Untagged
+ * metrics_submit() calls belong to METRICS_SOURCE_DEFAULT.
+ */
+#define METRICS_MAX_SOURCES      8u
+#define METRICS_SOURCE_NAME_LEN  16u
+#define METRICS_SOURCE_DEFAULT   0
+#define METRICS_WEIGHT_DEFAULT   100u
+#define METRICS_WEIGHT_MAX       1000u
+
+typedef int metrics_source_t;
+
+typedef struct {
+    char     name[METRICS_SOURCE_NAME_LEN];
+    uint32_t weight;
+    uint32_t samples;        /* lifetime submissions (wraps) */
+    float    avg_workload;   /* lifetime means */
+    float    avg_intensity;
+    float    avg_duration_ms;
+    uint32_t last_ts_ms;
+} metrics_source_info_t;
+
+/* Multi-window statistics.
+ *
+ * metrics_get_aggregate() only sees samples since the last tick, so one
+ * long stall is averaged away within a tick and forgotten by the next.
+ * Each producer ring therefore also counts intensity and duration in
+ * log-bucketed histograms (4 sub-buckets per power of two, HDR style:
+ * values are resolved to within 25%).  metrics_stats_update() folds the
+ * new counts into exponentially decaying histograms and sums over three
+ * horizons, from which p50/p95/max and mean values are derived.
+ *
+ * A sample's weight falls to 1/e after one horizon; `max` is the highest
+ * bucket still holding at least half a sample, i.e. roughly the largest
+ * value seen in the last 0.7 horizons.  Percentiles and maxima report the
+ * bucket's upper bound (intensity is clamped to 100).
+ */
+#define METRICS_HIST_BUCKETS 61u      /* 0..3 exact, 4..65535 log, overflow */
+
+#define METRICS_WIN_100MS 0u
+#define METRICS_WIN_1S    1u
+#define METRICS_WIN_10S   2u
+#define METRICS_WINDOWS   3u
+
+typedef struct {
+    uint32_t horizon_ms;
+    float    weight;            /* decayed sample count                   */
+    float    rate_hz;           /* samples per second over the horizon    */
+    float    avg_workload;
+    float    avg_intensity;
+    float    avg_duration_ms;
+    uint32_t p50_intensity;
+    uint32_t p95_intensity;
+    uint32_t max_intensity;
+    uint32_t p50_duration_ms;
+    uint32_t p95_duration_ms;
+    uint32_t max_duration_ms;
+} metrics_window_stats_t;
+
+typedef struct {
+    uint32_t ts_ms;             /* ms since boot of the last update       */
+    uint32_t updates;
+    metrics_window_stats_t win[METRICS_WINDOWS];
+} metrics_stats_t;
+
 /* Initialize metrics subsystem (idempotent) */
 void metrics_init(void);
 
-/* Submit a sample describing recent work. Called by application code. */
+/* Submit a sample describing recent work. Called by application code.
+ * Lock-free and safe from interrupt handlers on either core; each
+ * (core, context) pair writes its own ring.  IRQ handlers of different
+ * priorities on the same core must not both submit (they would share the
+ * core's IRQ ring). */
 void metrics_submit(uint32_t workload, uint32_t intensity, uint32_t duration_ms);
 
-/* Compute aggregated statistics. If `clear` is non-zero the stored samples are
- * consumed (reset). Returns number of samples aggregated (0 if none).
+/* Register (or look up, if the name exists) a source.  Returns its handle,
+ * or -1 when the table is full.  An existing source keeps its weight. */
+metrics_source_t metrics_register_source(const char *name, uint32_t weight);
+
+/* Handle for `name`, or -1. */
+metrics_source_t metrics_find_source(const char *name);
+
+/* Same as metrics_submit(), tagged with `src` (invalid handles fall back
+ * to METRICS_SOURCE_DEFAULT). */
+void metrics_submit_src(metrics_source_t src, uint32_t workload,
+                        uint32_t intensity, uint32_t duration_ms);
+
+/* Blocking I/O.
+ *
+ * A source that has just been woken from a wait on I/O (DMA, UART, flash,
+ * a sensor) flags it, so governors can boost the clock for the burst of
+ * work that follows even though the time spent blocked kept its reported
+ * intensity low.  Lock-free and IRQ-safe like metrics_submit(); counted
+ * in metrics_agg_t.iowait (weight-0 sources excluded), not as a sample.
+ */
+void metrics_submit_iowait(metrics_source_t src);
+
+/* Weight in 0..METRICS_WEIGHT_MAX; 0 = ignore.  Returns 0 or -1. */
+int      metrics_set_source_weight(metrics_source_t src, uint32_t weight);
+uint32_t metrics_source_count(void);
+int      metrics_get_source_info(metrics_source_t src, metrics_source_info_t *out);
+
+/* Wakeup doorbell.
+ *
+ * A submission with intensity >= the wake threshold rings a doorbell
+ * (flag + SEV) so Core 1 leaves its inter-tick wait immediately instead of
+ * sleeping out the governor's pacing interval.  Threshold 0 disables it.
+ */
+#define METRICS_WAKE_DEFAULT_INTENSITY 80u
+
+void     metrics_set_wake_threshold(uint32_t intensity);
+uint32_t metrics_get_wake_threshold(void);
+
+/* Core 1: true if a wakeup is pending (does not consume it). */
+int      metrics_wake_pending(void);
+
+/* Core 1: consume a pending wakeup.  Returns the time_us_32() stamp of the
+ * submission that rang it (never 0), or 0 if none was pending. */
+uint32_t metrics_wake_take(void);
+
+/* Compute aggregated statistics over samples since the last clear, in O(1)
+ * from per-ring running sums.  Averages are weighted by source weight and
+ * `count` excludes ignored (weight 0) sources; `iowait` is filled in even
+ * when there are no samples. If `clear` is non-zero the samples are
+ * consumed (reset); only one consumer (the Core 1 loop) should clear.
+ * Not callable from IRQ context. Returns number of samples aggregated
+ * (0 if none).
  */
 uint32_t metrics_get_aggregate(metrics_agg_t *out, int clear);
 
-/* Kernel metrics: publish a fresh snapshot (called by kernel/system code).
- * This copies the provided snapshot into an atomic store for readers. */
+/* Core 1 only (single writer): fold samples submitted since the previous
+ * call into the decaying windows and publish a fresh metrics_stats_t.
+ * Independent of metrics_get_aggregate()'s clearing; called once per
+ * governor tick. */
+void metrics_stats_update(void);
+
+/* Latest published window statistics; safe from either core.  Returns 1
+ * once metrics_stats_update() has run, 0 otherwise. */
+int metrics_get_stats(metrics_stats_t *out);
+
+/* Copy up to `max` of the most recent samples (newest first, across all
+ * rings) without consuming them. Returns the number copied. */
+uint32_t metrics_recent(metrics_sample_t *out, uint32_t max);
+
+/* Per-ring submission counters (monotonic, wrap at 2^32). */
+uint32_t    metrics_ring_submissions(uint32_t ring);
+const char *metrics_ring_name(uint32_t ring);
+
+/* Kernel metrics: publish a fresh snapshot (Core 1 only, single writer).
+ * Published under a seqlock: readers on either core never block the
+ * writer, take a lock or mask interrupts. */
 void metrics_publish_kernel(const kernel_metrics_t *snap);
 
 /* Retrieve latest kernel snapshot. Returns 1 if a snapshot exists, 0 otherwise. */
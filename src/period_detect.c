@@ -0,0 +1,67 @@
+/*
+ * period_detect.c  –  periodicity of a sampled signal by autocorrelation
+ */
+
+#include "period_detect.h"
+#include <stdbool.h>
+#include <string.h>
+
+void period_hist_reset(period_hist_t *h)
+{
+    memset(h, 0, sizeof(*h));
+}
+
+void period_hist_push(period_hist_t *h, uint8_t v)
+{
+    h->s[h->head] = v;
+    h->head = (uint16_t)((h->head + 1u) % PERIOD_HIST_LEN);
+    if (h->n < PERIOD_HIST_LEN) h->n++;
+}
+
+uint32_t period_detect(const period_hist_t *h, uint32_t max_lag,
+                       float min_r, float *r_out)
+{
+    if (r_out) *r_out = 0.0f;
+    uint32_t n = h->n;
+    if (max_lag > n / 2u) max_lag = n / 2u;
+    if (max_lag < PERIOD_MIN_LAG) return 0;
+
+    /* Oldest first, mean-removed (x100 keeps the mean's fraction). */
+    int16_t x[PERIOD_HIST_LEN];
+    uint32_t start = (h->head + PERIOD_HIST_LEN - n) % PERIOD_HIST_LEN;
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < n; ++i) sum += h->s[(start + i) % PERIOD_HIST_LEN];
+    int32_t mean100 = (sum * 100) / (int32_t)n;
+    int32_t var = 0;               /* |x| <= 2550: fits for 128 samples */
+    for (uint32_t i = 0; i < n; ++i) {
+        x[i] = (int16_t)(((int32_t)h->s[(start + i) % PERIOD_HIST_LEN] * 100 - mean100) / 10);
+        var += (int32_t)x[i] * x[i];
+    }
+    if (var == 0) return 0;
+    float varf = (float)var / (float)n;
+
+    /* r in 1/10000 keeps the lag table small on the Core 1 stack. */
+    int16_t r[PERIOD_HIST_LEN / 2u + 1u];
+    int32_t best = -10000;
+    for (uint32_t k = PERIOD_MIN_LAG - 1u; k <= max_lag; ++k) {
+        int32_t acc = 0;
+        for (uint32_t i = 0; i + k < n; ++i) acc += (int32_t)x[i] * x[i + k];
+        float rk = ((float)acc / (float)(n - k)) / varf;
+        if (rk > 1.0f)  rk = 1.0f;
+        if (rk < -1.0f) rk = -1.0f;
+        r[k] = (int16_t)(rk * 10000.0f);
+        if (k >= PERIOD_MIN_LAG && r[k] > best) best = r[k];
+    }
+    int32_t min_q = (int32_t)(min_r * 10000.0f);
+    if (best < min_q) return 0;
+
+    /* First local peak close to the best: the fundamental, not a multiple. */
+    for (uint32_t k = PERIOD_MIN_LAG; k <= max_lag; ++k) {
+        bool peak = r[k] >= r[k - 1u] && (k == max_lag || r[k] >= r[k + 1u]);
+        if (peak && r[k] * 10 >= best * 9 && r[k] >= min_q) {
+            if (r_out) *r_out = (float)r[k] / 10000.0f;
+            return k;
+        }
+    }
+    return 0;
+}
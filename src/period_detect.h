@@ -0,0 +1,54 @@
+#ifndef PERIOD_DETECT_H
+#define PERIOD_DETECT_H
+
+/*
+ * period_detect.h  –  periodicity of a sampled signal by autocorrelation
+ *
+ * Samples (0–100, e.g. workload intensity per fixed interval) go into a
+ * ring of PERIOD_HIST_LEN bytes.  period_detect() computes the normalised
+ * autocorrelation
+ *
+ *   r(k) = mean[(x_i − m)(x_{i+k} − m)] / var(x)      over the overlap
+ *
+ * for every lag in [PERIOD_MIN_LAG, max_lag] and returns the period: the
+ * first local peak whose r is within 90% of the best one (so a period P
+ * is not reported as 2P or 3P), provided it reaches min_r.  A flat signal
+ * has no period.
+ *
+ * Cost: one pass of (n − k) integer multiply-adds per lag, ~6k for the
+ * default 128-sample ring and max_lag 64.
+ *
+ * This module has no Pico SDK dependencies so the detector can be run on
+ * recorded traces on a host.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PERIOD_HIST_LEN   128u
+#define PERIOD_MIN_LAG    2u
+
+typedef struct {
+    uint8_t  s[PERIOD_HIST_LEN];
+    uint16_t head;          /* next write index */
+    uint16_t n;             /* valid samples */
+} period_hist_t;
+
+void period_hist_reset(period_hist_t *h);
+void period_hist_push(period_hist_t *h, uint8_t v);
+
+/**
+ * Period in samples, or 0 if none reaches min_r (or fewer than 2·lag
+ * samples are available).  *r_out (optional) receives r at that lag.
+ */
+uint32_t period_detect(const period_hist_t *h, uint32_t max_lag,
+                       float min_r, float *r_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIOD_DETECT_H */
@@ -1,10 +1,13 @@
 #include "persist.h"
+#include "governors.h"
 #include <string.h>
 #include <stdio.h>
 #include "hardware/flash.h"
 #include "hardware/sync.h"
+#include "pico/multicore.h"
 #include "pico/bootrom.h"
 #include <stdlib.h>
+#include <stdbool.h>
 
 /* Default flash region: last 64KB of a typical 2MB Pico flash
  * WARNING: This region must be reserved for application use. If you
@@ -15,13 +18,31 @@
 #define PERSIST_FLASH_OFFSET 0x1F0000u
 #endif
 
-#define PERSIST_SECTOR_SIZE 0x10000u
 #define PERSIST_MAGIC 0x47564F47u /* 'GOVG' */
 
 /* rp2040_perf params blob location (within same sector) */
 #define RP_PARAMS_OFFSET 0x100u
 #define RP_PARAMS_MAGIC  0x52505050u /* 'RPPP' */
 
+/* Calibrated VREG table (see vreg_cal.h) */
+#define VREG_TABLE_OFFSET 0x400u
+#define VREG_TABLE_MAGIC  0x5643414Cu /* 'VCAL' */
+
+/* Energy model coefficients (see energy.h) */
+#define ENERGY_COEFFS_OFFSET 0x480u
+#define ENERGY_COEFFS_MAGIC  0x454E5247u /* 'ENRG' */
+
+/* Interrupted `gov autotune` run (see autotune.h) */
+#define AUTOTUNE_STATE_OFFSET 0x500u
+#define AUTOTUNE_STATE_MAGIC  0x41545354u /* 'ATST' */
+
+/* Per-governor tunables (see gov_tunable.h): fixed slots, each a blob
+ * whose payload is key(4) | params. */
+#define GOV_PARAMS_OFFSET PERSIST_GOV_PARAMS_OFFSET
+#define GOV_PARAMS_SLOT   PERSIST_GOV_PARAMS_SLOT
+#define GOV_PARAMS_SLOTS  GOVERNOR_MAX
+#define GOV_PARAMS_MAGIC  0x47565450u /* 'GVTP' */
+
 struct persist_rec {
     uint32_t magic;
     uint32_t ver;
@@ -38,6 +59,22 @@ static uint32_t simple_crc(const void *buf, size_t len)
     return crc;
 }
 
+/* Erase and rewrite the sector.  XIP is unusable meanwhile, so besides
+ * our own interrupts the other core must be kept off flash: it is held in
+ * its lockout handler (RAM) once it has called
+ * multicore_lockout_victim_init(); before Core 1 is launched there is
+ * nothing to hold. */
+static void flash_write_sector(uint32_t offset, const uint8_t *sector)
+{
+    bool lockout = multicore_lockout_victim_is_initialized(get_core_num() ^ 1u);
+    if (lockout) multicore_lockout_start_blocking();
+    uint32_t ints = save_and_disable_interrupts();
+    flash_range_erase(offset, PERSIST_SECTOR_SIZE);
+    flash_range_program(offset, sector, PERSIST_SECTOR_SIZE);
+    restore_interrupts(ints);
+    if (lockout) multicore_lockout_end_blocking();
+}
+
 int persist_save(const char *name)
 {
     if (!name) return -1;
@@ -59,10 +96,7 @@ int persist_save(const char *name)
     /* copy our record at start of sector */
     memcpy(sector, &rec, sizeof(rec));
 
-    uint32_t ints = save_and_disable_interrupts();
-    flash_range_erase(offset, PERSIST_SECTOR_SIZE);
-    flash_range_program(offset, sector, PERSIST_SECTOR_SIZE);
-    restore_interrupts(ints);
+    flash_write_sector(offset, sector);
     free(sector);
     return 0;
 }
@@ -89,18 +123,20 @@ int persist_load(char *out, size_t out_len)
     return 0;
 }
 
-int persist_save_rp_params(const void *buf, size_t len)
+/* Length-prefixed blob at `at` within the sector:
+ *   magic(4) | len(4) | payload(len) | crc(4)
+ * The rest of the sector (name record, other blobs) is preserved. */
+static int save_blob(uint32_t at, uint32_t magic, const void *buf, size_t len)
 {
     if (!buf || len == 0) return -1;
-    if (len > (PERSIST_SECTOR_SIZE - RP_PARAMS_OFFSET - 16)) return -1;
+    if (len > (PERSIST_SECTOR_SIZE - at - 16)) return -1;
     uint32_t offset = PERSIST_FLASH_OFFSET;
     const uint8_t *mapped = (const uint8_t *)(0x10000000UL + offset);
     uint8_t *sector = malloc(PERSIST_SECTOR_SIZE);
     if (!sector) return -1;
     memcpy(sector, mapped, PERSIST_SECTOR_SIZE);
 
-    uint32_t p = RP_PARAMS_OFFSET;
-    uint32_t magic = RP_PARAMS_MAGIC;
+    uint32_t p = at;
     memcpy(&sector[p], &magic, sizeof(magic)); p += sizeof(magic);
     uint32_t llen = (uint32_t)len;
     memcpy(&sector[p], &llen, sizeof(llen)); p += sizeof(llen);
@@ -108,23 +144,20 @@ int persist_save_rp_params(const void *buf, size_t len)
     uint32_t crc = simple_crc(buf, len);
     memcpy(&sector[p], &crc, sizeof(crc)); p += sizeof(crc);
 
-    uint32_t ints = save_and_disable_interrupts();
-    flash_range_erase(offset, PERSIST_SECTOR_SIZE);
-    flash_range_program(offset, sector, PERSIST_SECTOR_SIZE);
-    restore_interrupts(ints);
+    flash_write_sector(offset, sector);
     free(sector);
     return 0;
 }
 
-int persist_load_rp_params(void *out, size_t maxlen)
+static int load_blob(uint32_t at, uint32_t want_magic, void *out, size_t maxlen)
 {
     if (!out || maxlen == 0) return -1;
     uint32_t offset = PERSIST_FLASH_OFFSET;
     const uint8_t *mapped = (const uint8_t *)(0x10000000UL + offset);
-    uint32_t p = RP_PARAMS_OFFSET;
+    uint32_t p = at;
     uint32_t magic = 0;
     memcpy(&magic, &mapped[p], sizeof(magic));
-    if (magic != RP_PARAMS_MAGIC) return -1;
+    if (magic != want_magic) return -1;
     p += sizeof(magic);
     uint32_t llen = 0;
     memcpy(&llen, &mapped[p], sizeof(llen));
@@ -138,3 +171,104 @@ int persist_load_rp_params(void *out, size_t maxlen)
     if (crc != calc) return -1;
     return (int)llen;
 }
+
+int persist_save_rp_params(const void *buf, size_t len)
+{
+    return save_blob(RP_PARAMS_OFFSET, RP_PARAMS_MAGIC, buf, len);
+}
+
+int persist_load_rp_params(void *out, size_t maxlen)
+{
+    return load_blob(RP_PARAMS_OFFSET, RP_PARAMS_MAGIC, out, maxlen);
+}
+
+int persist_save_vreg_table(const void *buf, size_t len)
+{
+    return save_blob(VREG_TABLE_OFFSET, VREG_TABLE_MAGIC, buf, len);
+}
+
+int persist_load_vreg_table(void *out, size_t maxlen)
+{
+    return load_blob(VREG_TABLE_OFFSET, VREG_TABLE_MAGIC, out, maxlen);
+}
+
+int persist_clear_vreg_table(void)
+{
+    /* A zero magic never matches, so the load falls back to defaults. */
+    uint32_t zero = 0;
+    return save_blob(VREG_TABLE_OFFSET, 0, &zero, sizeof(zero));
+}
+
+int persist_save_energy_coeffs(const void *buf, size_t len)
+{
+    return save_blob(ENERGY_COEFFS_OFFSET, ENERGY_COEFFS_MAGIC, buf, len);
+}
+
+int persist_load_energy_coeffs(void *out, size_t maxlen)
+{
+    return load_blob(ENERGY_COEFFS_OFFSET, ENERGY_COEFFS_MAGIC, out, maxlen);
+}
+
+int persist_save_autotune(const void *buf, size_t len)
+{
+    if (len > PERSIST_AUTOTUNE_MAX) return -1;
+    return save_blob(AUTOTUNE_STATE_OFFSET, AUTOTUNE_STATE_MAGIC, buf, len);
+}
+
+int persist_load_autotune(void *out, size_t maxlen)
+{
+    return load_blob(AUTOTUNE_STATE_OFFSET, AUTOTUNE_STATE_MAGIC, out, maxlen);
+}
+
+int persist_clear_autotune(void)
+{
+    /* Nothing saved: skip the erase. */
+    const uint8_t *mapped = (const uint8_t *)(0x10000000UL + PERSIST_FLASH_OFFSET);
+    uint32_t magic = 0;
+    memcpy(&magic, &mapped[AUTOTUNE_STATE_OFFSET], sizeof(magic));
+    if (magic != AUTOTUNE_STATE_MAGIC) return 0;
+
+    uint32_t zero = 0;
+    return save_blob(AUTOTUNE_STATE_OFFSET, 0, &zero, sizeof(zero));
+}
+
+/* Slot holding `key`, else the first unused slot, else -1. */
+static int gov_params_slot(uint32_t key, bool want_free)
+{
+    const uint8_t *mapped = (const uint8_t *)(0x10000000UL + PERSIST_FLASH_OFFSET);
+    int free_slot = -1;
+    for (uint32_t i = 0; i < GOV_PARAMS_SLOTS; ++i) {
+        uint32_t at = GOV_PARAMS_OFFSET + i * GOV_PARAMS_SLOT;
+        uint32_t magic, k;
+        memcpy(&magic, &mapped[at], sizeof(magic));
+        memcpy(&k, &mapped[at + 8], sizeof(k));     /* after magic | len */
+        if (magic == GOV_PARAMS_MAGIC && k == key) return (int)i;
+        if (magic != GOV_PARAMS_MAGIC && free_slot < 0) free_slot = (int)i;
+    }
+    return want_free ? free_slot : -1;
+}
+
+int persist_save_gov_params(uint32_t key, const void *buf, size_t len)
+{
+    if (!buf || len == 0 || len > PERSIST_GOV_PARAMS_MAX) return -1;
+    int slot = gov_params_slot(key, true);
+    if (slot < 0) return -1;
+    uint8_t rec[sizeof(key) + PERSIST_GOV_PARAMS_MAX];
+    memcpy(rec, &key, sizeof(key));
+    memcpy(rec + sizeof(key), buf, len);
+    return save_blob(GOV_PARAMS_OFFSET + (uint32_t)slot * GOV_PARAMS_SLOT,
+                     GOV_PARAMS_MAGIC, rec, sizeof(key) + len);
+}
+
+int persist_load_gov_params(uint32_t key, void *out, size_t maxlen)
+{
+    if (!out || maxlen == 0) return -1;
+    int slot = gov_params_slot(key, false);
+    if (slot < 0) return -1;
+    uint8_t rec[sizeof(key) + PERSIST_GOV_PARAMS_MAX];
+    int n = load_blob(GOV_PARAMS_OFFSET + (uint32_t)slot * GOV_PARAMS_SLOT,
+                      GOV_PARAMS_MAGIC, rec, sizeof(rec));
+    if (n <= (int)sizeof(key) || (size_t)n - sizeof(key) > maxlen) return -1;
+    memcpy(out, rec + sizeof(key), (size_t)n - sizeof(key));
+    return n - (int)sizeof(key);
+}
@@ -2,6 +2,7 @@
 #define PERSIST_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 /* Persist a small null-terminated string (e.g. governor name) to flash.
  * Implementations write to a reserved flash region; callers should ensure
@@ -16,4 +17,31 @@ int persist_load(char *out, size_t out_len);
 int persist_save_rp_params(const void *buf, size_t len);
 int persist_load_rp_params(void *out, size_t maxlen);
 
+/* Calibrated per-band VREG table, stored at its own offset in the sector. */
+int persist_save_vreg_table(const void *buf, size_t len);
+int persist_load_vreg_table(void *out, size_t maxlen);
+int persist_clear_vreg_table(void);
+
+/* Energy model coefficients. */
+int persist_save_energy_coeffs(const void *buf, size_t len);
+int persist_load_energy_coeffs(void *out, size_t maxlen);
+
+/* Search state of an interrupted autotune run, up to PERSIST_AUTOTUNE_MAX
+ * bytes (the gap before the governor slots). */
+#define PERSIST_AUTOTUNE_MAX 0x2F0u
+int persist_save_autotune(const void *buf, size_t len);
+int persist_load_autotune(void *out, size_t maxlen);
+int persist_clear_autotune(void);
+
+/* Governor tunables, one slot per governor keyed by a hash of its name
+ * (see gov_tunable.h).  GOVERNOR_MAX slots of PERSIST_GOV_PARAMS_SLOT
+ * bytes from PERSIST_GOV_PARAMS_OFFSET, PERSIST_GOV_PARAMS_MAX of payload
+ * each; save fails once every slot holds another key. */
+#define PERSIST_SECTOR_SIZE       0x10000u
+#define PERSIST_GOV_PARAMS_OFFSET 0x800u
+#define PERSIST_GOV_PARAMS_SLOT   0x100u
+#define PERSIST_GOV_PARAMS_MAX    240u
+int persist_save_gov_params(uint32_t key, const void *buf, size_t len);
+int persist_load_gov_params(uint32_t key, void *out, size_t maxlen);
+
 #endif
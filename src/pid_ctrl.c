@@ -0,0 +1,53 @@
+/*
+ * pid_ctrl.c  –  positional PID with anti-windup and filtered derivative
+ */
+
+#include "pid_ctrl.h"
+
+static float clampf(float v, float lo, float hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+void pid_reset(pid_state_t *s, float out)
+{
+    s->integ     = out;
+    s->prev_meas = 0.0f;
+    s->d_filt    = 0.0f;
+    s->p         = 0.0f;
+    s->d         = 0.0f;
+    s->primed    = false;
+    s->saturated = false;
+}
+
+float pid_update(const pid_cfg_t *c, pid_state_t *s,
+                 float setpoint, float meas, float dt_s)
+{
+    float e = setpoint - meas;
+
+    float d_raw = 0.0f;
+    if (s->primed && dt_s > 0.0f)
+        d_raw = -(meas - s->prev_meas) / dt_s;
+    s->prev_meas = meas;
+    s->primed    = true;
+    float a = (c->d_tau_s > 0.0f) ? dt_s / (c->d_tau_s + dt_s) : 1.0f;
+    s->d_filt += a * (d_raw - s->d_filt);
+
+    s->p = c->kp * e;
+    s->d = c->kd * s->d_filt;
+
+    /* Anti-windup: the integrator may take the output up to a limit but
+       not beyond it; a step that would is cut at the limit (or skipped if
+       the output is already past it through P and D). */
+    float i_next = s->integ + c->ki * e * dt_s;
+    float i_hi   = c->out_max - s->p - s->d;
+    float i_lo   = c->out_min - s->p - s->d;
+    if (e > 0.0f && i_next > i_hi) i_next = (s->integ > i_hi) ? s->integ : i_hi;
+    if (e < 0.0f && i_next < i_lo) i_next = (s->integ < i_lo) ? s->integ : i_lo;
+    s->integ = clampf(i_next, c->out_min, c->out_max);
+
+    float u   = s->integ + s->p + s->d;
+    float out = clampf(u, c->out_min, c->out_max);
+    s->saturated = (out != u);
+    return out;
+}
@@ -0,0 +1,60 @@
+#ifndef PID_CTRL_H
+#define PID_CTRL_H
+
+/*
+ * pid_ctrl.h  –  positional PID with anti-windup and filtered derivative
+ *
+ *   e      = setpoint − measurement
+ *   P      = kp · e
+ *   I     += ki · e · dt            (frozen while the output is saturated
+ *                                     in the direction e would push it)
+ *   D      = −kd · d(measurement)/dt, through a first-order low-pass with
+ *            time constant d_tau_s  (derivative on measurement: a setpoint
+ *            change causes no kick)
+ *   output = clamp(I + P + D, out_min, out_max)
+ *
+ * The integrator carries the operating point, so pid_reset() with the
+ * current output gives a bumpless start.  The integrator is also kept
+ * inside [out_min, out_max], so a range that shrinks at runtime (thermal
+ * cap) does not leave it wound up.
+ *
+ * This module has no Pico SDK dependencies so the loop can be run against
+ * a plant model on a host.
+ */
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    float kp;
+    float ki;           /* per second */
+    float kd;           /* seconds */
+    float d_tau_s;      /* derivative low-pass time constant, 0 = none */
+    float out_min;
+    float out_max;
+} pid_cfg_t;
+
+typedef struct {
+    float integ;
+    float prev_meas;
+    float d_filt;
+    float p, d;         /* last terms, for stats */
+    bool  primed;       /* prev_meas valid */
+    bool  saturated;    /* last output was clamped */
+} pid_state_t;
+
+/** Start from `out` with no history. */
+void pid_reset(pid_state_t *s, float out);
+
+/** One step of dt_s seconds; returns the clamped output. */
+float pid_update(const pid_cfg_t *c, pid_state_t *s,
+                 float setpoint, float meas, float dt_s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_CTRL_H */
@@ -10,10 +10,12 @@
  *
  * Thread safety
  * -------------
- * s_stats and the HB window are protected by a critical_section (disables
- * interrupts on the calling core for the critical section body only).
- * Both cores may call pio_idle_poll() concurrently; only one will win the
- * section on each read and the other will spin briefly.
+ * Writers (pio_idle_poll() and pio_idle_notify_freq_change(), possibly on
+ * different cores) serialise on a critical_section that protects the
+ * working copy s_stats and the HB window.  Before leaving it they publish
+ * s_stats to s_pub under a seqlock, so readers (pio_idle_get_stats(),
+ * pio_idle_safe_to_scale(), called every governor tick and REPL pass)
+ * never take the lock or mask interrupts.
  *
  * Settle window
  * -------------
@@ -28,6 +30,7 @@
 #include "hardware/gpio.h"
 #include "hardware/clocks.h"
 #include "pico/time.h"
+#include "seqlock.h"
 #include "pico/sync.h"
 #include "dmesg.h"
 #include <string.h>
@@ -88,10 +91,14 @@ static uint32_t s_hb_win[HB_WIN_LEN];
 static uint8_t  s_hb_wi   = 0;
 static uint8_t  s_hb_wcnt = 0;
 
-/* Published stats snapshot */
+/* Working stats (protected by s_cs) */
 static pio_idle_stats_t s_stats;
 
-/* Protects s_stats and s_hb_win; held only for pointer-sized copies. */
+/* Published stats snapshot: readers copy it lock-free */
+static pio_idle_stats_t s_pub;
+static seqlock_t        s_pub_lock = SEQLOCK_INIT;
+
+/* Serialises writers of s_stats and s_hb_win; readers never take it. */
 static critical_section_t s_cs;
 
 /* -------------------------------------------------------------------------
@@ -99,7 +106,13 @@ static critical_section_t s_cs;
  * ------------------------------------------------------------------------- */
 
 static inline void cs_enter(void) { critical_section_enter_blocking(&s_cs); }
-static inline void cs_exit(void)  { critical_section_exit(&s_cs); }
+
+/* Publish the working copy, then leave the writer section. */
+static inline void cs_exit(void)
+{
+    seqlock_write(&s_pub_lock, &s_pub, &s_stats, sizeof(s_stats));
+    critical_section_exit(&s_cs);
+}
 
 /**
  * Compute the coefficient of variation (%) of the current HB window.
@@ -138,6 +151,7 @@ void pio_idle_init(void)
 
     critical_section_init(&s_cs);
     memset(&s_stats,  0, sizeof(s_stats));
+    memset(&s_pub,    0, sizeof(s_pub));
     memset(s_hb_win,  0, sizeof(s_hb_win));
 
     s_sys_khz = clock_get_hz(clk_sys) / 1000u;
@@ -328,9 +342,7 @@ void pio_idle_poll(void)
 void pio_idle_get_stats(pio_idle_stats_t *out)
 {
     if (!out) return;
-    cs_enter();
-    *out = s_stats;
-    cs_exit();
+    seqlock_read(&s_pub_lock, out, &s_pub, sizeof(*out));
 }
 
 /* -------------------------------------------------------------------------
@@ -343,9 +355,8 @@ bool pio_idle_safe_to_scale(float idle_thresh, float jitter_thresh,
     /* If PIO subsystem is uninitialised never block the governor. */
     if (!s_inited) return true;
 
-    cs_enter();
-    pio_idle_stats_t snap = s_stats;
-    cs_exit();
+    pio_idle_stats_t snap;
+    seqlock_read(&s_pub_lock, &snap, &s_pub, sizeof(snap));
 
     /*
      * Primary gate: the heartbeat has been stable for at least min_stable
@@ -97,14 +97,16 @@ void pio_idle_init(void);
  * pio_idle_poll() – drain both RX FIFOs and update the internal stats
  * snapshot.  Non-blocking; typically < 2 µs.
  *
- * May be called from either core; internally protected by a critical section.
+ * May be called from either core; writers serialise on a critical section
+ * and publish the result under a seqlock.
  * Call at least once per main-loop iteration from Core 0 for best latency.
  */
 void pio_idle_poll(void);
 
 /**
  * pio_idle_get_stats() – copy the latest snapshot into *out.
- * Thread-safe.
+ * Lock-free (seqlock read): never blocks a writer or masks interrupts.
+ * Do not call from an IRQ that can preempt pio_idle_poll() on its core.
  */
 void pio_idle_get_stats(pio_idle_stats_t *out);
 
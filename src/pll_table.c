@@ -0,0 +1,104 @@
+/*
+ * pll_table.c  –  precomputed PLL configuration table
+ *
+ * The generator walks the divisor space in the same order as the SDK's
+ * check_sys_clock_khz() (fbdiv high→low, postdiv1 7→1, postdiv2 postdiv1→1)
+ * so the first solution found for a frequency is the one the SDK would
+ * have chosen.  Entries are kept sorted by insertion; with ~2000 probes
+ * and ~180 results this costs well under a millisecond at boot.
+ */
+
+#include "pll_table.h"
+#include "system.h"
+#include <string.h>
+
+static pll_entry_t s_table[PLL_TABLE_MAX];
+static size_t      s_count  = 0;
+static int         s_inited = 0;
+
+/* Index of the first entry in t[0..n) whose khz is >= khz. */
+static size_t lower_bound(const pll_entry_t *t, size_t n, uint32_t khz)
+{
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (t[mid].khz < khz) lo = mid + 1;
+        else                  hi = mid;
+    }
+    return lo;
+}
+
+size_t pll_table_build(pll_entry_t *out, size_t cap,
+                       uint32_t min_khz, uint32_t max_khz)
+{
+    if (!out || cap == 0 || min_khz > max_khz) return 0;
+    size_t n = 0;
+
+    for (uint32_t fbdiv = PLL_TABLE_FBDIV_MAX; fbdiv >= PLL_TABLE_FBDIV_MIN; fbdiv--) {
+        uint32_t vco = PLL_TABLE_XOSC_KHZ * fbdiv;
+        if (vco < PLL_TABLE_VCO_MIN_KHZ || vco > PLL_TABLE_VCO_MAX_KHZ)
+            continue;
+
+        for (uint32_t pd1 = PLL_TABLE_POSTDIV_MAX; pd1 >= 1; pd1--) {
+            for (uint32_t pd2 = pd1; pd2 >= 1; pd2--) {
+                uint32_t div = pd1 * pd2;
+                if (vco % div) continue;            /* not an exact kHz */
+                uint32_t khz = vco / div;
+                if (khz < min_khz || khz > max_khz) continue;
+
+                size_t pos = lower_bound(out, n, khz);
+                if (pos < n && out[pos].khz == khz) continue; /* first wins */
+                if (n == cap) return n;
+
+                memmove(&out[pos + 1], &out[pos], (n - pos) * sizeof(out[0]));
+                out[pos].khz      = khz;
+                out[pos].vco_khz  = vco;
+                out[pos].fbdiv    = (uint16_t)fbdiv;
+                out[pos].postdiv1 = (uint8_t)pd1;
+                out[pos].postdiv2 = (uint8_t)pd2;
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+void pll_table_init(void)
+{
+    if (s_inited) return;
+    s_count  = pll_table_build(s_table, PLL_TABLE_MAX, MIN_KHZ, MAX_KHZ);
+    s_inited = 1;
+}
+
+size_t pll_table_count(void)
+{
+    return s_count;
+}
+
+const pll_entry_t *pll_table_get(size_t i)
+{
+    if (i >= s_count) return NULL;
+    return &s_table[i];
+}
+
+const pll_entry_t *pll_table_ceil(uint32_t khz)
+{
+    size_t i = lower_bound(s_table, s_count, khz);
+    return (i < s_count) ? &s_table[i] : NULL;
+}
+
+const pll_entry_t *pll_table_floor(uint32_t khz)
+{
+    size_t i = lower_bound(s_table, s_count, khz);
+    if (i < s_count && s_table[i].khz == khz) return &s_table[i];
+    return (i > 0) ? &s_table[i - 1] : NULL;
+}
+
+const pll_entry_t *pll_table_nearest(uint32_t khz)
+{
+    const pll_entry_t *lo = pll_table_floor(khz);
+    const pll_entry_t *hi = pll_table_ceil(khz);
+    if (!lo) return hi;
+    if (!hi) return lo;
+    return (khz - lo->khz <= hi->khz - khz) ? lo : hi;
+}
@@ -0,0 +1,79 @@
+#ifndef PLL_TABLE_H
+#define PLL_TABLE_H
+
+/*
+ * pll_table.h  –  precomputed table of PLL-achievable sys_clk frequencies
+ *
+ * The RP2040 PLL is constrained to:
+ *   sys_clk = (XOSC[12MHz] * fbdiv) / (postdiv1 * postdiv2)
+ *   VCO = XOSC * fbdiv  must be in [750, 1600] MHz
+ *   fbdiv in [16, 320], postdiv1/2 in [1, 7]
+ *
+ * Instead of asking check_sys_clock_khz() to re-solve that divisor space
+ * for every candidate on every ramp step, the table is built once at boot
+ * and sorted by frequency.  Ramp lookups are a binary search and the PLL
+ * is programmed straight from the stored divisors.
+ *
+ * This module has no Pico SDK dependencies so the generator can be built
+ * and checked on a host against the formula above.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef PLL_TABLE_XOSC_KHZ
+#define PLL_TABLE_XOSC_KHZ     12000u
+#endif
+#define PLL_TABLE_VCO_MIN_KHZ  750000u
+#define PLL_TABLE_VCO_MAX_KHZ  1600000u
+#define PLL_TABLE_FBDIV_MIN    16u
+#define PLL_TABLE_FBDIV_MAX    320u
+#define PLL_TABLE_POSTDIV_MAX  7u
+
+/* Capacity of the boot-time table.  [MIN_KHZ, MAX_KHZ] = [125, 264] MHz
+ * holds 180 distinct achievable frequencies. */
+#define PLL_TABLE_MAX          256u
+
+typedef struct {
+    uint32_t khz;        /* resulting sys_clk (kHz)            */
+    uint32_t vco_khz;    /* XOSC * fbdiv (kHz)                 */
+    uint16_t fbdiv;
+    uint8_t  postdiv1;
+    uint8_t  postdiv2;
+} pll_entry_t;
+
+/**
+ * pll_table_build() – enumerate every exact PLL solution in [min_khz, max_khz]
+ * into `out`, sorted ascending by frequency, one entry per frequency.
+ *
+ * Where several divisor sets reach the same frequency, the one
+ * check_sys_clock_khz() would pick wins (highest VCO, then largest
+ * postdiv1).  Returns the number of entries written (at most `cap`).
+ */
+size_t pll_table_build(pll_entry_t *out, size_t cap,
+                       uint32_t min_khz, uint32_t max_khz);
+
+/** Build the global table for [MIN_KHZ, MAX_KHZ].  Idempotent. */
+void pll_table_init(void);
+
+size_t pll_table_count(void);
+const pll_entry_t *pll_table_get(size_t i);
+
+/** Smallest entry >= khz, or NULL if khz is above the table. */
+const pll_entry_t *pll_table_ceil(uint32_t khz);
+
+/** Largest entry <= khz, or NULL if khz is below the table. */
+const pll_entry_t *pll_table_floor(uint32_t khz);
+
+/** Entry closest to khz (ties resolve downward); NULL only if empty. */
+const pll_entry_t *pll_table_nearest(uint32_t khz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLL_TABLE_H */
@@ -0,0 +1,139 @@
+/*
+ * ramp_stats.c  –  log2 histograms of ramp_step() phase timings
+ */
+
+#include "ramp_stats.h"
+#include "seqlock.h"
+#include <string.h>
+
+/* Published under s_seq by Core 1 alone.  A reset from Core 0 only bumps
+ * s_reset_gen; Core 1 clears the histograms on its next record, and
+ * readers see a generation behind s_reset_gen as empty. */
+static ramp_stats_t      s_stats;
+static uint32_t          s_gen = 0;
+static seqlock_t         s_seq = SEQLOCK_INIT;
+static volatile uint32_t s_reset_gen = 0;
+
+static const char *const phase_names[RAMP_PHASE_COUNT] = {
+    "vreg_pre",
+    "lockout",
+    "pll",
+    "release",
+    "vreg_post",
+    "stall",
+};
+
+uint32_t ramp_hist_bucket(uint32_t us)
+{
+    if (us == 0) return 0;
+    uint32_t b = 32u - (uint32_t)__builtin_clz(us);   /* 1 -> 1, 2..3 -> 2 */
+    return (b < RAMP_HIST_BUCKETS) ? b : RAMP_HIST_BUCKETS - 1u;
+}
+
+uint32_t ramp_hist_bucket_floor(uint32_t b)
+{
+    return (b == 0) ? 0u : (1u << (b - 1u));
+}
+
+uint32_t ramp_hist_percentile(const ramp_hist_t *h, uint32_t pct)
+{
+    if (!h || h->count == 0) return 0;
+    uint64_t want = ((uint64_t)h->count * pct + 99u) / 100u;
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < RAMP_HIST_BUCKETS; ++b) {
+        seen += h->buckets[b];
+        if (seen >= want) {
+            /* Report the bucket's upper edge, never above the observed max. */
+            uint32_t hi = (b + 1u < RAMP_HIST_BUCKETS) ? (1u << b) : h->max_us;
+            return (hi < h->max_us) ? hi : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+int ramp_vlevel_index(uint32_t mv)
+{
+    if (mv < RAMP_VLEVEL_MIN_MV) return -1;
+    uint32_t i = (mv - RAMP_VLEVEL_MIN_MV) / RAMP_VLEVEL_STEP_MV;
+    return (i < RAMP_VLEVELS) ? (int)i : -1;
+}
+
+const char *ramp_phase_name(ramp_phase_t p)
+{
+    return (p < RAMP_PHASE_COUNT) ? phase_names[p] : "?";
+}
+
+static void hist_add(ramp_hist_t *h, uint32_t us)
+{
+    h->buckets[ramp_hist_bucket(us)]++;
+    h->count++;
+    h->total_us += us;
+    if (us > h->max_us) h->max_us = us;
+}
+
+void ramp_stats_record(const ramp_step_timing_t *t)
+{
+    if (!t || t->dir >= RAMP_DIR_COUNT) return;
+    int vl = ramp_vlevel_index(t->mv);
+
+    seqlock_write_begin(&s_seq);
+    uint32_t gen = s_reset_gen;
+    if (s_gen != gen) {
+        memset(&s_stats, 0, sizeof(s_stats));
+        s_gen = gen;
+    }
+
+    for (uint32_t p = 0; p < RAMP_PHASE_COUNT; ++p) {
+        /* VREG phases only exist on one side of the step. */
+        if (p == RAMP_PHASE_VREG_PRE  && t->dir != RAMP_DIR_UP)   continue;
+        if (p == RAMP_PHASE_VREG_POST && t->dir != RAMP_DIR_DOWN) continue;
+
+        hist_add(&s_stats.by_dir[t->dir][p], t->us[p]);
+        if (vl >= 0)
+            hist_add(&s_stats.by_vlevel[vl][p], t->us[p]);
+    }
+    s_stats.steps++;
+    seqlock_write_end(&s_seq);
+}
+
+/* Copy len bytes at src (inside s_stats) to dst; zeros if a reset is
+ * pending.  Returns false in that case. */
+static bool read_stats(void *dst, const void *src, size_t len)
+{
+    for (;;) {
+        uint32_t v = seqlock_read_begin(&s_seq);
+        uint32_t gen = s_gen;
+        memcpy(dst, src, len);
+        if (seqlock_read_retry(&s_seq, v)) continue;
+        if (gen == s_reset_gen) return true;
+        memset(dst, 0, len);
+        return false;
+    }
+}
+
+void ramp_stats_snapshot(ramp_stats_t *out)
+{
+    if (out) read_stats(out, &s_stats, sizeof(*out));
+}
+
+void ramp_stats_get_hist(ramp_dir_t dir, ramp_phase_t phase, ramp_hist_t *out)
+{
+    if (!out) return;
+    if (dir >= RAMP_DIR_COUNT || phase >= RAMP_PHASE_COUNT) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    read_stats(out, &s_stats.by_dir[dir][phase], sizeof(*out));
+}
+
+uint32_t ramp_stats_steps(void)
+{
+    uint32_t n;
+    read_stats(&n, &s_stats.steps, sizeof(n));
+    return n;
+}
+
+void ramp_stats_reset(void)
+{
+    s_reset_gen++;
+}
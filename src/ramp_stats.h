@@ -0,0 +1,116 @@
+#ifndef RAMP_STATS_H
+#define RAMP_STATS_H
+
+/*
+ * ramp_stats.h  –  per-phase timing of ramp_step() transitions
+ *
+ * Every PLL step is split into phases and each phase duration is binned
+ * into a log2 histogram, keyed both by transition direction and by the
+ * VREG level in force while the PLL was reprogrammed:
+ *
+ *   VREG_PRE   vreg_for_khz() before an up-step
+ *   LOCKOUT    multicore_lockout_start_blocking() until Core 0 is parked
+ *   PLL        pll_sys reprogram (bypass switch + relock + switch back)
+ *   RELEASE    multicore_lockout_end_blocking()
+ *   VREG_POST  vreg_for_khz() after a down-step
+ *   STALL      total Core 0 stall: LOCKOUT + PLL + RELEASE
+ *
+ * Durations come from the 1 µs system timer.  The M0+ has no DWT cycle
+ * counter and SysTick counts clk_sys, which changes mid-measurement, so
+ * the clk_ref-derived timer is the only timebase that stays valid across
+ * a PLL switch.
+ *
+ * Written by Core 1 only (inside ramp_step()) and published under a
+ * seqlock (seqlock.h): readers on either core get a consistent copy that
+ * may be one step stale, and never block the writer.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bucket 0 holds 0 µs; bucket b (>0) holds [2^(b-1), 2^b) µs; the last
+ * bucket is open-ended (>= 16.4 ms). */
+#define RAMP_HIST_BUCKETS   16u
+
+/* VREG levels tracked: 0.85 V .. 1.35 V in 50 mV steps. */
+#define RAMP_VLEVEL_MIN_MV  850u
+#define RAMP_VLEVEL_STEP_MV 50u
+#define RAMP_VLEVELS        11u
+
+typedef enum {
+    RAMP_PHASE_VREG_PRE = 0,
+    RAMP_PHASE_LOCKOUT,
+    RAMP_PHASE_PLL,
+    RAMP_PHASE_RELEASE,
+    RAMP_PHASE_VREG_POST,
+    RAMP_PHASE_STALL,
+    RAMP_PHASE_COUNT,
+} ramp_phase_t;
+
+typedef enum {
+    RAMP_DIR_UP = 0,
+    RAMP_DIR_DOWN,
+    RAMP_DIR_COUNT,
+} ramp_dir_t;
+
+typedef struct {
+    uint32_t buckets[RAMP_HIST_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+} ramp_hist_t;
+
+/* One step's worth of phase durations, filled by ramp_step(). */
+typedef struct {
+    ramp_dir_t dir;
+    uint32_t   mv;                          /* VREG during the PLL phase */
+    uint32_t   us[RAMP_PHASE_COUNT];
+} ramp_step_timing_t;
+
+typedef struct {
+    uint32_t    steps;
+    ramp_hist_t by_dir[RAMP_DIR_COUNT][RAMP_PHASE_COUNT];
+    ramp_hist_t by_vlevel[RAMP_VLEVELS][RAMP_PHASE_COUNT];
+} ramp_stats_t;
+
+/** Record one completed step (Core 1, from ramp_step()). */
+void ramp_stats_record(const ramp_step_timing_t *t);
+
+/** Consistent copy of all histograms (~6 KB: not for a stack). */
+void ramp_stats_snapshot(ramp_stats_t *out);
+
+/** Consistent copy of one per-direction histogram. */
+void ramp_stats_get_hist(ramp_dir_t dir, ramp_phase_t phase, ramp_hist_t *out);
+
+/** Steps recorded since boot or the last reset. */
+uint32_t ramp_stats_steps(void);
+
+/**
+ * Clear all histograms.  Core 1 applies the request on its next record;
+ * until then the getters report empty histograms.
+ */
+void ramp_stats_reset(void);
+
+/** Bucket index for a duration in µs. */
+uint32_t ramp_hist_bucket(uint32_t us);
+
+/** Lower edge (µs) of bucket b. */
+uint32_t ramp_hist_bucket_floor(uint32_t b);
+
+/** Upper bound (µs) below which `pct` percent of samples fall; 0 if empty. */
+uint32_t ramp_hist_percentile(const ramp_hist_t *h, uint32_t pct);
+
+/** Voltage-level index for mv, or -1 if outside the tracked range. */
+int ramp_vlevel_index(uint32_t mv);
+
+const char *ramp_phase_name(ramp_phase_t p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAMP_STATS_H */
@@ -0,0 +1,143 @@
+/*
+ * rt_sched.c  –  clock demand of periodic real-time tasks under EDF
+ */
+
+#include "rt_sched.h"
+#include <string.h>
+
+void rt_sched_init(rt_sched_t *s)
+{
+    memset(s, 0, sizeof(*s));
+}
+
+static rt_task_t *lookup(rt_sched_t *s, int handle)
+{
+    if (handle < 0) return NULL;
+    uint32_t i   = (uint32_t)handle & 0xFFu;
+    uint8_t  gen = (uint8_t)((uint32_t)handle >> 8);
+    if (i >= RT_SCHED_MAX_TASKS) return NULL;
+    rt_task_t *t = &s->task[i];
+    return (t->used && t->gen == gen) ? t : NULL;
+}
+
+int rt_sched_add(rt_sched_t *s, uint32_t period_ms, uint32_t wcet_cycles)
+{
+    if (period_ms == 0 || wcet_cycles == 0) return -1;
+    for (uint32_t i = 0; i < RT_SCHED_MAX_TASKS; ++i) {
+        rt_task_t *t = &s->task[i];
+        if (t->used) continue;
+        uint8_t gen = (uint8_t)(t->gen + 1u);
+        memset(t, 0, sizeof(*t));
+        t->gen         = gen;
+        t->used        = true;
+        t->period_ms   = period_ms;
+        t->wcet_cycles = wcet_cycles;
+        t->cc_cycles   = wcet_cycles;   /* may release at any time */
+        return (int)(((uint32_t)gen << 8) | i);
+    }
+    return -1;
+}
+
+int rt_sched_remove(rt_sched_t *s, int handle)
+{
+    rt_task_t *t = lookup(s, handle);
+    if (!t) return -1;
+    t->used = false;
+    return 0;
+}
+
+/* Count the open job of t as missed if its deadline has passed.  A job
+ * completing at its deadline made it; one still open there did not. */
+static int check_one(rt_sched_t *s, rt_task_t *t, uint64_t now_us, bool open_at)
+{
+    if (!t->open || t->late) return 0;
+    if (open_at ? now_us < t->deadline_us : now_us <= t->deadline_us) return 0;
+    t->late = true;
+    t->misses++;
+    s->misses++;
+    return 1;
+}
+
+int rt_sched_release(rt_sched_t *s, int handle, uint64_t now_us)
+{
+    rt_task_t *t = lookup(s, handle);
+    if (!t) return -1;
+    int missed = check_one(s, t, now_us, true);
+    if (t->open && !t->late) {
+        t->abandoned++;
+        s->abandoned++;
+    }
+    t->open        = true;
+    t->late        = false;
+    t->cc_cycles   = t->wcet_cycles;
+    t->deadline_us = now_us + (uint64_t)t->period_ms * 1000u;
+    t->jobs++;
+    return missed;
+}
+
+int rt_sched_complete(rt_sched_t *s, int handle, uint32_t cycles, uint64_t now_us)
+{
+    rt_task_t *t = lookup(s, handle);
+    if (!t || !t->open) return -1;
+    int missed = check_one(s, t, now_us, false);
+    t->open = false;
+    if (cycles > t->wcet_cycles) {
+        t->overruns++;
+    } else if (cycles && cycles < t->wcet_cycles) {
+        t->cc_cycles = cycles;
+        s->reclaims++;
+    }
+    return missed;
+}
+
+uint32_t rt_sched_check(rt_sched_t *s, uint64_t now_us)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < RT_SCHED_MAX_TASKS; ++i)
+        if (s->task[i].used)
+            n += (uint32_t)check_one(s, &s->task[i], now_us, false);
+    return n;
+}
+
+/* Σ cycles_i / P_i, in cycles per second, then rounded up to kHz. */
+static uint32_t demand_khz(const rt_sched_t *s, bool worst)
+{
+    uint64_t hz = 0;
+    for (uint32_t i = 0; i < RT_SCHED_MAX_TASKS; ++i) {
+        const rt_task_t *t = &s->task[i];
+        if (!t->used) continue;
+        uint64_t c = worst ? t->wcet_cycles : t->cc_cycles;
+        hz += (c * 1000u + t->period_ms - 1u) / t->period_ms;
+    }
+    uint64_t khz = (hz + 999u) / 1000u;
+    return khz > UINT32_MAX ? UINT32_MAX : (uint32_t)khz;
+}
+
+uint32_t rt_sched_demand_khz(const rt_sched_t *s)
+{
+    return demand_khz(s, false);
+}
+
+uint32_t rt_sched_wcet_khz(const rt_sched_t *s)
+{
+    return demand_khz(s, true);
+}
+
+uint64_t rt_sched_next_deadline_us(const rt_sched_t *s)
+{
+    uint64_t next = UINT64_MAX;
+    for (uint32_t i = 0; i < RT_SCHED_MAX_TASKS; ++i) {
+        const rt_task_t *t = &s->task[i];
+        if (t->used && t->open && !t->late && t->deadline_us < next)
+            next = t->deadline_us;
+    }
+    return next;
+}
+
+uint32_t rt_sched_count(const rt_sched_t *s)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < RT_SCHED_MAX_TASKS; ++i)
+        if (s->task[i].used) n++;
+    return n;
+}
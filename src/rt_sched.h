@@ -0,0 +1,101 @@
+#ifndef RT_SCHED_H
+#define RT_SCHED_H
+
+/*
+ * rt_sched.h  –  clock demand of periodic real-time tasks under EDF
+ *
+ * Each task has a period P (also its relative deadline) and a worst-case
+ * execution of C cycles.  On one core under EDF the set meets every
+ * deadline at clock f iff
+ *
+ *   Σ C_i / (P_i · f) ≤ 1,   i.e.   f ≥ Σ C_i / P_i   (cycles/ms = kHz)
+ *
+ * Cycle-conserving EDF (Pillai & Shin): a job that completes after using
+ * c < C cycles lets c stand in for C until the task's next release, when
+ * the worst case applies again.  The demand drops as jobs finish early and
+ * recovers at each release, so the clock only has to cover work that may
+ * still arrive.
+ *
+ * A deadline miss is a job still open at its deadline (seen by
+ * rt_sched_check() or by the task's next release) or completed after it;
+ * each job counts at most once.  A job still open, but not yet late, when
+ * the next one is released early has not missed anything: it is counted
+ * as abandoned instead, since its completion can no longer be reported.
+ *
+ * This module has no Pico SDK dependencies (times are passed in) so the
+ * accounting can be exercised on a host.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RT_SCHED_MAX_TASKS  8u
+
+typedef struct {
+    uint32_t period_ms;
+    uint32_t wcet_cycles;
+    uint32_t cc_cycles;     /* budget in force: C, or c after an early finish */
+    uint64_t deadline_us;   /* of the open (or last) job                     */
+    uint32_t jobs;          /* releases                                      */
+    uint32_t misses;
+    uint32_t overruns;      /* completions reporting more than C cycles      */
+    uint32_t abandoned;     /* open jobs replaced by an early release        */
+    uint8_t  gen;           /* bumped on reuse so stale handles miss         */
+    bool     used;
+    bool     open;          /* released, not yet completed                   */
+    bool     late;          /* open job already counted as a miss            */
+} rt_task_t;
+
+typedef struct {
+    rt_task_t task[RT_SCHED_MAX_TASKS];
+    uint32_t  misses;       /* all tasks, including removed ones             */
+    uint32_t  reclaims;     /* early completions that lowered the demand     */
+    uint32_t  abandoned;    /* all tasks, including removed ones             */
+} rt_sched_t;
+
+void rt_sched_init(rt_sched_t *s);
+
+/** Add a task.  Returns a handle, or -1 if full or an argument is 0. */
+int rt_sched_add(rt_sched_t *s, uint32_t period_ms, uint32_t wcet_cycles);
+
+/** Remove a task.  Returns 0, or -1 for a stale/invalid handle. */
+int rt_sched_remove(rt_sched_t *s, int handle);
+
+/**
+ * A job of the task is released at now_us; its deadline is one period on.
+ * The budget returns to the worst case.  Returns 1 if the previous job was
+ * still open at or past its deadline (a newly counted miss), 0 otherwise
+ * (an open job not yet late is counted as abandoned), -1 for a bad handle.
+ */
+int rt_sched_release(rt_sched_t *s, int handle, uint64_t now_us);
+
+/**
+ * The open job completed at now_us after using `cycles` (0 = unknown: keep
+ * the worst case).  Returns 1 if it finished after its deadline and had not
+ * been counted yet, 0 otherwise, -1 for a bad handle or no open job.
+ */
+int rt_sched_complete(rt_sched_t *s, int handle, uint32_t cycles, uint64_t now_us);
+
+/** Count open jobs past their deadline at now_us.  Returns the new misses. */
+uint32_t rt_sched_check(rt_sched_t *s, uint64_t now_us);
+
+/** Σ cc_i / P_i in kHz, rounded up: the lowest clock that keeps EDF feasible. */
+uint32_t rt_sched_demand_khz(const rt_sched_t *s);
+
+/** Σ C_i / P_i in kHz, rounded up: the demand with no reclaimed cycles. */
+uint32_t rt_sched_wcet_khz(const rt_sched_t *s);
+
+/** Earliest deadline among open jobs, or UINT64_MAX if none. */
+uint64_t rt_sched_next_deadline_us(const rt_sched_t *s);
+
+uint32_t rt_sched_count(const rt_sched_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RT_SCHED_H */
@@ -0,0 +1,101 @@
+/*
+ * rt_task.c  –  periodic real-time tasks for the deadline governor
+ */
+
+#include "rt_task.h"
+#include "pico/stdlib.h"
+#include "pico/sync.h"
+#include <string.h>
+
+static rt_sched_t         s_sched;
+static volatile bool      s_pending = false;
+static critical_section_t s_cs;
+static volatile bool      s_inited  = false;
+
+void rt_task_init(void)
+{
+    if (s_inited) return;
+    critical_section_init(&s_cs);
+    rt_sched_init(&s_sched);
+    s_inited = true;
+}
+
+int rt_task_register(uint32_t period_ms, uint32_t wcet_cycles)
+{
+    if (!s_inited) return -1;
+    critical_section_enter_blocking(&s_cs);
+    int handle = rt_sched_add(&s_sched, period_ms, wcet_cycles);
+    critical_section_exit(&s_cs);
+
+    if (handle >= 0) {
+        s_pending = true;
+        __sev();                    /* demand changed: re-evaluate now */
+    }
+    return handle;
+}
+
+void rt_task_unregister(int handle)
+{
+    if (!s_inited) return;
+    critical_section_enter_blocking(&s_cs);
+    rt_sched_remove(&s_sched, handle);
+    critical_section_exit(&s_cs);
+}
+
+void rt_task_release(int handle)
+{
+    if (!s_inited) return;
+    critical_section_enter_blocking(&s_cs);
+    int rc = rt_sched_release(&s_sched, handle, time_us_64());
+    critical_section_exit(&s_cs);
+
+    if (rc >= 0) {
+        s_pending = true;
+        __sev();                    /* wake Core 1 out of core1_wait_ms() */
+    }
+}
+
+void rt_task_complete(int handle, uint32_t cycles_used)
+{
+    if (!s_inited) return;
+    critical_section_enter_blocking(&s_cs);
+    rt_sched_complete(&s_sched, handle, cycles_used, time_us_64());
+    critical_section_exit(&s_cs);
+}
+
+void rt_task_get_stats(rt_task_stats_t *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    out->next_deadline_us = UINT64_MAX;
+    if (!s_inited) return;
+
+    critical_section_enter_blocking(&s_cs);
+    rt_sched_check(&s_sched, time_us_64());
+    out->tasks      = rt_sched_count(&s_sched);
+    out->demand_khz = rt_sched_demand_khz(&s_sched);
+    out->wcet_khz   = rt_sched_wcet_khz(&s_sched);
+    out->misses     = s_sched.misses;
+    out->reclaims   = s_sched.reclaims;
+    out->abandoned  = s_sched.abandoned;
+    for (uint32_t i = 0; i < RT_SCHED_MAX_TASKS; ++i) {
+        const rt_task_t *t = &s_sched.task[i];
+        if (!t->used) continue;
+        out->jobs     += t->jobs;
+        out->overruns += t->overruns;
+    }
+    out->next_deadline_us = rt_sched_next_deadline_us(&s_sched);
+    critical_section_exit(&s_cs);
+}
+
+bool rt_task_pending(void)
+{
+    return s_pending;
+}
+
+bool rt_task_take(void)
+{
+    bool p = s_pending;
+    s_pending = false;
+    return p;
+}
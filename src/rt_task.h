@@ -0,0 +1,82 @@
+#ifndef RT_TASK_H
+#define RT_TASK_H
+
+/*
+ * rt_task.h  –  periodic real-time tasks for the deadline governor
+ *
+ * Firmware with periodic control loops registers each one as
+ * (period_ms, wcet_cycles) and brackets every job:
+ *
+ *   int h = rt_task_register(10, 400000);    10 ms period, 400k cycles max
+ *   ...
+ *   rt_task_release(h);                      job starts (deadline +10 ms)
+ *   ... work ...
+ *   rt_task_complete(h, cycles_used);        job done
+ *
+ *   rt_task_release()  (either core, IRQ-safe)
+ *     └─ flag + SEV ──► Core 1 leaves core1_wait_ms(); the `deadline`
+ *                       governor raises the clock for the restored worst
+ *                       case before the job can run out of slack
+ *   rt_task_complete() an early finish reclaims the unused cycles until
+ *                       the task's next release (rt_sched.h)
+ *
+ * cycles_used can be taken from the SysTick counter, or as elapsed time ×
+ * the clock; 0 means "not measured" and keeps the worst case.  Deadline
+ * misses are counted here whichever governor is running; the `deadline`
+ * governor also logs them.  Accounting and the demand formula live in
+ * rt_sched.c.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rt_sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t tasks;
+    uint32_t demand_khz;    /* cycle-conserving EDF demand          */
+    uint32_t wcet_khz;      /* the same with every budget at WCET   */
+    uint32_t jobs;          /* releases, registered tasks           */
+    uint32_t misses;        /* deadline misses since boot           */
+    uint32_t overruns;      /* jobs over their WCET, registered tasks */
+    uint32_t reclaims;      /* early completions                    */
+    uint32_t abandoned;     /* open jobs replaced by an early release */
+    uint64_t next_deadline_us; /* earliest open deadline, UINT64_MAX if none */
+} rt_task_stats_t;
+
+/** Call once on Core 0 before launching Core 1. */
+void rt_task_init(void);
+
+/**
+ * Register a periodic task; its deadline is the end of its period.
+ * Returns a handle, or -1 if all RT_SCHED_MAX_TASKS slots are taken or an
+ * argument is 0.
+ */
+int rt_task_register(uint32_t period_ms, uint32_t wcet_cycles);
+
+/** Remove a task.  Stale or invalid handles are ignored. */
+void rt_task_unregister(int handle);
+
+/** A job of the task starts now. */
+void rt_task_release(int handle);
+
+/** The current job finished after cycles_used cycles (0 = unknown). */
+void rt_task_complete(int handle, uint32_t cycles_used);
+
+/** Counters and demand; counts open jobs past their deadline first. */
+void rt_task_get_stats(rt_task_stats_t *out);
+
+/** Core 1: true if a release arrived since the last rt_task_take(). */
+bool rt_task_pending(void);
+
+/** Core 1: consume the pending flag. */
+bool rt_task_take(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RT_TASK_H */
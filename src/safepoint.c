@@ -0,0 +1,204 @@
+/*
+ * safepoint.c  –  cooperative Core 0 parking for PLL reconfiguration
+ *
+ * State machine (s_state):
+ *
+ *   IDLE ──Core 1 post──► POSTED ──Core 0 ack──► PARKED ──Core 1 release──► IDLE
+ *                           │
+ *                           └──Core 1 timeout──► IDLE  (forced lockout)
+ *
+ * Only the two transitions leaving POSTED can race, so only those take
+ * the hardware spin lock; the fast path in safepoint_poll() is one load.
+ */
+
+#include "safepoint.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "seqlock.h"
+#include <string.h>
+
+enum {
+    SP_IDLE = 0,
+    SP_POSTED,
+    SP_PARKED,
+};
+
+static volatile uint32_t s_state   = SP_IDLE;
+static volatile bool     s_enabled = false;
+static volatile uint32_t s_timeout_us = SAFEPOINT_DEFAULT_TIMEOUT_US;
+static spin_lock_t      *s_lock    = NULL;
+
+/* Stats, split by writer so each half has a single owner for its seqlock:
+ * Core 1 counts handshakes and its ack wait, Core 0 its parked time.  A
+ * reset from Core 0 only bumps s_reset_gen; Core 1 zeroes its half on the
+ * next record, and readers treat a half from an older generation as 0. */
+typedef struct {
+    uint32_t handshakes;
+    uint32_t forced;
+    uint32_t ack_wait_max_us;
+    uint64_t ack_wait_total_us;
+    uint32_t gen;
+} core1_stats_t;
+
+typedef struct {
+    uint32_t stall_last_us;
+    uint32_t stall_max_us;
+    uint64_t stall_total_us;
+} core0_stats_t;
+
+static core1_stats_t     s_c1;
+static seqlock_t         s_c1_seq = SEQLOCK_INIT;
+static core0_stats_t     s_c0;
+static seqlock_t         s_c0_seq = SEQLOCK_INIT;
+static volatile uint32_t s_reset_gen = 0;
+
+/* Core 1: open an update of its half, applying a pending reset. */
+static void c1_stats_begin(void)
+{
+    seqlock_write_begin(&s_c1_seq);
+    uint32_t gen = s_reset_gen;
+    if (s_c1.gen != gen) {
+        memset(&s_c1, 0, sizeof(s_c1));
+        s_c1.gen = gen;
+    }
+}
+
+void safepoint_init(void)
+{
+    if (s_lock) return;
+    s_lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+}
+
+void safepoint_set_enabled(bool on)
+{
+    /* The protocol needs the spin lock; stay on forced lockout without it. */
+    s_enabled = on && (s_lock != NULL);
+}
+
+bool safepoint_enabled(void)            { return s_enabled; }
+void safepoint_set_timeout_us(uint32_t us) { s_timeout_us = us; }
+uint32_t safepoint_get_timeout_us(void) { return s_timeout_us; }
+
+/* -------------------------------------------------------------------------
+ * Core 1 side
+ * ------------------------------------------------------------------------- */
+
+bool safepoint_park_core0(void)
+{
+    if (!s_enabled) {
+        multicore_lockout_start_blocking();
+        return false;
+    }
+
+    uint32_t t0 = time_us_32();
+    s_state = SP_POSTED;
+    __sev();
+
+    while (s_state != SP_PARKED) {
+        if (time_us_32() - t0 < s_timeout_us) {
+            tight_loop_contents();
+            continue;
+        }
+
+        /* Timed out: withdraw the request unless Core 0 acked meanwhile. */
+        uint32_t save = spin_lock_blocking(s_lock);
+        bool withdrawn = (s_state == SP_POSTED);
+        if (withdrawn) s_state = SP_IDLE;
+        spin_unlock(s_lock, save);
+
+        if (withdrawn) {
+            c1_stats_begin();
+            s_c1.forced++;
+            seqlock_write_end(&s_c1_seq);
+            multicore_lockout_start_blocking();
+            return false;
+        }
+        break;                  /* lost the race: Core 0 is parked */
+    }
+
+    uint32_t wait_us = time_us_32() - t0;
+    c1_stats_begin();
+    s_c1.handshakes++;
+    s_c1.ack_wait_total_us += wait_us;
+    if (wait_us > s_c1.ack_wait_max_us) s_c1.ack_wait_max_us = wait_us;
+    seqlock_write_end(&s_c1_seq);
+    return true;
+}
+
+void safepoint_release_core0(bool cooperative)
+{
+    if (!cooperative) {
+        multicore_lockout_end_blocking();
+        return;
+    }
+    s_state = SP_IDLE;
+    __sev();
+}
+
+/* -------------------------------------------------------------------------
+ * Core 0 side
+ * ------------------------------------------------------------------------- */
+
+/* Runs from SRAM: Core 0 must not fetch from XIP while clk_sys moves. */
+static void __not_in_flash_func(park_spin)(void)
+{
+    while (s_state == SP_PARKED)
+        tight_loop_contents();
+}
+
+void safepoint_poll(void)
+{
+    if (s_state != SP_POSTED) return;
+
+    uint32_t save = spin_lock_blocking(s_lock);
+    if (s_state != SP_POSTED) {
+        spin_unlock(s_lock, save);
+        return;
+    }
+    s_state = SP_PARKED;
+    spin_unlock(s_lock, save);
+
+    uint32_t ints = save_and_disable_interrupts();
+    uint32_t t0 = time_us_32();
+    park_spin();
+    uint32_t stall_us = time_us_32() - t0;
+    restore_interrupts(ints);
+
+    seqlock_write_begin(&s_c0_seq);
+    s_c0.stall_last_us   = stall_us;
+    s_c0.stall_total_us += stall_us;
+    if (stall_us > s_c0.stall_max_us) s_c0.stall_max_us = stall_us;
+    seqlock_write_end(&s_c0_seq);
+}
+
+/* -------------------------------------------------------------------------
+ * Stats
+ * ------------------------------------------------------------------------- */
+
+void safepoint_get_stats(safepoint_stats_t *out)
+{
+    if (!out) return;
+    core1_stats_t c1;
+    core0_stats_t c0;
+    seqlock_read(&s_c1_seq, &c1, &s_c1, sizeof(c1));
+    seqlock_read(&s_c0_seq, &c0, &s_c0, sizeof(c0));
+    if (c1.gen != s_reset_gen) memset(&c1, 0, sizeof(c1));
+
+    out->handshakes        = c1.handshakes;
+    out->forced            = c1.forced;
+    out->ack_wait_max_us   = c1.ack_wait_max_us;
+    out->ack_wait_total_us = c1.ack_wait_total_us;
+    out->stall_last_us     = c0.stall_last_us;
+    out->stall_max_us      = c0.stall_max_us;
+    out->stall_total_us    = c0.stall_total_us;
+}
+
+/* Core 0 (the shell). */
+void safepoint_reset_stats(void)
+{
+    s_reset_gen++;
+    core0_stats_t zero;
+    memset(&zero, 0, sizeof(zero));
+    seqlock_write(&s_c0_seq, &s_c0, &zero, sizeof(zero));
+}
@@ -0,0 +1,84 @@
+#ifndef SAFEPOINT_H
+#define SAFEPOINT_H
+
+/*
+ * safepoint.h  –  cooperative Core 0 parking for PLL reconfiguration
+ *
+ * By default ramp_step() parks Core 0 with multicore_lockout_start_blocking(),
+ * which interrupts it wherever it happens to be (mid USB transfer, inside
+ * an application time-critical section, ...).  With the handshake enabled,
+ * Core 1 instead posts a pending clock change and waits for Core 0 to
+ * acknowledge it at a declared safe point:
+ *
+ *   Core 1 (ramp_step)                 Core 0 (REPL loop / app yield)
+ *   ------------------                 ------------------------------
+ *   safepoint_park_core0()
+ *     state = POSTED, __sev()  ──────► safepoint_poll()
+ *     wait for PARKED (≤ timeout)        state = PARKED
+ *   reprogram pll_sys                    spin in SRAM, IRQs masked
+ *   safepoint_release_core0()  ──────►   ...state != PARKED → resume
+ *
+ * If Core 0 does not reach a safe point within the timeout, Core 1 withdraws
+ * the request and falls back to the forced multicore lockout.  The POSTED →
+ * PARKED / POSTED → IDLE transitions are arbitrated by a hardware spin lock
+ * so an acknowledge racing the timeout is never lost.
+ *
+ * Application code running long loops on Core 0 should call
+ * safepoint_poll() wherever it is safe to be paused for ~100 µs.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SAFEPOINT_DEFAULT_TIMEOUT_US  2000u
+
+typedef struct {
+    uint32_t handshakes;      /* changes done with Core 0 parked cooperatively */
+    uint32_t forced;          /* timeouts that fell back to multicore_lockout  */
+    uint32_t ack_wait_max_us; /* Core 1 wait for the acknowledge               */
+    uint64_t ack_wait_total_us;
+    uint32_t stall_last_us;   /* Core 0 time parked (cooperative only)         */
+    uint32_t stall_max_us;
+    uint64_t stall_total_us;
+} safepoint_stats_t;
+
+/** Claim the spin lock.  Call once on Core 0 before launching Core 1. */
+void safepoint_init(void);
+
+/** Opt in / out of the cooperative protocol (default: off). */
+void safepoint_set_enabled(bool on);
+bool safepoint_enabled(void);
+
+void     safepoint_set_timeout_us(uint32_t us);
+uint32_t safepoint_get_timeout_us(void);
+
+/**
+ * Core 1: stop Core 0 before touching the PLL.  Returns true if Core 0 is
+ * parked at a safe point, false if the forced lockout was used instead
+ * (handshake disabled, or timeout).  Pass the result to the release call.
+ */
+bool safepoint_park_core0(void);
+
+/** Core 1: let Core 0 continue after the PLL change. */
+void safepoint_release_core0(bool cooperative);
+
+/**
+ * Core 0: declared safe point.  Costs one volatile load when nothing is
+ * pending; otherwise parks until Core 1 releases.
+ */
+void safepoint_poll(void);
+
+/** Consistent snapshot from either core (seqlock.h, no lock taken). */
+void safepoint_get_stats(safepoint_stats_t *out);
+/** Core 0 only. */
+void safepoint_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAFEPOINT_H */
@@ -0,0 +1,101 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+/*
+ * seqlock.h  –  single-writer sequence lock for lock-free snapshots
+ *
+ * The writer bumps the sequence to odd, updates the data, and bumps it
+ * back to even.  Readers copy the data and retry if the sequence was odd
+ * or changed meanwhile:
+ *
+ *   writer (one at a time)            reader (any core, any number)
+ *   ──────────────────────            ─────────────────────────────
+ *   seqlock_write_begin()  seq: 2→3   v = seqlock_read_begin()  (waits while odd)
+ *   ... update data ...               ... copy data ...
+ *   seqlock_write_end()    seq: 3→4   seqlock_read_retry(v)?  → copy again
+ *
+ * Readers never take a lock or mask interrupts, and never delay the
+ * writer.  Rules:
+ *   - Writers must be serialised by the caller (single owner, or a lock
+ *     that only writers take).
+ *   - Never read from an interrupt that can preempt the writer on the same
+ *     core: the reader would wait on an update that cannot finish.
+ *   - Readers must treat the copy as garbage until read_retry() says it
+ *     is consistent; copy into a local, never act on the shared object.
+ *
+ * __dmb() orders the sequence against the data on both the writer and the
+ * reader side (it is also a compiler barrier), so the protected object
+ * needs no volatile qualifier.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    volatile uint32_t seq;
+} seqlock_t;
+
+#define SEQLOCK_INIT { 0u }
+
+static inline void seqlock_write_begin(seqlock_t *s)
+{
+    s->seq++;
+    __dmb();
+}
+
+static inline void seqlock_write_end(seqlock_t *s)
+{
+    __dmb();
+    s->seq++;
+}
+
+static inline uint32_t seqlock_read_begin(const seqlock_t *s)
+{
+    uint32_t v;
+    while ((v = s->seq) & 1u)
+        tight_loop_contents();      /* writer mid-update */
+    __dmb();
+    return v;
+}
+
+static inline bool seqlock_read_retry(const seqlock_t *s, uint32_t v)
+{
+    __dmb();
+    return s->seq != v;
+}
+
+/** Publish `len` bytes from src into the protected object dst. */
+static inline void seqlock_write(seqlock_t *s, void *dst, const void *src, size_t len)
+{
+    seqlock_write_begin(s);
+    memcpy(dst, src, len);
+    seqlock_write_end(s);
+}
+
+/**
+ * Consistent copy of the protected object src into dst.  Returns the
+ * number of retries needed (0 when no writer interfered).
+ */
+static inline uint32_t seqlock_read(const seqlock_t *s, void *dst, const void *src, size_t len)
+{
+    uint32_t retries = 0;
+    for (;;) {
+        uint32_t v = seqlock_read_begin(s);
+        memcpy(dst, src, len);
+        if (!seqlock_read_retry(s, v)) return retries;
+        retries++;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEQLOCK_H */
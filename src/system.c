@@ -3,19 +3,34 @@
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
 #include "hardware/clocks.h"
-#include "hardware/vreg.h"
+#include "hardware/pll.h"
 #include "hardware/sync.h"
-#include "hardware/adc.h"
 #include "system.h"
 #include "dmesg.h"
 #include "governors.h"
 #include "metrics.h"
 #include "uart_log.h"
 #include "pio_idle.h"
+#include "pll_table.h"
+#include "ramp_stats.h"
+#include "safepoint.h"
+#include "vreg_cal.h"
+#include "temp_service.h"
+#include "freq_stats.h"
+#include "energy.h"
+#include "freq_boost.h"
+#include "rt_task.h"
+#include "freq_policy.h"
+#include "trace.h"
+#include "seqlock.h"
 
 /* Ramp constants */
 #define RAMP_STEP_KHZ        5000
 #define RAMP_DELAY_MS        10
+
+/* Bypass clock sources used while pll_sys relocks */
+#define BYPASS_PLL_USB_KHZ   48000
+#define BYPASS_XOSC_KHZ      PLL_TABLE_XOSC_KHZ
 #define TEMP_LOG_INTERVAL_MS 30000
 
 /* Shared globals */
@@ -33,165 +48,332 @@ static const uint32_t THERMAL_CAP_KHZ = 200000; /* maximum safe freq when hot */
 static bool thermal_throttled = false;
 static uint64_t last_thermal_change_ms = 0;
 
+/* Ramp mode + transition latency (written by Core 1 only) */
+static volatile ramp_mode_t   ramp_mode   = RAMP_MODE_STEP;
+static volatile ramp_bypass_t ramp_bypass = RAMP_BYPASS_PLL_USB;
+static ramp_latency_t ramp_lat;      /* 64-bit total: read via ramp_lat_seq */
+static seqlock_t      ramp_lat_seq = SEQLOCK_INIT;
+static uint32_t ramp_goal_khz  = 0;   /* target of the in-flight transition */
+static uint32_t ramp_from_khz  = 0;
+static uint64_t ramp_start_us  = 0;
+
+/* Governor suspension (see governor_suspend()) */
+static volatile bool gov_suspend_req = false;
+static volatile bool gov_parked      = false;
+
+/* Doorbell wakeups (Core 1 only) */
+static uint32_t wake_served_us    = 0;   /* stamp of the doorbell being served */
+static uint32_t wake_count        = 0;
+static uint32_t wake_lat_last_us  = 0;
+static uint32_t wake_lat_max_us   = 0;
+static uint64_t wake_lat_total_us = 0;
+
 /* --------------------------------------------------------------------------
  * Voltage helpers
  * -------------------------------------------------------------------------- */
 
 const char *voltage_label(uint32_t mv)
 {
-    switch (mv) {
-        case 1100: return "1.10V (default)";
-        case 1200: return "1.20V";
-        case 1300: return "1.30V";
-        case 1350: return "1.35V";
-        default:   return "unknown";
-    }
+    static const char *const labels[] = {
+        "0.85V", "0.90V", "0.95V", "1.00V", "1.05V", "1.10V (default)",
+        "1.15V", "1.20V", "1.25V", "1.30V", "1.35V",
+    };
+    if (mv < 850 || mv > 1350 || (mv - 850) % 50) return "unknown";
+    return labels[(mv - 850) / 50];
 }
 
 /* Select the minimum safe VREG setting for a given clock frequency.
- * This is the single authoritative place for voltage/frequency mapping.
+ * This is the single authoritative place for voltage/frequency mapping:
+ * the calibrated band table when one is loaded, otherwise the stock
+ * breakpoints (see vreg_cal.c).
  * Call BEFORE raising frequency, AFTER lowering it. */
 static void vreg_for_khz(uint32_t khz)
 {
-#if defined(VREG_VOLTAGE_1_35)
-    if (khz > 250000) {
-        vreg_set_voltage(VREG_VOLTAGE_1_35);
-        current_voltage_mv = 1350;
-    } else if (khz > 200000) {
-        vreg_set_voltage(VREG_VOLTAGE_1_20);
-        current_voltage_mv = 1200;
-    } else {
-        vreg_set_voltage(VREG_VOLTAGE_DEFAULT);
-        current_voltage_mv = 1100;
+    vreg_apply_mv(vreg_mv_for_khz(khz));
+}
+
+void vreg_prewarm(uint32_t khz)
+{
+    /* Raise only: the running clock must keep its voltage. */
+    if (khz < current_khz) khz = current_khz;
+    uint32_t mv = vreg_mv_for_khz(khz);
+    if (mv > current_voltage_mv)
+        vreg_apply_mv(mv);
+}
+
+/* --------------------------------------------------------------------------
+ * Core 1 pacing
+ * -------------------------------------------------------------------------- */
+
+bool core1_wait_ms(uint32_t ms)
+{
+    /* The governor has made its decision for this tick. */
+    if (wake_served_us) {
+        uint32_t lat = time_us_32() - wake_served_us;
+        wake_count++;
+        wake_lat_last_us   = lat;
+        wake_lat_total_us += lat;
+        if (lat > wake_lat_max_us) wake_lat_max_us = lat;
+        wake_served_us = 0;
     }
-#else
-    if (khz > 250000) {
-        vreg_set_voltage(VREG_VOLTAGE_1_30);
-        current_voltage_mv = 1300;
-    } else if (khz > 200000) {
-        vreg_set_voltage(VREG_VOLTAGE_1_20);
-        current_voltage_mv = 1200;
-    } else {
-        vreg_set_voltage(VREG_VOLTAGE_DEFAULT);
-        current_voltage_mv = 1100;
+
+    /* A SEV between the check and the WFE leaves the event flag set, so
+     * the WFE falls straight through: no lost wakeups. */
+    absolute_time_t until = make_timeout_time_ms(ms);
+    while (!metrics_wake_pending() && !freq_boost_pending() && !rt_task_pending() &&
+           !gov_suspend_req) {
+        if (best_effort_wfe_or_timeout(until))
+            return false;
     }
-#endif
+    return true;
 }
 
 /* --------------------------------------------------------------------------
- * find_achievable_khz -- find nearest PLL-achievable frequency
- *
- * Starting from `candidate`, scans 1 kHz at a time in the direction of
- * `target` until check_sys_clock_khz() confirms the PLL can lock.
+ * Governor suspension
  *
- * The RP2040 PLL is constrained to:
- *   sys_clk = (XOSC[12MHz] * fbdiv) / (postdiv1 * postdiv2)
- *   VCO = XOSC * fbdiv  must be in [750, 1600] MHz
- *   fbdiv in [16, 320], postdiv1/2 in [1, 7]
+ * While suspended, Core 1 skips governor ticks and thermal handling and
+ * only follows target_khz, so a Core 0 owner (VREG calibration) can place
+ * the clock and voltage itself.
+ * -------------------------------------------------------------------------- */
+
+
+bool governor_suspend(uint32_t timeout_ms)
+{
+    gov_suspend_req = true;
+    __sev();                    /* cut a tickless sleep short */
+    uint32_t t0 = to_ms_since_boot(get_absolute_time());
+    while (!gov_parked) {
+        safepoint_poll();
+        if (to_ms_since_boot(get_absolute_time()) - t0 > timeout_ms) {
+            gov_suspend_req = false;
+            return false;
+        }
+        sleep_ms(1);
+    }
+    return true;
+}
+
+void governor_resume(void)
+{
+    gov_suspend_req = false;
+}
+
+bool governor_suspended(void)
+{
+    return gov_parked;
+}
+
+/* --------------------------------------------------------------------------
+ * Ramp mode selection
+ * -------------------------------------------------------------------------- */
+
+void ramp_set_mode(ramp_mode_t mode)        { ramp_mode = mode; }
+ramp_mode_t ramp_get_mode(void)             { return ramp_mode; }
+void ramp_set_bypass(ramp_bypass_t src)     { ramp_bypass = src; }
+ramp_bypass_t ramp_get_bypass(void)         { return ramp_bypass; }
+
+const char *ramp_mode_name(ramp_mode_t mode)
+{
+    return (mode == RAMP_MODE_DIRECT) ? "direct" : "step";
+}
+
+const char *ramp_bypass_name(ramp_bypass_t src)
+{
+    return (src == RAMP_BYPASS_XOSC) ? "xosc" : "pll_usb";
+}
+
+void ramp_get_latency(ramp_latency_t *out)
+{
+    if (!out) return;
+    seqlock_read(&ramp_lat_seq, out, &ramp_lat, sizeof(*out));
+}
+
+/* --------------------------------------------------------------------------
+ * pll_sys_switch -- reprogram pll_sys to a table entry, glitch-free
  *
- * Many round kHz values (e.g. 145000) simply have no valid divisor
- * combination. This function skips over them rather than giving up.
+ * clk_sys is first moved onto the bypass source through the glitchless
+ * mux (clock_configure() handles the aux -> ref -> aux dance), pll_sys is
+ * re-initialised with the stored divisors, then clk_sys and clk_peri are
+ * moved back.  Equivalent to set_sys_clock_pll() but with a selectable
+ * bypass and without reconfiguring clk_ref on every call.
  *
- * Returns the nearest achievable kHz, which will be <= target when
- * stepping up and >= target when stepping down.
+ * Caller must hold Core 0 off the bus (multicore_lockout).
  * -------------------------------------------------------------------------- */
-static uint32_t find_achievable_khz(uint32_t candidate, uint32_t target)
+static void pll_sys_switch(const pll_entry_t *e)
 {
-    bool up = (candidate <= target);
-    uint32_t limit = up ? target : candidate;
-    uint32_t probe = candidate;
-
-    /* Scan at most ~50 kHz away (50 iterations of 1 kHz) before giving up.
-     * In practice the RP2040 always has a valid frequency within a few kHz. */
-    for (int i = 0; i < 50; i++) {
-        uint vco, pd1, pd2;
-        if (check_sys_clock_khz(probe, &vco, &pd1, &pd2))
-            return probe;
-
-        if (up) {
-            probe++;
-            if (probe > limit) break;
-        } else {
-            if (probe == 0) break;
-            probe--;
-            if (probe < limit) break;
-        }
+    const uint32_t hz = e->khz * 1000u;
+
+    if (ramp_bypass == RAMP_BYPASS_XOSC) {
+        /* clk_ref is already sourced from XOSC by the SDK runtime init. */
+        clock_configure(clk_sys,
+                        CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLK_REF, 0,
+                        BYPASS_XOSC_KHZ * 1000u, BYPASS_XOSC_KHZ * 1000u);
+    } else {
+        clock_configure(clk_sys,
+                        CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                        CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB,
+                        BYPASS_PLL_USB_KHZ * 1000u, BYPASS_PLL_USB_KHZ * 1000u);
     }
 
-    /* Fallback: return target itself and let set_sys_clock_khz decide. */
-    return target;
+    pll_init(pll_sys, PLL_COMMON_REFDIV, e->vco_khz * 1000u,
+             e->postdiv1, e->postdiv2);
+
+    clock_configure(clk_sys,
+                    CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS,
+                    hz, hz);
+    clock_configure(clk_peri, 0,
+                    CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS,
+                    hz, hz);
+}
+
+/* --------------------------------------------------------------------------
+ * next_step_entry -- resolve one ramp step against the PLL table
+ *
+ * `candidate` is current_khz +/- RAMP_STEP_KHZ, already clamped to the
+ * snapped target.  Stepping up takes the first achievable frequency at or
+ * above the candidate; stepping down the last one at or below it.  Because
+ * the target is itself a table entry the result never overshoots it, and
+ * because the candidate is strictly past current_khz every step makes
+ * progress.
+ * -------------------------------------------------------------------------- */
+static const pll_entry_t *next_step_entry(uint32_t candidate, bool up)
+{
+    return up ? pll_table_ceil(candidate) : pll_table_floor(candidate);
+}
+
+/* Keep a governor-selected target inside the policy range (see
+ * freq_policy.h).  A suspended governor's owner (VREG calibration) places
+ * the clock itself. */
+static uint32_t policy_clamp(uint32_t khz)
+{
+    if (gov_suspend_req) return khz;
+    return freq_policy_clamp(khz);
+}
+
+static bool ramp_step_ex(uint32_t new_khz, bool direct);
+
+bool ramp_step(uint32_t new_khz)
+{
+    return ramp_step_ex(policy_clamp(new_khz), ramp_mode == RAMP_MODE_DIRECT);
 }
 
 /* --------------------------------------------------------------------------
  * ramp_step  -- advance exactly one step toward new_khz
  *
+ * In RAMP_MODE_STEP a step is at most RAMP_STEP_KHZ; in RAMP_MODE_DIRECT
+ * (or for a boost, `direct`) the single step lands on the final frequency.
+ * ramp_step() first clamps new_khz to the policy range.
  * Voltage sequencing rules:
  *   Ramping UP:   raise voltage BEFORE changing clock (never under-volt)
  *   Ramping DOWN: lower voltage AFTER  changing clock (never over-volt)
  *
- * Non-achievable PLL frequencies are skipped transparently via
- * find_achievable_khz() -- the ramp continues rather than aborting.
+ * Targets are snapped to the nearest entry of the precomputed PLL table
+ * (pll_table.c), so unachievable or out-of-range requests terminate at the
+ * closest real frequency instead of being probed on every call.
  *
  * Returns: true  if target reached (caller can stop looping)
  *          false if more steps remain
  *
  * Safe to call from Core 1. Does NOT sleep -- caller controls pacing.
  * -------------------------------------------------------------------------- */
-bool ramp_step(uint32_t new_khz)
+static bool ramp_step_ex(uint32_t new_khz, bool direct)
 {
+    const pll_entry_t *goal = pll_table_nearest(new_khz);
+    if (!goal) {
+        dmesg_log("ramp_step: PLL table empty -- pll_table_init() not called");
+        return true;
+    }
+    new_khz = goal->khz;
+
     if (current_khz == new_khz)
         return true;
 
+    if (new_khz != ramp_goal_khz) {
+        /* New transition (or the target moved mid-ramp): restart the clock. */
+        ramp_goal_khz = new_khz;
+        ramp_from_khz = current_khz;
+        ramp_start_us = to_us_since_boot(get_absolute_time());
+    }
+
     bool stepping_up = (current_khz < new_khz);
-    uint32_t candidate;
+    const pll_entry_t *next;
 
-    if (stepping_up) {
-        candidate = current_khz + RAMP_STEP_KHZ;
-        if (candidate > new_khz) candidate = new_khz;
+    if (direct) {
+        next = goal;                /* single hop to the final divisors */
     } else {
-        candidate = current_khz - RAMP_STEP_KHZ;
-        if (candidate < new_khz) candidate = new_khz;
+        uint32_t candidate;
+        if (stepping_up) {
+            candidate = current_khz + RAMP_STEP_KHZ;
+            if (candidate > new_khz) candidate = new_khz;
+        } else {
+            candidate = current_khz - RAMP_STEP_KHZ;
+            if (candidate < new_khz) candidate = new_khz;
+        }
+        next = next_step_entry(candidate, stepping_up);
     }
+    uint32_t next_khz = next->khz;
 
-    /* Resolve to the nearest kHz the PLL can actually lock to. */
-    uint32_t next_khz = find_achievable_khz(candidate, new_khz);
+    ramp_step_timing_t tm;
+    memset(&tm, 0, sizeof(tm));
+    tm.dir = stepping_up ? RAMP_DIR_UP : RAMP_DIR_DOWN;
+    uint32_t t0 = time_us_32();
 
     if (stepping_up) {
         /* Raise voltage first so the new frequency is always safe. */
         vreg_for_khz(next_khz);
     }
     /* Stepping down: voltage is still sufficient for current_khz; safe. */
-
-    /* Pause the other core for the duration of the PLL reconfiguration.
-     * multicore_lockout requires the other core to have called
-     * multicore_lockout_victim_init() during startup (done in main). */
-    multicore_lockout_start_blocking();
-    bool ok = set_sys_clock_khz(next_khz, false);
-    multicore_lockout_end_blocking();
-
-    if (!ok) {
-        /* check_sys_clock_khz said this was achievable but set failed --
-         * the frequency is right on the PLL edge for this silicon.
-         * Do NOT update current_khz: the hardware did not move.
-         * Pull target_khz back to wherever we actually are so the governor
-         * stops retrying this unachievable frequency. */
-        char err[96];
-        snprintf(err, sizeof(err),
-                 "ramp_step: PLL edge at %u kHz -- clamping target to actual %u kHz",
-                 next_khz, current_khz);
-        dmesg_log(err);
-        target_khz = current_khz;   /* tell governor: this is as high as we go */
-        return true;                /* stop ramping, current_khz is still correct */
-    }
+    uint32_t t1 = time_us_32();
+    tm.mv = current_voltage_mv;
+
+    /* Pause the other core for the duration of the PLL reconfiguration:
+     * cooperatively at a Core 0 safe point when the handshake is enabled,
+     * otherwise (or on timeout) with multicore_lockout, which requires
+     * multicore_lockout_victim_init() on Core 0 (done in main).
+     * The divisors come straight from the table; nothing is re-solved. */
+    bool coop = safepoint_park_core0();
+    uint32_t t2 = time_us_32();
+    pll_sys_switch(next);
+    uint32_t t3 = time_us_32();
+    safepoint_release_core0(coop);
+    uint32_t t4 = time_us_32();
 
     if (!stepping_up) {
         /* Safe to lower voltage now that the clock is already slower. */
         vreg_for_khz(next_khz);
     }
-
+    uint32_t t5 = time_us_32();
+
+    tm.us[RAMP_PHASE_VREG_PRE]  = t1 - t0;
+    tm.us[RAMP_PHASE_LOCKOUT]   = t2 - t1;
+    tm.us[RAMP_PHASE_PLL]       = t3 - t2;
+    tm.us[RAMP_PHASE_RELEASE]   = t4 - t3;
+    tm.us[RAMP_PHASE_VREG_POST] = t5 - t4;
+    /* A cooperative Core 0 keeps running while Core 1 waits for its ack. */
+    tm.us[RAMP_PHASE_STALL]     = coop ? (t4 - t2) : (t4 - t1);
+    ramp_stats_record(&tm);
+
+    freq_stats_record(current_khz, next_khz);
     current_khz = next_khz;
+    energy_update();
     pio_idle_notify_freq_change(current_khz);
-    return (current_khz == new_khz);
+
+    if (current_khz != new_khz)
+        return false;
+
+    uint64_t lat_us = to_us_since_boot(get_absolute_time()) - ramp_start_us;
+    if (lat_us > UINT32_MAX) lat_us = UINT32_MAX;
+    seqlock_write_begin(&ramp_lat_seq);
+    ramp_lat.transitions++;
+    ramp_lat.last_us       = (uint32_t)lat_us;
+    ramp_lat.total_us     += lat_us;
+    ramp_lat.last_from_khz = ramp_from_khz;
+    ramp_lat.last_to_khz   = new_khz;
+    if (lat_us > ramp_lat.max_us) ramp_lat.max_us = (uint32_t)lat_us;
+    seqlock_write_end(&ramp_lat_seq);
+    ramp_goal_khz = 0;
+    return true;
 }
 
 /* --------------------------------------------------------------------------
@@ -235,12 +417,11 @@ void ramp_to(uint32_t new_khz)
  * Temperature / ADC
  * -------------------------------------------------------------------------- */
 
+/* Filtered value from the DMA-fed temperature service: non-blocking and
+ * lock-free, so either core may call it (see temp_service.h). */
 float read_onboard_temperature(void)
 {
-    adc_select_input(4);
-    const float conversion_factor = 3.3f / (1 << 12);
-    float adc_v = (float)adc_read() * conversion_factor;
-    return 27.0f - (adc_v - 0.706f) / 0.001721f;
+    return temp_service_celsius();
 }
 
 /* --------------------------------------------------------------------------
@@ -250,6 +431,8 @@ float read_onboard_temperature(void)
 void core1_entry(void)
 {
     dmesg_log("Governor started on core1");
+    /* Lets Core 0 hold us off XIP while it rewrites flash (persist.c). */
+    multicore_lockout_victim_init();
 
     governors_init();
     if (!governors_get_current())
@@ -258,11 +441,49 @@ void core1_entry(void)
     uint32_t last_stat_ms          = to_ms_since_boot(get_absolute_time());
     uint32_t local_gov_tick_count  = 0;
     double   local_gov_tick_avg_ms = 0.0;
+    uint32_t tickless_sleeps       = 0;
 
     while (true) {
+        /* Single writer of the shared temperature filter. */
+        temp_service_poll();
+
+        if (gov_suspend_req) {
+            gov_parked = true;
+            if (target_khz != current_khz)
+                ramp_step(target_khz);
+            core1_wdt_ping++;
+            sleep_ms(RAMP_DELAY_MS);
+            continue;
+        }
+        gov_parked = false;
+
+        /* Consume the doorbell before aggregating so the sample that rang
+         * it is part of this tick's input. */
+        uint32_t rung_us = metrics_wake_take();
+        if (rung_us) wake_served_us = rung_us;
+
+        /* A task release only needs this tick; the governor reads the
+         * demand itself (rt_task.h). */
+        rt_task_take();
+
         const Governor *g = governors_get_current();
+
+        /* Boost fast path: a new request hops straight to its floor with
+         * the voltage raised first, instead of waiting for the governor
+         * to step there at its own pace.  Governors that sequence every
+         * step themselves (no_fast_ramp) only get the early tick. */
+        if (freq_boost_take() && !(g && g->no_fast_ramp)) {
+            uint32_t floor = policy_clamp(current_khz);
+            if (floor > current_khz) {
+                vreg_prewarm(floor);
+                ramp_step_ex(floor, true);
+            }
+        }
+
         metrics_agg_t agg;
+        metrics_stats_update();          /* decaying windows: p50/p95/max */
         metrics_get_aggregate(&agg, 1);  /* CLEAR metrics each tick so each cycle sees fresh data */
+        trace_record_tick(&agg);         /* no-op unless `trace start` */
 
         uint32_t now_ms = to_ms_since_boot(get_absolute_time());
         if (live_stats && (now_ms - last_stat_ms) >= stat_period_ms) {
@@ -280,21 +501,24 @@ void core1_entry(void)
             last_stat_ms = now_ms;
         }
 
-        /* Global thermal management: enforce a conservative cap when hot.
-         * Apply hysteresis so we don't oscillate when temperature hovers.
+        /* Global thermal management: cap the policy range when hot.
+         * Engage on the predicted temperature so a fast rise is caught
+         * early; release only once both filtered and predicted values are
+         * below the restore point (hysteresis).
          */
-        float cur_temp = read_onboard_temperature();
-        if (!thermal_throttled && cur_temp > THERMAL_BACKOFF_C) {
-            /* Enter thermal throttle: cap the target and mark active */
-            if (target_khz > THERMAL_CAP_KHZ) {
-                target_khz = THERMAL_CAP_KHZ;
-            }
+        temp_reading_t tr;
+        temp_service_read(&tr);
+        if (!thermal_throttled && tr.predicted_c > THERMAL_BACKOFF_C) {
+            /* Enter thermal throttle: cap scaling_max and mark active */
+            freq_policy_set(FREQ_POLICY_THERMAL, 0, THERMAL_CAP_KHZ);
             thermal_throttled = true;
             throttle_active = true;
             last_thermal_change_ms = now_ms;
             dmesg_log("THERMAL: throttle engaged - capping target");
-        } else if (thermal_throttled && cur_temp < THERMAL_RESTORE_C) {
+        } else if (thermal_throttled && tr.celsius < THERMAL_RESTORE_C
+                                     && tr.predicted_c < THERMAL_RESTORE_C) {
             /* Exit throttle: allow governors to resume normal behavior */
+            freq_policy_clear(FREQ_POLICY_THERMAL);
             thermal_throttled = false;
             throttle_active = false;
             last_thermal_change_ms = now_ms;
@@ -302,21 +526,94 @@ void core1_entry(void)
         }
 
         if (g && g->tick) {
+            /* Governors choose within [scaling_min, scaling_max]. */
+            target_khz = freq_policy_clamp(target_khz);
             uint64_t t0 = to_us_since_boot(get_absolute_time());
             g->tick(&agg);
             uint64_t t1 = to_us_since_boot(get_absolute_time());
-            double delta_ms = (double)(t1 - t0) / 1000.0;
+            double delta_ms = (double)(t1 - t0) / 1000.0;   /* execution only */
+            core1_wdt_ping++;
+
+            /* Next tick: one sampling period, sooner if the governor asked;
+               in tickless mode, with nothing pending, only the thermal
+               deadline (doorbells and boosts still wake us at once). */
+            uint32_t req  = governor_take_tick_request();
+            uint32_t wait = governor_sampling_rate_ms(g);
+            if (req < wait) wait = req;
+            if (governors_tickless() && req == GOV_TICK_NONE && agg.count == 0 &&
+                target_khz == current_khz && wait < GOV_TICKLESS_MAX_MS) {
+                wait = GOV_TICKLESS_MAX_MS;
+                tickless_sleeps++;
+            }
 
             local_gov_tick_count++;
             local_gov_tick_avg_ms =
                 ((local_gov_tick_avg_ms * (local_gov_tick_count - 1)) + delta_ms)
                 / local_gov_tick_count;
 
+            ramp_latency_t lat;
+            ramp_get_latency(&lat);
+
             kernel_metrics_t snap;
             snap.gov_tick_count  = local_gov_tick_count;
             snap.gov_tick_avg_ms = local_gov_tick_avg_ms;
             snap.last_ts_ms      = to_ms_since_boot(get_absolute_time());
+            snap.ramp_transitions     = lat.transitions;
+            snap.ramp_last_latency_us = lat.last_us;
+            snap.ramp_max_latency_us  = lat.max_us;
+            snap.ramp_avg_latency_us  = lat.transitions
+                                      ? (uint32_t)(lat.total_us / lat.transitions) : 0;
+
+            /* Core 0 stall per PLL step, merged over both directions. */
+            static ramp_hist_t su, sd;   /* 160 B: off Core 1's stack too */
+            ramp_stats_get_hist(RAMP_DIR_UP,   RAMP_PHASE_STALL, &su);
+            ramp_stats_get_hist(RAMP_DIR_DOWN, RAMP_PHASE_STALL, &sd);
+            uint32_t stall_n = su.count + sd.count;
+            snap.ramp_steps         = ramp_stats_steps();
+            snap.ramp_stall_avg_us  = stall_n
+                                    ? (uint32_t)((su.total_us + sd.total_us) / stall_n) : 0;
+            snap.ramp_stall_max_us  = (su.max_us > sd.max_us) ? su.max_us : sd.max_us;
+            for (uint32_t b = 0; b < RAMP_HIST_BUCKETS; ++b)
+                snap.ramp_stall_hist[b] = su.buckets[b] + sd.buckets[b];
+            ramp_stats_get_hist(RAMP_DIR_UP,   RAMP_PHASE_PLL, &su);
+            ramp_stats_get_hist(RAMP_DIR_DOWN, RAMP_PHASE_PLL, &sd);
+            snap.ramp_pll_max_us    = (su.max_us > sd.max_us) ? su.max_us : sd.max_us;
+
+            safepoint_stats_t sp;
+            safepoint_get_stats(&sp);
+            snap.sp_handshakes   = sp.handshakes;
+            snap.sp_forced       = sp.forced;
+            snap.sp_stall_max_us = sp.stall_max_us;
+            snap.sp_stall_avg_us = sp.handshakes
+                                 ? (uint32_t)(sp.stall_total_us / sp.handshakes) : 0;
+
+            /* ~0.9 KB with the transition table: keep it off Core 1's
+               2 KB stack, which the governor tick runs on top of. */
+            static freq_stats_t fs;
+            freq_stats_snapshot(&fs);
+            for (uint32_t b = 0; b < FREQ_STATS_BUCKETS; ++b)
+                snap.freq_residency_ms[b] = (uint32_t)(fs.residency_us[b] / 1000u);
+            snap.freq_trans_total = fs.trans_total;
+
+            snap.wake_count           = wake_count;
+            snap.wake_last_latency_us = wake_lat_last_us;
+            snap.wake_max_latency_us  = wake_lat_max_us;
+            snap.wake_avg_latency_us  = wake_count
+                                      ? (uint32_t)(wake_lat_total_us / wake_count) : 0;
+
+            freq_boost_stats_t bs;
+            freq_boost_get_stats(&bs);
+            snap.boost_requests  = bs.requests;
+            snap.boost_active    = bs.active;
+            snap.boost_floor_khz = bs.floor_khz;
+            snap.boost_time_ms   = (uint32_t)(bs.boosted_us / 1000u);
+
+            snap.gov_sampling_ms = governor_sampling_rate_ms(g);
+            snap.tickless        = governors_tickless();
+            snap.tickless_sleeps = tickless_sleeps;
             metrics_publish_kernel(&snap);
+
+            core1_wait_ms(wait);
         } else {
             sleep_ms(50);
         }
@@ -13,7 +13,8 @@ float read_onboard_temperature(void);
 
 /* Frequency ramping
  *
- * ramp_step() -- advance one RAMP_STEP_KHZ step toward new_khz.
+ * ramp_step() -- advance one step toward new_khz (one RAMP_STEP_KHZ step,
+ *   or straight to new_khz in RAMP_MODE_DIRECT).
  *   Handles voltage sequencing (raise before up, lower after down).
  *   Does NOT sleep. Returns true when target is reached.
  *   Safe to call from Core 1.
@@ -24,6 +25,77 @@ float read_onboard_temperature(void);
 bool ramp_step(uint32_t new_khz);
 void ramp_to(uint32_t new_khz);
 
+/* Ramp transition mode
+ *
+ * RAMP_MODE_STEP   -- one RAMP_STEP_KHZ step per ramp_step() call (default).
+ * RAMP_MODE_DIRECT -- single hop: clk_sys is parked glitchlessly on the
+ *   bypass source, pll_sys is reprogrammed once to the final divisors and
+ *   clk_sys switches back, all inside one multicore_lockout window.
+ *
+ * The bypass source (pll_usb @ 48 MHz or XOSC @ 12 MHz) is used by both
+ * modes while pll_sys relocks.
+ */
+typedef enum {
+    RAMP_MODE_STEP = 0,
+    RAMP_MODE_DIRECT,
+} ramp_mode_t;
+
+typedef enum {
+    RAMP_BYPASS_PLL_USB = 0,
+    RAMP_BYPASS_XOSC,
+} ramp_bypass_t;
+
+void          ramp_set_mode(ramp_mode_t mode);
+ramp_mode_t   ramp_get_mode(void);
+void          ramp_set_bypass(ramp_bypass_t src);
+ramp_bypass_t ramp_get_bypass(void);
+const char   *ramp_mode_name(ramp_mode_t mode);
+const char   *ramp_bypass_name(ramp_bypass_t src);
+
+/* End-to-end transition latency: from the first ramp_step() toward a new
+ * target until current_khz reaches it (includes governor pacing between
+ * steps).  A transition whose target changes mid-way is restarted. */
+typedef struct {
+    uint32_t transitions;     /* completed transitions                 */
+    uint32_t last_us;         /* latency of the most recent transition */
+    uint32_t max_us;
+    uint64_t total_us;        /* sum, for averaging                    */
+    uint32_t last_from_khz;
+    uint32_t last_to_khz;
+} ramp_latency_t;
+
+void ramp_get_latency(ramp_latency_t *out);
+
+/* Core 1 pacing
+ *
+ * core1_wait_ms() -- the inter-tick wait core1_entry() runs after each
+ *   governor tick (governors no longer sleep themselves, see governors.h).
+ *   Sleeps (WFE) for up to ms, returning early (true) when a
+ *   metrics_submit() rings the wakeup doorbell, a boost is requested, an
+ *   rt_task job is released or a governor suspend is pending.  Also
+ *   closes the submit-to-decision latency sample for the doorbell that
+ *   started the current tick.
+ *   Core 1 only.
+ */
+bool core1_wait_ms(uint32_t ms);
+
+/* Voltage
+ *
+ * vreg_prewarm() -- raise VREG ahead of a ramp toward khz (using the
+ *   calibrated table when loaded).  Never lowers the voltage.
+ */
+void vreg_prewarm(uint32_t khz);
+
+/* Governor suspension (Core 0)
+ *
+ * governor_suspend() -- stop governor ticks; Core 1 keeps following
+ *   target_khz.  Blocks until Core 1 acknowledges; false on timeout.
+ * governor_resume()  -- hand control back to the current governor.
+ */
+bool governor_suspend(uint32_t timeout_ms);
+void governor_resume(void);
+bool governor_suspended(void);
+
 /* Display */
 void print_stats(void);
 const char *voltage_label(uint32_t mv);
@@ -0,0 +1,143 @@
+/*
+ * temp_service.c  –  shared die-temperature sampling service
+ */
+
+#include "temp_service.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "dmesg.h"
+#include "seqlock.h"
+
+#define TEMP_ADC_INPUT     4u
+#define TEMP_RING_BYTES    (TEMP_RING_SAMPLES * sizeof(uint16_t))
+#define TEMP_RING_BITS     7u          /* log2(TEMP_RING_BYTES) for the DMA ring */
+#define TEMP_MIN_DT_MS     10u         /* ignore polls closer than this */
+#define ADC_CLK_HZ         48000000u
+
+_Static_assert(TEMP_RING_BYTES == (1u << TEMP_RING_BITS),
+               "TEMP_RING_BITS must match the ring size");
+
+/* DMA write-wrap requires natural alignment of the ring. */
+static uint16_t s_ring[TEMP_RING_SAMPLES] __attribute__((aligned(TEMP_RING_BYTES)));
+static int      s_dma_chan = -1;
+
+/* Filter state (Core 1 only after init) */
+static float    s_filt_c    = 0.0f;
+static float    s_slope     = 0.0f;
+static uint32_t s_last_ms   = 0;
+static uint32_t s_updates   = 0;
+static volatile uint32_t s_horizon_ms = TEMP_PREDICT_HORIZON_MS;
+
+/* Published snapshot (Core 1 is the single writer). */
+static seqlock_t         s_lock = SEQLOCK_INIT;
+static temp_reading_t    s_pub;
+
+static float raw_to_c(float raw)
+{
+    const float conversion_factor = 3.3f / (1 << 12);
+    float adc_v = raw * conversion_factor;
+    return 27.0f - (adc_v - 0.706f) / 0.001721f;
+}
+
+static void publish(uint32_t now_ms)
+{
+    temp_reading_t r;
+    r.celsius       = s_filt_c;
+    r.slope_c_per_s = s_slope;
+    r.predicted_c   = s_filt_c + s_slope * ((float)s_horizon_ms / 1000.0f);
+    r.ts_ms         = now_ms;
+    r.updates       = s_updates;
+
+    seqlock_write(&s_lock, &s_pub, &r, sizeof(r));
+}
+
+void temp_service_init(void)
+{
+    if (s_dma_chan >= 0) return;
+
+    /* Seed the ring and the filter from one blocking conversion; nothing
+     * else touches the ADC once it is free-running. */
+    adc_select_input(TEMP_ADC_INPUT);
+    uint16_t seed = adc_read();
+    for (uint32_t i = 0; i < TEMP_RING_SAMPLES; ++i) s_ring[i] = seed;
+    s_filt_c  = raw_to_c((float)seed);
+    s_last_ms = to_ms_since_boot(get_absolute_time());
+    publish(s_last_ms);
+
+    adc_fifo_setup(true,    /* write conversions to the FIFO   */
+                   true,    /* DREQ when at least one sample    */
+                   1,
+                   false,   /* no error bit in the sample       */
+                   false);  /* keep all 12 bits                 */
+    adc_set_clkdiv((float)(ADC_CLK_HZ / TEMP_SAMPLE_HZ) - 1.0f);
+
+    s_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config((uint)s_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, TEMP_RING_BITS);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure((uint)s_dma_chan, &c, s_ring, &adc_hw->fifo,
+                          UINT32_MAX, true);
+
+    adc_run(true);
+    dmesg_log("temp: ADC ch4 free-running into DMA ring");
+}
+
+void temp_service_poll(void)
+{
+    if (s_dma_chan < 0) return;
+
+    /* UINT32_MAX transfers last ~49 days at 1 kHz; re-arm when spent. */
+    if (!dma_channel_is_busy((uint)s_dma_chan))
+        dma_channel_set_trans_count((uint)s_dma_chan, UINT32_MAX, true);
+
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    uint32_t dt  = now - s_last_ms;
+    if (dt < TEMP_MIN_DT_MS) return;
+
+    /* Boxcar over the ring: the last TEMP_RING_SAMPLES ms of conversions. */
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < TEMP_RING_SAMPLES; ++i)
+        sum += s_ring[i] & 0x0FFFu;
+    float c = raw_to_c((float)sum / (float)TEMP_RING_SAMPLES);
+
+    /* Time-based EWMAs so irregular poll spacing (doorbell wakeups,
+     * 40–200 ms governor pacing) does not change the filter response. */
+    float a    = (float)dt / (float)(TEMP_FILTER_TAU_MS + dt);
+    float filt = s_filt_c + a * (c - s_filt_c);
+    float inst = (filt - s_filt_c) * 1000.0f / (float)dt;
+    float b    = (float)dt / (float)(TEMP_SLOPE_TAU_MS + dt);
+    s_slope   += b * (inst - s_slope);
+    s_filt_c   = filt;
+    s_last_ms  = now;
+    s_updates++;
+
+    publish(now);
+}
+
+void temp_service_read(temp_reading_t *out)
+{
+    if (!out) return;
+    seqlock_read(&s_lock, out, &s_pub, sizeof(*out));
+}
+
+float temp_service_celsius(void)
+{
+    temp_reading_t r;
+    temp_service_read(&r);
+    return r.celsius;
+}
+
+float temp_service_predicted_c(void)
+{
+    temp_reading_t r;
+    temp_service_read(&r);
+    return r.predicted_c;
+}
+
+void     temp_service_set_horizon_ms(uint32_t ms) { s_horizon_ms = ms; }
+uint32_t temp_service_get_horizon_ms(void)        { return s_horizon_ms; }
@@ -0,0 +1,67 @@
+#ifndef TEMP_SERVICE_H
+#define TEMP_SERVICE_H
+
+/*
+ * temp_service.h  –  shared die-temperature sampling service
+ *
+ * The ADC free-runs on channel 4 (internal temperature sensor) at
+ * TEMP_SAMPLE_HZ and a DMA channel streams the FIFO into a small ring
+ * buffer, so no core ever blocks on, or races for, the ADC:
+ *
+ *   ADC ch4 ──DREQ_ADC──► DMA ──► ring[TEMP_RING_SAMPLES] (write-wrap)
+ *                                   │
+ *   temp_service_poll()  (Core 1) ◄─┘  boxcar mean → EWMA → °C/s slope
+ *     └─ publishes {°C, slope, predicted °C, timestamp} under a seqlock
+ *
+ *   temp_service_read()  (either core)  lock-free snapshot, retried if
+ *                                        the writer was mid-update
+ *
+ * The predicted value extrapolates the filtered temperature by the slope
+ * over a configurable horizon; thermal throttling acts on it so a fast
+ * rise is caught before the raw sensor crosses the limit.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEMP_SAMPLE_HZ             1000u
+#define TEMP_RING_SAMPLES          64u     /* power of two; 128-byte ring */
+#define TEMP_FILTER_TAU_MS         500u    /* EWMA time constant, °C     */
+#define TEMP_SLOPE_TAU_MS          2000u   /* EWMA time constant, °C/s   */
+#define TEMP_PREDICT_HORIZON_MS    2000u   /* default look-ahead         */
+
+typedef struct {
+    float    celsius;          /* filtered temperature              */
+    float    slope_c_per_s;    /* filtered rate of change           */
+    float    predicted_c;      /* celsius + slope * horizon         */
+    uint32_t ts_ms;            /* ms since boot of the last update  */
+    uint32_t updates;          /* polls that published a value      */
+} temp_reading_t;
+
+/**
+ * Claim a DMA channel, start the ADC free-running on channel 4 and seed
+ * the filter with one synchronous conversion.  Call once on Core 0 after
+ * adc_init() / adc_set_temp_sensor_enabled(), before launching Core 1.
+ */
+void temp_service_init(void);
+
+/** Fold the latest ring contents into the filter.  Core 1 only (single writer). */
+void temp_service_poll(void);
+
+/** Lock-free snapshot; safe from either core. */
+void  temp_service_read(temp_reading_t *out);
+float temp_service_celsius(void);
+float temp_service_predicted_c(void);
+
+void     temp_service_set_horizon_ms(uint32_t ms);
+uint32_t temp_service_get_horizon_ms(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEMP_SERVICE_H */
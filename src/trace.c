@@ -0,0 +1,112 @@
+/*
+ * trace.c  –  governor input recorder for host replay
+ */
+
+#include "trace.h"
+#include "system.h"
+#include "pio_idle.h"
+#include "temp_service.h"
+#include "dmesg.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+
+/* Core 1 is the single writer: records below s_n are immutable, so Core 0
+ * can read them while recording continues.  Start and stop are requests
+ * Core 1 acts on at its next tick. */
+static trace_rec_t       s_buf[TRACE_MAX_RECORDS];
+static volatile uint32_t s_n         = 0;
+static volatile bool     s_active    = false;
+static volatile bool     s_start_req = false;
+static uint32_t          s_t0_ms     = 0;
+static uint32_t          s_last_ms   = 0;
+
+void trace_start(void)
+{
+    s_active    = false;
+    s_start_req = true;
+}
+
+void trace_stop(void)
+{
+    s_start_req = false;
+    s_active    = false;
+}
+
+bool trace_active(void)
+{
+    return s_active || s_start_req;
+}
+
+uint32_t trace_count(void)
+{
+    return s_n;
+}
+
+const trace_rec_t *trace_get(uint32_t i)
+{
+    return (i < s_n) ? &s_buf[i] : NULL;
+}
+
+static uint32_t sat(double v, uint32_t hi)
+{
+    if (v <= 0.0) return 0;
+    return (v >= (double)hi) ? hi : (uint32_t)(v + 0.5);
+}
+
+void trace_record_tick(const metrics_agg_t *agg)
+{
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    if (s_start_req) {
+        s_start_req = false;
+        s_n       = 0;
+        s_t0_ms   = now;
+        s_last_ms = now - TRACE_ENV_PERIOD_MS;
+        s_active  = true;
+    }
+    if (!s_active) return;
+
+    bool has_metrics = agg && agg->count > 0;
+    bool has_iowait  = agg && agg->iowait > 0;
+    if (!has_metrics && !has_iowait && now - s_last_ms < TRACE_ENV_PERIOD_MS) return;
+
+    uint32_t n = s_n;
+    if (n >= TRACE_MAX_RECORDS) {
+        s_active = false;
+        dmesg_log("trace: buffer full, recording stopped");
+        return;
+    }
+
+    pio_idle_stats_t ps;
+    pio_idle_get_stats(&ps);
+    float t = temp_service_celsius();
+
+    trace_rec_t *r = &s_buf[n];
+    r->ts_ms       = now - s_t0_ms;
+    r->count       = has_metrics ? (uint16_t)sat(agg->count, UINT16_MAX) : 0;
+    r->workload    = has_metrics ? sat(agg->avg_workload, UINT32_MAX) : 0;
+    r->intensity   = has_metrics ? (uint8_t)sat(agg->avg_intensity, 100) : 0;
+    r->duration_ms = has_metrics ? (uint16_t)sat(agg->avg_duration_ms, UINT16_MAX) : 0;
+    r->idle_pct    = (uint8_t)sat(ps.idle_fraction * 100.0f, 100);
+    r->temp_c      = (int8_t)(t < -40.0f ? -40 : (t > 127.0f ? 127 : (int)(t + 0.5f)));
+    r->khz         = current_khz;
+    r->iowait      = has_iowait ? (uint8_t)sat(agg->iowait, UINT8_MAX) : 0;
+
+    __dmb();                    /* record complete before it is counted */
+    s_n       = n + 1u;
+    s_last_ms = now;
+}
+
+void trace_dump_csv(void)
+{
+    uint32_t n = s_n;
+    __dmb();
+    printf(TRACE_CSV_MAGIC "\n" TRACE_CSV_HEADER "\n");
+    for (uint32_t i = 0; i < n; ++i) {
+        const trace_rec_t *r = &s_buf[i];
+        printf("%lu,%u,%lu,%u,%u,%u,%d,%lu,%u\n",
+               (unsigned long)r->ts_ms, r->count, (unsigned long)r->workload,
+               r->intensity, r->duration_ms, r->idle_pct, r->temp_c,
+               (unsigned long)r->khz, r->iowait);
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/*
+ * trace.h  –  governor input recorder for host replay (sim/govsim)
+ *
+ * While recording, Core 1 appends one record per governor tick that
+ * carried metrics, and at least one every TRACE_ENV_PERIOD_MS through
+ * quiet stretches.  A record holds what the governor saw on that tick:
+ * the metrics aggregate (with its I/O-wait flags), the PIO idle
+ * fraction, the filtered temperature and the clock they were measured
+ * at.  Recording stops by itself when the buffer is full.
+ *
+ * `trace dump` prints the buffer as CSV:
+ *
+ *   # rp2040-trace v2
+ *   ts_ms,count,workload,intensity,duration_ms,idle_pct,temp_c,khz,iowait
+ *
+ * ts_ms counts from `trace start`; count 0 rows only carry idle,
+ * temperature, clock and I/O-wait flags.  v1 captures (no iowait
+ * column) still load.  sim/govsim replays such a file against the
+ * governor sources on a host.  Inputs are per recorded tick, so record
+ * with a governor that samples at least as fast as the ones to be
+ * replayed (or with doorbell wakeups on).
+ *
+ * The record layout and CSV format have no Pico SDK dependencies so the
+ * simulator shares them.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACE_MAX_RECORDS    1024u      /* 20 KB of SRAM */
+#define TRACE_ENV_PERIOD_MS  100u
+
+#define TRACE_CSV_MAGIC      "# rp2040-trace v2"
+#define TRACE_CSV_HEADER     "ts_ms,count,workload,intensity,duration_ms,idle_pct,temp_c,khz,iowait"
+#define TRACE_CSV_FIELDS     9
+#define TRACE_CSV_FIELDS_V1  8
+
+typedef struct {
+    uint32_t ts_ms;          /* since trace start                      */
+    uint32_t workload;       /* tick aggregate means ...               */
+    uint32_t khz;            /* current_khz when recorded              */
+    uint16_t count;          /* samples aggregated, 0 = idle/temp only */
+    uint16_t duration_ms;    /* ... (saturated)                        */
+    uint8_t  intensity;      /* 0..100                                 */
+    uint8_t  idle_pct;       /* PIO SM0 idle fraction                  */
+    int8_t   temp_c;
+    uint8_t  iowait;         /* I/O-wait flags (saturated)             */
+} trace_rec_t;
+
+/** Clear the buffer and record from the next tick.  Core 0. */
+void trace_start(void);
+void trace_stop(void);
+bool trace_active(void);
+
+/** Records held; the span is the last record's ts_ms. */
+uint32_t trace_count(void);
+const trace_rec_t *trace_get(uint32_t i);
+
+/** Core 1, once per governor tick, with the tick's aggregate. */
+void trace_record_tick(const metrics_agg_t *agg);
+
+/** Print the buffer as CSV (stop recording first). */
+void trace_dump_csv(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H */
@@ -0,0 +1,82 @@
+/*
+ * tune_search.c  –  coordinate descent over a box of parameters
+ */
+
+#include "tune_search.h"
+#include <string.h>
+
+void tune_search_init(tune_search_t *s, const tune_dim_t *dims, uint32_t ndims,
+                      const double *start, double start_score, double min_gain)
+{
+    memset(s, 0, sizeof(*s));
+    if (ndims > TUNE_SEARCH_MAX_DIMS) ndims = TUNE_SEARCH_MAX_DIMS;
+    s->ndims      = ndims;
+    s->dir        = 1;
+    s->min_gain   = min_gain;
+    s->best_score = start_score;
+    for (uint32_t i = 0; i < ndims; ++i) {
+        s->best[i] = start[i];
+        s->step[i] = dims[i].step;
+        s->cand[i] = start[i];
+    }
+}
+
+/* Done with this direction of the current dimension. */
+static void advance(tune_search_t *s, const tune_dim_t *dims)
+{
+    if (s->dir > 0 && !s->moved_dim) {
+        s->dir = -1;
+        return;
+    }
+    s->dir       = 1;
+    s->moved_dim = 0;
+    if (++s->dim < s->ndims) return;
+
+    s->dim = 0;
+    if (!s->moved_pass) {
+        bool live = false;
+        for (uint32_t i = 0; i < s->ndims; ++i) {
+            s->step[i] *= 0.5;
+            if (s->step[i] >= dims[i].min_step) live = true;
+        }
+        if (!live) s->done = 1;
+    }
+    s->moved_pass = 0;
+}
+
+bool tune_search_next(tune_search_t *s, const tune_dim_t *dims, double *out)
+{
+    while (!s->done) {
+        uint32_t d = s->dim;
+        if (s->step[d] < dims[d].min_step) {
+            advance(s, dims);
+            continue;
+        }
+        double v = s->best[d] + (double)s->dir * s->step[d];
+        if (v < dims[d].lo) v = dims[d].lo;
+        if (v > dims[d].hi) v = dims[d].hi;
+        if (v == s->best[d]) {          /* pinned against a bound */
+            advance(s, dims);
+            continue;
+        }
+        memcpy(s->cand, s->best, s->ndims * sizeof(s->cand[0]));
+        s->cand[d] = v;
+        if (out) memcpy(out, s->cand, s->ndims * sizeof(out[0]));
+        return true;
+    }
+    return false;
+}
+
+void tune_search_report(tune_search_t *s, const tune_dim_t *dims, double score)
+{
+    s->evals++;
+    if (score > s->best_score + s->min_gain) {
+        memcpy(s->best, s->cand, s->ndims * sizeof(s->best[0]));
+        s->best_score = score;
+        s->moves++;
+        s->moved_dim  = 1;
+        s->moved_pass = 1;
+        return;                         /* keep going the same way */
+    }
+    advance(s, dims);
+}
@@ -0,0 +1,75 @@
+#ifndef TUNE_SEARCH_H
+#define TUNE_SEARCH_H
+
+/*
+ * tune_search.h  –  coordinate descent over a box of parameters
+ *
+ * Maximises a noisy score one coordinate at a time:
+ *
+ *   for each dimension d:  probe best ± step[d]
+ *     a probe scoring more than min_gain above the best is taken, and the
+ *     same direction is probed again from there (pattern move); once a
+ *     direction has moved, the opposite one is not tried
+ *   after a pass over all dimensions with no move, every step is halved;
+ *   the search ends when no step is at or above its dimension's min_step
+ *
+ * min_gain keeps benchmark noise from being mistaken for improvement.
+ * The caller owns evaluation: tune_search_next() hands out the point to
+ * score and tune_search_report() takes the result, so a run can be
+ * interrupted between the two and resumed from a saved copy of the state
+ * (a plain struct, no pointers).
+ *
+ * No Pico SDK dependencies, so the search can be exercised on a host.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TUNE_SEARCH_MAX_DIMS  12u
+
+typedef struct {
+    double lo, hi;          /* inclusive bounds */
+    double step;            /* initial probe distance */
+    double min_step;        /* stop halving below this (1 for integers) */
+} tune_dim_t;
+
+typedef struct {
+    uint32_t ndims;
+    uint32_t dim;                           /* dimension being probed */
+    int32_t  dir;                           /* +1 / -1 */
+    uint32_t evals;                         /* reports taken */
+    uint32_t moves;                         /* accepted probes */
+    uint8_t  moved_dim;                     /* this dimension moved already */
+    uint8_t  moved_pass;                    /* any move this pass */
+    uint8_t  done;
+    uint8_t  reserved;
+    double   min_gain;
+    double   best_score;
+    double   best[TUNE_SEARCH_MAX_DIMS];
+    double   step[TUNE_SEARCH_MAX_DIMS];
+    double   cand[TUNE_SEARCH_MAX_DIMS];    /* point handed out by next() */
+} tune_search_t;
+
+/** Start from `start` (already scored as start_score). */
+void tune_search_init(tune_search_t *s, const tune_dim_t *dims, uint32_t ndims,
+                      const double *start, double start_score, double min_gain);
+
+/**
+ * Next point to evaluate, copied to out[ndims] (also kept in s->cand).
+ * Returns false once the search has converged.  Calling it again before
+ * tune_search_report() hands out the same point.
+ */
+bool tune_search_next(tune_search_t *s, const tune_dim_t *dims, double *out);
+
+/** Score of the point from the last tune_search_next(). */
+void tune_search_report(tune_search_t *s, const tune_dim_t *dims, double score);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TUNE_SEARCH_H */
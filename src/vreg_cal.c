@@ -0,0 +1,278 @@
+/*
+ * vreg_cal.c  –  per-band undervolt calibration and runtime VREG lookup
+ *
+ * The search itself lives in vreg_table.c; this file supplies the
+ * hardware side: the stress oracle, governor suspension, regulator
+ * programming and persistence.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/vreg.h"
+#include "vreg_cal.h"
+#include "system.h"
+#include "pll_table.h"
+#include "persist.h"
+#include "safepoint.h"
+#include "dmesg.h"
+#include "energy.h"
+
+#define VREG_CAL_SETTLE_US     1000u    /* regulator settle after a change */
+#define VREG_CAL_RAMP_TIMEOUT_MS 2000u
+#define VREG_CAL_SUSPEND_TIMEOUT_MS 1000u
+#define VREG_CAL_PASSES        8u       /* stress runs per probe */
+#define VREG_CAL_ROUNDS        256u     /* ~5 ms per run at 125 MHz */
+#define STRESS_WORDS           256u     /* power of two */
+
+/* Supported regulator levels, ascending. */
+static const struct {
+    uint16_t           mv;
+    enum vreg_voltage  level;
+} vreg_levels[] = {
+    {  850, VREG_VOLTAGE_0_85 },
+    {  900, VREG_VOLTAGE_0_90 },
+    {  950, VREG_VOLTAGE_0_95 },
+    { 1000, VREG_VOLTAGE_1_00 },
+    { 1050, VREG_VOLTAGE_1_05 },
+    { 1100, VREG_VOLTAGE_1_10 },
+    { 1150, VREG_VOLTAGE_1_15 },
+    { 1200, VREG_VOLTAGE_1_20 },
+    { 1250, VREG_VOLTAGE_1_25 },
+    { 1300, VREG_VOLTAGE_1_30 },
+#if defined(VREG_VOLTAGE_1_35)
+    { 1350, VREG_VOLTAGE_1_35 },
+#endif
+};
+#define VREG_LEVEL_COUNT (sizeof(vreg_levels) / sizeof(vreg_levels[0]))
+
+static vreg_table_t s_active;       /* read by Core 1 in ramp_step() */
+static uint32_t     s_stress_buf[STRESS_WORDS];
+
+/* --------------------------------------------------------------------------
+ * Runtime lookup
+ * -------------------------------------------------------------------------- */
+
+uint32_t vreg_default_mv(uint32_t khz)
+{
+#if defined(VREG_VOLTAGE_1_35)
+    if (khz > 250000) return 1350;
+#else
+    if (khz > 250000) return 1300;
+#endif
+    if (khz > 200000) return 1200;
+    return 1100;
+}
+
+uint32_t vreg_mv_for_khz(uint32_t khz)
+{
+    return vreg_table_lookup(&s_active, khz, vreg_default_mv(khz));
+}
+
+uint32_t vreg_apply_mv(uint32_t mv)
+{
+    size_t i = 0;
+    while (i + 1 < VREG_LEVEL_COUNT && vreg_levels[i].mv < mv)
+        i++;                        /* round up: never under-volt */
+    bool changed = (current_voltage_mv != vreg_levels[i].mv);
+    vreg_set_voltage(vreg_levels[i].level);
+    current_voltage_mv = vreg_levels[i].mv;
+    if (changed)
+        energy_update();            /* close the interval at the old level */
+    return vreg_levels[i].mv;
+}
+
+const vreg_table_t *vreg_cal_table(void)
+{
+    return &s_active;
+}
+
+void vreg_cal_init(void)
+{
+    vreg_table_t t;
+    if (persist_load_vreg_table(&t, sizeof(t)) == (int)sizeof(t) && t.valid) {
+        s_active = t;
+        dmesg_log("vreg: loaded calibrated table");
+    }
+}
+
+/* --------------------------------------------------------------------------
+ * Stress kernel
+ *
+ * Multiply/rotate/xor over an SRAM buffer: exercises the multiplier, the
+ * barrel shifter and the bus.  Deterministic, so any deviation from the
+ * reference checksum means the core mis-computed.
+ * -------------------------------------------------------------------------- */
+
+static uint32_t stress_kernel(uint32_t rounds)
+{
+    uint32_t x = 0x9E3779B9u;
+    for (uint32_t i = 0; i < STRESS_WORDS; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        s_stress_buf[i] = x;
+    }
+
+    uint32_t sum = 0;
+    for (uint32_t r = 0; r < rounds; ++r) {
+        for (uint32_t i = 0; i < STRESS_WORDS; ++i) {
+            uint32_t a = s_stress_buf[i];
+            uint32_t b = s_stress_buf[(i + 97u) & (STRESS_WORDS - 1u)];
+            a = a * 2654435761u + (b >> 7);
+            a ^= (a << 11) | (a >> 21);
+            s_stress_buf[i] = a;
+            sum = ((sum << 5) | (sum >> 27)) ^ a;
+        }
+    }
+    return sum;
+}
+
+/* --------------------------------------------------------------------------
+ * Oracle
+ * -------------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t ref;           /* checksum at stock voltage */
+    uint32_t probes;
+    uint32_t failures;
+    bool     abort;
+    const char *why;
+} cal_ctx_t;
+
+/* Let Core 1 (still following target_khz while the governor is
+ * suspended) ramp to khz.  Voltage follows the stock table on the way. */
+static bool cal_move_to(uint32_t khz, cal_ctx_t *c)
+{
+    target_khz = khz;
+    uint32_t t0 = to_ms_since_boot(get_absolute_time());
+    while (current_khz != khz) {
+        safepoint_poll();
+        if (to_ms_since_boot(get_absolute_time()) - t0 > VREG_CAL_RAMP_TIMEOUT_MS) {
+            c->abort = true;
+            c->why = "ramp timeout";
+            return false;
+        }
+        sleep_ms(1);
+    }
+    return true;
+}
+
+static bool cal_oracle(uint32_t khz, uint32_t mv, void *ctx)
+{
+    cal_ctx_t *c = (cal_ctx_t *)ctx;
+    if (c->abort) return false;
+
+    const pll_entry_t *e = pll_table_floor(khz);
+    if (!e || !cal_move_to(e->khz, c)) return false;
+
+    if (read_onboard_temperature() > VREG_CAL_MAX_TEMP_C) {
+        c->abort = true;
+        c->why = "over temperature";
+        return false;
+    }
+
+    c->probes++;
+    vreg_apply_mv(mv);
+    sleep_us(VREG_CAL_SETTLE_US);
+
+    bool ok = true;
+    for (uint32_t p = 0; p < VREG_CAL_PASSES && ok; ++p)
+        ok = (stress_kernel(VREG_CAL_ROUNDS) == c->ref);
+
+    /* Back to a known-good level before the next probe or band. */
+    vreg_apply_mv(vreg_default_mv(e->khz));
+    sleep_us(VREG_CAL_SETTLE_US);
+
+    if (!ok) c->failures++;
+    printf("  %6.2f MHz @ %-16s %s\n", e->khz / 1000.0f,
+           voltage_label(mv), ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/* --------------------------------------------------------------------------
+ * Calibration driver
+ * -------------------------------------------------------------------------- */
+
+int vreg_cal_run(uint32_t margin_mv)
+{
+    cal_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    if (!governor_suspend(VREG_CAL_SUSPEND_TIMEOUT_MS)) {
+        printf("vreg cal: governor did not suspend\n");
+        return -1;
+    }
+
+    uint32_t     saved_target = target_khz;
+    vreg_table_t saved        = s_active;
+    s_active.valid = 0;             /* ramp on stock voltages while probing */
+
+    /* Reference checksum at the slowest clock and stock voltage. */
+    if (cal_move_to(MIN_KHZ, &ctx)) {
+        vreg_apply_mv(vreg_default_mv(MIN_KHZ));
+        sleep_us(VREG_CAL_SETTLE_US);
+        ctx.ref = stress_kernel(VREG_CAL_ROUNDS);
+        if (stress_kernel(VREG_CAL_ROUNDS) != ctx.ref) {
+            ctx.abort = true;
+            ctx.why = "reference checksum unstable";
+        }
+    }
+
+    uint16_t start[VREG_TABLE_BANDS];
+    for (uint32_t b = 0; b < VREG_TABLE_BANDS; ++b) {
+        const pll_entry_t *e = pll_table_floor(vreg_table_band_top_khz(b));
+        start[b] = (uint16_t)vreg_default_mv(e ? e->khz : MAX_KHZ);
+    }
+
+    vreg_table_t t;
+    uint32_t done = 0;
+    if (!ctx.abort) {
+        printf("vreg cal: margin %u mV, floor %u mV\n",
+               (unsigned)margin_mv, (unsigned)VREG_CAL_FLOOR_MV);
+        done = vreg_table_calibrate(&t, start, VREG_CAL_FLOOR_MV, margin_mv,
+                                    cal_oracle, &ctx);
+    }
+
+    char buf[96];
+    if (ctx.abort || done == 0) {
+        s_active = saved;
+        snprintf(buf, sizeof(buf), "vreg cal: aborted (%s)",
+                 ctx.why ? ctx.why : "no band passed at stock voltage");
+    } else {
+        s_active = t;
+        if (persist_save_vreg_table(&t, sizeof(t)) != 0)
+            dmesg_log("vreg cal: persist failed");
+        snprintf(buf, sizeof(buf), "vreg cal: %u bands, %u probes, %u failed",
+                 (unsigned)done, (unsigned)ctx.probes, (unsigned)ctx.failures);
+    }
+    dmesg_log(buf);
+    printf("%s\n", buf);
+
+    /* Settle on the active table at the current clock, then hand back. */
+    vreg_apply_mv(vreg_mv_for_khz(current_khz));
+    target_khz = saved_target;
+    governor_resume();
+    return (ctx.abort || done == 0) ? -1 : (int)done;
+}
+
+int vreg_cal_clear(void)
+{
+    cal_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    /* Core 1 reads the table on every ramp step: hold the governor and let
+     * a ramp in flight finish before swapping it out. */
+    if (!governor_suspend(VREG_CAL_SUSPEND_TIMEOUT_MS)) {
+        printf("vreg: governor did not suspend, table kept\n");
+        return -1;
+    }
+    if (!cal_move_to(target_khz, &ctx)) {
+        printf("vreg: %s, table kept\n", ctx.why);
+        governor_resume();
+        return -1;
+    }
+
+    memset(&s_active, 0, sizeof(s_active));
+    vreg_apply_mv(vreg_mv_for_khz(current_khz));
+    governor_resume();
+    return persist_clear_vreg_table() == 0 ? 0 : 1;
+}
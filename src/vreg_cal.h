@@ -0,0 +1,71 @@
+#ifndef VREG_CAL_H
+#define VREG_CAL_H
+
+/*
+ * vreg_cal.h  –  per-band undervolt calibration and runtime VREG lookup
+ *
+ * vreg_mv_for_khz() is what ramp_step() applies for a frequency: the
+ * calibrated entry of the khz's band when a table is loaded, otherwise
+ * the stock breakpoints (1.10 V ≤ 200 MHz < 1.20 V ≤ 250 MHz < 1.30 V).
+ *
+ * vreg_cal_run() (Core 0, interactive) suspends the governor, then for
+ * each band moves clk_sys to the band's top frequency and steps the
+ * voltage down from the stock level while a checksum-verified stress
+ * kernel keeps producing the reference result.  The lowest passing level
+ * plus a safety margin is stored and persisted to flash.
+ *
+ * A hard crash at a probed level (rather than a checksum mismatch) leaves
+ * the previous table in flash untouched; power-cycle and re-run with a
+ * larger margin or a higher floor.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "vreg_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VREG_CAL_DEFAULT_MARGIN_MV  50u     /* one VREG step */
+#define VREG_CAL_FLOOR_MV           900u    /* never probe below this */
+#define VREG_CAL_MAX_TEMP_C         70.0f   /* abort above the throttle point */
+
+/** Load the persisted table, if any.  Call once on Core 0 at boot. */
+void vreg_cal_init(void);
+
+/** Stock (uncalibrated) voltage for khz. */
+uint32_t vreg_default_mv(uint32_t khz);
+
+/** Voltage ramp_step() should apply for khz: calibrated or stock. */
+uint32_t vreg_mv_for_khz(uint32_t khz);
+
+/**
+ * Program the regulator to the lowest supported level >= mv and update
+ * current_voltage_mv.  Returns the level actually applied.
+ */
+uint32_t vreg_apply_mv(uint32_t mv);
+
+/** Active table (valid == 0 when running on stock voltages). */
+const vreg_table_t *vreg_cal_table(void);
+
+/**
+ * Run a full calibration (Core 0 only, blocks for a few seconds).
+ * Returns the number of bands calibrated, or -1 if aborted (governor did
+ * not suspend, over temperature, reference checksum unstable, ramp
+ * timeout); the previous table stays active on abort.
+ */
+int vreg_cal_run(uint32_t margin_mv);
+
+/**
+ * Drop the calibrated table and fall back to stock voltages, with the
+ * governor suspended.  Returns 0, 1 if the flash copy could not be
+ * cleared, -1 if the governor could not be held (table kept).
+ */
+int vreg_cal_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VREG_CAL_H */
@@ -0,0 +1,88 @@
+/*
+ * vreg_table.c  –  per-frequency-band VREG table and undervolt search
+ */
+
+#include "vreg_table.h"
+#include "system.h"
+#include <string.h>
+
+uint32_t vreg_table_band(uint32_t khz)
+{
+    if (khz <= MIN_KHZ) return 0;
+    uint32_t b = (khz - MIN_KHZ - 1u) / VREG_TABLE_BAND_KHZ;
+    return (b < VREG_TABLE_BANDS) ? b : VREG_TABLE_BANDS - 1u;
+}
+
+uint32_t vreg_table_band_top_khz(uint32_t band)
+{
+    uint32_t top = MIN_KHZ + (band + 1u) * VREG_TABLE_BAND_KHZ;
+    return (top < MAX_KHZ) ? top : MAX_KHZ;
+}
+
+uint32_t vreg_table_lookup(const vreg_table_t *t, uint32_t khz, uint32_t default_mv)
+{
+    if (!t || !t->valid) return default_mv;
+    uint32_t mv = t->mv[vreg_table_band(khz)];
+    return mv ? mv : default_mv;
+}
+
+uint32_t vreg_table_search(uint32_t khz, uint32_t start_mv, uint32_t floor_mv,
+                           uint32_t margin_mv, vreg_oracle_fn stable, void *ctx,
+                           uint32_t *lowest_out)
+{
+    if (!stable || start_mv < floor_mv) return 0;
+    if (!stable(khz, start_mv, ctx)) return 0;
+
+    uint32_t lowest = start_mv;
+    while (lowest >= floor_mv + VREG_TABLE_STEP_MV) {
+        uint32_t probe = lowest - VREG_TABLE_STEP_MV;
+        if (!stable(khz, probe, ctx)) break;    /* stability is monotonic */
+        lowest = probe;
+    }
+
+    if (lowest_out) *lowest_out = lowest;
+    uint32_t mv = lowest + margin_mv;
+    return (mv < start_mv) ? mv : start_mv;
+}
+
+uint32_t vreg_table_calibrate(vreg_table_t *t, const uint16_t *start_mv,
+                              uint32_t floor_mv, uint32_t margin_mv,
+                              vreg_oracle_fn stable, void *ctx)
+{
+    if (!t || !start_mv) return 0;
+    memset(t, 0, sizeof(*t));
+    t->margin_mv = (uint16_t)margin_mv;
+
+    uint32_t done  = 0;
+    uint32_t floor = floor_mv;
+    for (uint32_t b = 0; b < VREG_TABLE_BANDS; ++b) {
+        uint32_t khz = vreg_table_band_top_khz(b);
+        if (b > 0 && khz == vreg_table_band_top_khz(b - 1u)) {
+            t->mv[b] = t->mv[b - 1u];           /* band lies past MAX_KHZ */
+            continue;
+        }
+
+        uint32_t lowest = 0;
+        uint32_t mv = vreg_table_search(khz, start_mv[b], floor, margin_mv,
+                                        stable, ctx, &lowest);
+        if (mv == 0) continue;                  /* keep the default */
+        t->mv[b] = (uint16_t)mv;
+        if (lowest > floor) floor = lowest;
+        done++;
+    }
+
+    vreg_table_make_monotonic(t);
+    t->valid = (done > 0);
+    return done;
+}
+
+void vreg_table_make_monotonic(vreg_table_t *t)
+{
+    if (!t) return;
+    uint16_t hi = 0;
+    for (uint32_t b = 0; b < VREG_TABLE_BANDS; ++b) {
+        if (t->mv[b] == 0) continue;
+        if (t->mv[b] < hi) t->mv[b] = hi;
+        hi = t->mv[b];
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef VREG_TABLE_H
+#define VREG_TABLE_H
+
+/*
+ * vreg_table.h  –  per-frequency-band VREG table and undervolt search
+ *
+ * [MIN_KHZ, MAX_KHZ] is split into VREG_TABLE_BANDS bands of
+ * VREG_TABLE_BAND_KHZ.  Band i covers (MIN_KHZ + i*B, MIN_KHZ + (i+1)*B]
+ * (band 0 also includes MIN_KHZ itself) and is calibrated at its top
+ * frequency, the worst case for every clock inside it.
+ *
+ * The search walks the voltage down in VREG_TABLE_STEP_MV steps from the
+ * known-good default while a caller-supplied stability oracle passes,
+ * then adds a safety margin.  Bands are forced monotonic so a faster band
+ * never gets less voltage than a slower one.
+ *
+ * No Pico SDK dependencies: the search can run on a host against a
+ * simulated oracle.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VREG_TABLE_BAND_KHZ   10000u
+#define VREG_TABLE_BANDS      14u       /* 125 .. 265 MHz */
+#define VREG_TABLE_MIN_MV     850u
+#define VREG_TABLE_STEP_MV    50u
+
+typedef struct {
+    uint16_t mv[VREG_TABLE_BANDS];   /* 0 = band not calibrated            */
+    uint16_t margin_mv;              /* margin that was added on top        */
+    uint16_t valid;                  /* non-zero once a calibration ran     */
+} vreg_table_t;
+
+/**
+ * Stability oracle: run a verified stress load at `khz` / `mv` and return
+ * true if it produced the expected result.  Must leave the hardware at a
+ * safe voltage on return.
+ */
+typedef bool (*vreg_oracle_fn)(uint32_t khz, uint32_t mv, void *ctx);
+
+uint32_t vreg_table_band(uint32_t khz);
+uint32_t vreg_table_band_top_khz(uint32_t band);
+
+/** Calibrated mv for khz, or default_mv if the band has no entry. */
+uint32_t vreg_table_lookup(const vreg_table_t *t, uint32_t khz, uint32_t default_mv);
+
+/**
+ * Search one band: step down from start_mv (assumed stable) to floor_mv
+ * while the oracle passes.  Returns the lowest passing level plus
+ * margin_mv, capped at start_mv; *lowest_out (optional) receives the raw
+ * lowest passing level.  Returns 0 if start_mv itself fails.
+ */
+uint32_t vreg_table_search(uint32_t khz, uint32_t start_mv, uint32_t floor_mv,
+                           uint32_t margin_mv, vreg_oracle_fn stable, void *ctx,
+                           uint32_t *lowest_out);
+
+/**
+ * Calibrate every band in ascending frequency order.  start_mv[i] is the
+ * default (known-good) level of band i.  Each band's search floor is the
+ * previous band's raw result, since voltage need never drop as frequency
+ * rises.  Returns the number of bands calibrated.
+ */
+uint32_t vreg_table_calibrate(vreg_table_t *t, const uint16_t *start_mv,
+                              uint32_t floor_mv, uint32_t margin_mv,
+                              vreg_oracle_fn stable, void *ctx);
+
+/** Raise entries so mv never decreases with band index. */
+void vreg_table_make_monotonic(vreg_table_t *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VREG_TABLE_H */